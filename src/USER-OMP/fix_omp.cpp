@@ -32,9 +32,9 @@
 
 #include "pair_hybrid.h"
 #include "bond_hybrid.h"
-#include "angle_hybrid.h"
-#include "dihedral_hybrid.h"
-#include "improper_hybrid.h"
+#include "angle.h"
+#include "dihedral.h"
+#include "improper.h"
 #include "kspace.h"
 
 #include <string.h>
@@ -239,14 +239,13 @@ void FixOMP::init()
   CheckStyleForOMP(bond);
   CheckHybridForOMP(bond,Bond);
 
+  // no hybrid angle, dihedral and improper styles in LIGGGHTS
+
   CheckStyleForOMP(angle);
-  CheckHybridForOMP(angle,Angle);
 
   CheckStyleForOMP(dihedral);
-  CheckHybridForOMP(dihedral,Dihedral);
 
   CheckStyleForOMP(improper);
-  CheckHybridForOMP(improper,Improper);
 
   CheckStyleForOMP(kspace);
 
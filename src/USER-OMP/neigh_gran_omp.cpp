@@ -17,7 +17,7 @@
 #include "atom.h"
 #include "comm.h"
 #include "group.h"
-#include "fix_shear_history.h"
+#include "fix_contact_history.h"
 #include "error.h"
 
 using namespace LAMMPS_NS;
@@ -35,7 +35,7 @@ void Neighbor::granular_nsq_no_newton_omp(NeighList *list)
   const int nlocal = (includegroup) ? atom->nfirst : atom->nlocal;
   const int bitmask = (includegroup) ? group->bitmask[includegroup] : 0;
 
-  FixShearHistory * const fix_history = list->fix_history;
+  FixContactHistory * const fix_history = list->fix_history;
   NeighList * listgranhistory = list->listgranhistory;
 
   NEIGH_OMP_INIT;
@@ -49,14 +49,15 @@ void Neighbor::granular_nsq_no_newton_omp(NeighList *list)
 #endif
   NEIGH_OMP_SETUP(nlocal);
 
-  int i,j,m,n,nn;
+  int i,j,m,n,nn,d;
+  int dnum = 0;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
   int *neighptr,*touchptr;
   double *shearptr;
 
   int *npartner,**partner;
-  double ***shearpartner;
+  double ***contacthistory;
   int **firsttouch;
   double **firstshear;
 
@@ -75,9 +76,10 @@ void Neighbor::granular_nsq_no_newton_omp(NeighList *list)
   if (fix_history) {
     npartner = fix_history->npartner;
     partner = fix_history->partner;
-    shearpartner = fix_history->shearpartner;
+    contacthistory = fix_history->contacthistory;
     firsttouch = listgranhistory->firstneigh;
     firstshear = listgranhistory->firstdouble;
+    dnum = listgranhistory->dnum;
   }
 
   int npage = tid;
@@ -103,7 +105,7 @@ void Neighbor::granular_nsq_no_newton_omp(NeighList *list)
       neighptr = &(list->pages[npage][npnt]);
       if (fix_history) {
 	touchptr = &(listgranhistory->pages[npage][npnt]);
-	shearptr = &(listgranhistory->dpages[npage][3*npnt]);
+	shearptr = &(listgranhistory->dpages[npage][dnum*npnt]);
       }
     }
 
@@ -134,20 +136,17 @@ void Neighbor::granular_nsq_no_newton_omp(NeighList *list)
 	      if (partner[i][m] == tag[j]) break;
 	    if (m < npartner[i]) {
 	      touchptr[n] = 1;
-	      shearptr[nn++] = shearpartner[i][m][0];
-	      shearptr[nn++] = shearpartner[i][m][1];
-	      shearptr[nn++] = shearpartner[i][m][2];
+	      for (d = 0; d < dnum; d++)
+	        shearptr[nn++] = contacthistory[i][m][d];
 	    } else {
 	      touchptr[n] = 0;
-	      shearptr[nn++] = 0.0;
-	      shearptr[nn++] = 0.0;
-	      shearptr[nn++] = 0.0;
+	      for (d = 0; d < dnum; d++)
+	        shearptr[nn++] = 0.0;
 	    }
 	  } else {
 	    touchptr[n] = 0;
-	    shearptr[nn++] = 0.0;
-	    shearptr[nn++] = 0.0;
-	    shearptr[nn++] = 0.0;
+	    for (d = 0; d < dnum; d++)
+	      shearptr[nn++] = 0.0;
 	  }
 	}
 
@@ -290,7 +289,7 @@ void Neighbor::granular_bin_no_newton_omp(NeighList *list)
 
   const int nlocal = (includegroup) ? atom->nfirst : atom->nlocal;
 
-  FixShearHistory * const fix_history = list->fix_history;
+  FixContactHistory * const fix_history = list->fix_history;
   NeighList * listgranhistory = list->listgranhistory;
 
   NEIGH_OMP_INIT;
@@ -304,14 +303,15 @@ void Neighbor::granular_bin_no_newton_omp(NeighList *list)
 #endif
   NEIGH_OMP_SETUP(nlocal);
 
-  int i,j,k,m,n,nn,ibin;
+  int i,j,k,m,n,nn,d,ibin;
+  int dnum = 0;
   double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
   double radi,radsum,cutsq;
   int *neighptr,*touchptr;
   double *shearptr;
 
   int *npartner,**partner;
-  double ***shearpartner;
+  double ***contacthistory;
   int **firsttouch;
   double **firstshear;
 
@@ -333,9 +333,10 @@ void Neighbor::granular_bin_no_newton_omp(NeighList *list)
   if (fix_history) {
     npartner = fix_history->npartner;
     partner = fix_history->partner;
-    shearpartner = fix_history->shearpartner;
+    contacthistory = fix_history->contacthistory;
     firsttouch = listgranhistory->firstneigh;
     firstshear = listgranhistory->firstdouble;
+    dnum = listgranhistory->dnum;
   }
 
   int npage = tid;
@@ -361,7 +362,7 @@ void Neighbor::granular_bin_no_newton_omp(NeighList *list)
       neighptr = &(list->pages[npage][npnt]);
       if (fix_history) {
 	touchptr = &(listgranhistory->pages[npage][npnt]);
-	shearptr = &(listgranhistory->dpages[npage][3*npnt]);
+	shearptr = &(listgranhistory->dpages[npage][dnum*npnt]);
       }
     }
 
@@ -397,20 +398,17 @@ void Neighbor::granular_bin_no_newton_omp(NeighList *list)
 		if (partner[i][m] == tag[j]) break;
 	      if (m < npartner[i]) {
 		touchptr[n] = 1;
-		shearptr[nn++] = shearpartner[i][m][0];
-		shearptr[nn++] = shearpartner[i][m][1];
-		shearptr[nn++] = shearpartner[i][m][2];
+		for (d = 0; d < dnum; d++)
+		  shearptr[nn++] = contacthistory[i][m][d];
 	      } else {
 		touchptr[n] = 0;
-		shearptr[nn++] = 0.0;
-		shearptr[nn++] = 0.0;
-		shearptr[nn++] = 0.0;
+		for (d = 0; d < dnum; d++)
+		  shearptr[nn++] = 0.0;
 	      }
 	    } else {
 	      touchptr[n] = 0;
-	      shearptr[nn++] = 0.0;
-	      shearptr[nn++] = 0.0;
-	      shearptr[nn++] = 0.0;
+	      for (d = 0; d < dnum; d++)
+	        shearptr[nn++] = 0.0;
 	    }
 	  }
 
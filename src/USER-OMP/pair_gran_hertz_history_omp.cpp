@@ -20,6 +20,9 @@
 #include "neighbor.h"
 #include "neigh_list.h"
 #include "update.h"
+#include "vector_liggghts.h"
+
+#include "string.h"
 
 #include "suffix.h"
 using namespace LAMMPS_NS;
@@ -31,26 +34,33 @@ PairGranHertzHistoryOMP::PairGranHertzHistoryOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  contactbuffer_enable = false;
 }
 
 /* ---------------------------------------------------------------------- */
 
-void PairGranHertzHistoryOMP::compute(int eflag, int vflag)
+void PairGranHertzHistoryOMP::compute_force(int eflag, int vflag, int addflag)
 {
+  // evaluation for compute pair/gran/local hands contacts to the
+  // compute one by one, so keep it serial, also on output steps where
+  // the force pass records the contacts
+
+  if (!computeflag || addflag) {
+    PairGranHertzHistory::compute_force(eflag,vflag,addflag);
+    return;
+  }
+
   if (eflag || vflag) {
     ev_setup(eflag,vflag);
   } else evflag = vflag_fdotr = 0;
 
-  const int shearupdate = (update->ntimestep > laststep) ? 1 : 0;
-
-  const int nall = atom->nlocal + atom->nghost;
-  const int nthreads = comm->nthreads;
-  const int inum = list->inum;
-
 #if defined(_OPENMP)
 #pragma omp parallel default(none) shared(eflag,vflag)
 #endif
   {
+    const int nall = atom->nlocal + atom->nghost;
+    const int nthreads = comm->nthreads;
+    const int inum = list->inum;
     int ifrom, ito, tid;
 
     loop_setup_thr(ifrom, ito, tid, inum, nthreads);
@@ -58,36 +68,69 @@ void PairGranHertzHistoryOMP::compute(int eflag, int vflag)
     ev_setup_thr(eflag, vflag, nall, eatom, vatom, thr);
 
     if (evflag)
-      if (shearupdate) eval<1,1>(ifrom, ito, thr);
-      else eval<1,0>(ifrom, ito, thr);
-    else 
-      if (shearupdate) eval<0,1>(ifrom, ito, thr);
-      else eval<0,0>(ifrom, ito, thr);
+      if (shearupdate) eval_dispatch<1,1>(ifrom, ito, thr);
+      else eval_dispatch<1,0>(ifrom, ito, thr);
+    else
+      if (shearupdate) eval_dispatch<0,1>(ifrom, ito, thr);
+      else eval_dispatch<0,0>(ifrom, ito, thr);
 
     reduce_thr(this, eflag, vflag, thr);
   } // end of omp parallel region
-  laststep = update->ntimestep;
 }
 
+/* ---------------------------------------------------------------------- */
+
 template <int EVFLAG, int SHEARUPDATE>
+void PairGranHertzHistoryOMP::eval_dispatch(int ifrom, int ito, ThrData * const thr)
+{
+  if (cohesionflag) {
+    if (rollingflag) {
+      if (fix_rigid) eval<EVFLAG,SHEARUPDATE,1,1,1>(ifrom, ito, thr);
+      else eval<EVFLAG,SHEARUPDATE,1,1,0>(ifrom, ito, thr);
+    } else {
+      if (fix_rigid) eval<EVFLAG,SHEARUPDATE,1,0,1>(ifrom, ito, thr);
+      else eval<EVFLAG,SHEARUPDATE,1,0,0>(ifrom, ito, thr);
+    }
+  } else {
+    if (rollingflag) {
+      if (fix_rigid) eval<EVFLAG,SHEARUPDATE,0,1,1>(ifrom, ito, thr);
+      else eval<EVFLAG,SHEARUPDATE,0,1,0>(ifrom, ito, thr);
+    } else {
+      if (fix_rigid) eval<EVFLAG,SHEARUPDATE,0,0,1>(ifrom, ito, thr);
+      else eval<EVFLAG,SHEARUPDATE,0,0,0>(ifrom, ito, thr);
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   each thread owns a contiguous chunk of ilist
+   shear history of pair (i,jj) is stored with i, so it is only ever
+   touched by the thread owning i; forces and torques on j go to the
+   per-thread arrays and are reduced in reduce_thr()
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int SHEARUPDATE, int COHESIONFLAG, int ROLLINGFLAG, int RIGIDFLAG>
 void PairGranHertzHistoryOMP::eval(int iifrom, int iito, ThrData * const thr)
 {
+  double kn,kt,gamman,gammat,xmu,rmu;
+  double Fn_coh;
+
   int i,j,ii,jj,jnum,itype,jtype;
   double xtmp,ytmp,ztmp,delx,dely,delz,fx,fy,fz;
-  double radi,radj,radsum,rsq,r,rinv,rsqinv;
-  double vr1,vr2,vr3,vnnr,vn1,vn2,vn3,vt1,vt2,vt3;
+  double radi,radj,radsum,rsq,r,rinv,rsqinv,reff;
+  double vr1,vr2,vr3,vnnr,vn1,vn2,vn3,vt1,vt2,vt3,wr_roll[3],wr_rollmag;
   double wr1,wr2,wr3;
-  double vtr1,vtr2,vtr3,vrel;
-  double meff,damp,ccel,tor1,tor2,tor3;
+  double vtr1,vtr2,vtr3;
+  double mi,mj,meff,damp,ccel,tor1,tor2,tor3,r_torque[3],r_torque_n[3];
   double fn,fs,fs1,fs2,fs3;
-  double shrmag,rsht,polyhertz;
+  double shrmag,rsht,cri,crj;
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *touch,**firsttouch;
   double *shear,*allshear,**firstshear;
 
-  const double * const * const x = atom->x;
-  const double * const * const v = atom->v;
-  const double * const * const omega = atom->omega;
+  double * const * const x = atom->x;
+  double * const * const v = atom->v;
+  double * const * const omega = atom->omega;
   const double * const radius = atom->radius;
   const double * const rmass = atom->rmass;
   const double * const mass = atom->mass;
@@ -96,14 +139,12 @@ void PairGranHertzHistoryOMP::eval(int iifrom, int iito, ThrData * const thr)
   const int * const type = atom->type;
   const int * const mask = atom->mask;
   const int nlocal = atom->nlocal;
-  double fxtmp,fytmp,fztmp;
-  double t1tmp,t2tmp,t3tmp;
 
   ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
-  firsttouch = list->listgranhistory->firstneigh;
-  firstshear = list->listgranhistory->firstdouble;
+  firsttouch = listgranhistory->firstneigh;
+  firstshear = listgranhistory->firstdouble;
 
   // loop over neighbors of my atoms
 
@@ -118,7 +159,6 @@ void PairGranHertzHistoryOMP::eval(int iifrom, int iito, ThrData * const thr)
     allshear = firstshear[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
-    fxtmp=fytmp=fztmp=t1tmp=t2tmp=t3tmp=0.0;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
@@ -133,154 +173,193 @@ void PairGranHertzHistoryOMP::eval(int iifrom, int iito, ThrData * const thr)
 
       if (rsq >= radsum*radsum) {
 
-	// unset non-touching neighbors
+        // unset non-touching neighbors
 
         touch[jj] = 0;
-	shear = &allshear[3*jj];
+        shear = &allshear[dnum_pairgran*jj];
         shear[0] = 0.0;
         shear[1] = 0.0;
         shear[2] = 0.0;
 
       } else {
-	r = sqrt(rsq);
-	rinv = 1.0/r;
-	rsqinv = 1.0/rsq;
-
-	// relative translational velocity
-
-	vr1 = v[i][0] - v[j][0];
-	vr2 = v[i][1] - v[j][1];
-	vr3 = v[i][2] - v[j][2];
-
-	// normal component
-
-	vnnr = vr1*delx + vr2*dely + vr3*delz;
-	vn1 = delx*vnnr * rsqinv;
-	vn2 = dely*vnnr * rsqinv;
-	vn3 = delz*vnnr * rsqinv;
-
-	// tangential component
-
-	vt1 = vr1 - vn1;
-	vt2 = vr2 - vn2;
-	vt3 = vr3 - vn3;
-
-	// relative rotational velocity
-
-	wr1 = (radi*omega[i][0] + radj*omega[j][0]) * rinv;
-	wr2 = (radi*omega[i][1] + radj*omega[j][1]) * rinv;
-	wr3 = (radi*omega[i][2] + radj*omega[j][2]) * rinv;
-
-	// normal force = Hertzian contact + normal velocity damping
-
-	if (rmass) {
-	  meff = rmass[i]*rmass[j] / (rmass[i]+rmass[j]);
-	  if (mask[i] & freeze_group_bit) meff = rmass[j];
-	  if (mask[j] & freeze_group_bit) meff = rmass[i];
-	} else {
-	  itype = type[i];
-	  jtype = type[j];
-	  meff = mass[itype]*mass[jtype] / (mass[itype]+mass[jtype]);
-	  if (mask[i] & freeze_group_bit) meff = mass[jtype];
-	  if (mask[j] & freeze_group_bit) meff = mass[itype];
-	}
-
-	damp = meff*gamman*vnnr*rsqinv;
-	ccel = kn*(radsum-r)*rinv - damp;
-	polyhertz = sqrt((radsum-r)*radi*radj / radsum);
-	ccel *= polyhertz;
-
-	// relative velocities
-
-	vtr1 = vt1 - (delz*wr2-dely*wr3);
-	vtr2 = vt2 - (delx*wr3-delz*wr1);
-	vtr3 = vt3 - (dely*wr1-delx*wr2);
-	vrel = vtr1*vtr1 + vtr2*vtr2 + vtr3*vtr3;
-	vrel = sqrt(vrel);
-
-	// shear history effects
-
-	touch[jj] = 1;
-	shear = &allshear[3*jj];
-
-	if (SHEARUPDATE) {
-	  shear[0] += vtr1*dt;
-	  shear[1] += vtr2*dt;
-	  shear[2] += vtr3*dt;
-	}
-        shrmag = sqrt(shear[0]*shear[0] + shear[1]*shear[1] +
-		      shear[2]*shear[2]);
-
-	// rotate shear displacements
-
-	rsht = shear[0]*delx + shear[1]*dely + shear[2]*delz;
-	rsht *= rsqinv;
-	if (SHEARUPDATE) {
-	  shear[0] -= rsht*delx;
-	  shear[1] -= rsht*dely;
-	  shear[2] -= rsht*delz;
-	}
-
-	// tangential forces = shear + tangential velocity damping
-
-        fs1 = -polyhertz * (kt*shear[0] + meff*gammat*vtr1);
-        fs2 = -polyhertz * (kt*shear[1] + meff*gammat*vtr2);
-        fs3 = -polyhertz * (kt*shear[2] + meff*gammat*vtr3);
-
-	// rescale frictional displacements and forces if needed
-
-	fs = sqrt(fs1*fs1 + fs2*fs2 + fs3*fs3);
-	fn = xmu * fabs(ccel*r);
-
-	if (fs > fn) {
-	  if (shrmag != 0.0) {
-	    const double fnfs = fn/fs;
-	    const double mgkt = meff*gammat/kt;
-	    shear[0] = fnfs * (shear[0] + mgkt*vtr1) - mgkt*vtr1;
-	    shear[1] = fnfs * (shear[1] + mgkt*vtr2) - mgkt*vtr2;
-	    shear[2] = fnfs * (shear[2] + mgkt*vtr3) - mgkt*vtr3;
-	    fs1 *= fnfs;
-	    fs2 *= fnfs;
-	    fs3 *= fnfs;
-	  } else fs1 = fs2 = fs3 = 0.0;
-	}
-
-	// forces & torques
-
-	fx = delx*ccel + fs1;
-	fy = dely*ccel + fs2;
-	fz = delz*ccel + fs3;
-	fxtmp  += fx;
-	fytmp  += fy;
-	fztmp  += fz;
-
-	tor1 = rinv * (dely*fs3 - delz*fs2);
-	tor2 = rinv * (delz*fs1 - delx*fs3);
-	tor3 = rinv * (delx*fs2 - dely*fs1);
-	t1tmp -= radi*tor1;
-	t2tmp -= radi*tor2;
-	t3tmp -= radi*tor3;
-
-	if (j < nlocal) {
-	  f[j][0] -= fx;
-	  f[j][1] -= fy;
-	  f[j][2] -= fz;
-	  torque[j][0] -= radj*tor1;
-	  torque[j][1] -= radj*tor2;
-	  torque[j][2] -= radj*tor3;
-	}
-
-	if (EVFLAG) ev_tally_xyz_thr(this,i,j,nlocal,/* newton_pair */ 0,
-				     0.0,0.0,fx,fy,fz,delx,dely,delz,thr);
+        r = sqrt(rsq);
+        rinv = 1.0/r;
+        rsqinv = 1.0/rsq;
+
+        // relative translational velocity
+
+        vr1 = v[i][0] - v[j][0];
+        vr2 = v[i][1] - v[j][1];
+        vr3 = v[i][2] - v[j][2];
+
+        // normal component
+
+        vnnr = vr1*delx + vr2*dely + vr3*delz;
+        vn1 = delx*vnnr * rsqinv;
+        vn2 = dely*vnnr * rsqinv;
+        vn3 = delz*vnnr * rsqinv;
+
+        // tangential component
 
+        vt1 = vr1 - vn1;
+        vt2 = vr2 - vn2;
+        vt3 = vr3 - vn3;
+
+        // relative rotational velocity
+
+        double deltan=radsum-r;
+        cri = radi-0.5*deltan;
+        crj = radj-0.5*deltan;
+        wr1 = (cri*omega[i][0] + crj*omega[j][0]) * rinv;
+        wr2 = (cri*omega[i][1] + crj*omega[j][1]) * rinv;
+        wr3 = (cri*omega[i][2] + crj*omega[j][2]) * rinv;
+
+        // meff = effective mass of pair of particles
+        // if I or J part of rigid body, use body mass
+        // if I or J is frozen, meff is other particle
+
+        if (rmass) {
+          mi = rmass[i];
+          mj = rmass[j];
+        } else {
+          itype = type[i];
+          jtype = type[j];
+          mi = mass[itype];
+          mj = mass[jtype];
+        }
+        if (RIGIDFLAG)
+        {
+           if(body[i] >= 0) mi = masstotal[body[i]];
+           if(body[j] >= 0) mj = masstotal[body[j]];
+        }
+
+        meff = mi*mj/(mi+mj);
+        if (mask[i] & freeze_group_bit) meff = mj;
+        if (mask[j] & freeze_group_bit) meff = mi;
+
+        deriveContactModelParams(i,j,meff,deltan,kn,kt,gamman,gammat,xmu,rmu,vnnr);
+
+        // normal forces = Hertzian contact + normal velocity damping
+
+        damp = gamman*vnnr*rsqinv;
+        ccel = kn*(radsum-r)*rinv - damp;
+
+        if (COHESIONFLAG) {
+            addCohesionForce(i,j,r,Fn_coh);
+            ccel-=Fn_coh*rinv;
+        }
+
+        // relative velocities
+
+        vtr1 = vt1 - (delz*wr2-dely*wr3);
+        vtr2 = vt2 - (delx*wr3-delz*wr1);
+        vtr3 = vt3 - (dely*wr1-delx*wr2);
+
+        // shear history effects
+
+        touch[jj] = 1;
+
+        shear = &allshear[dnum_pairgran*jj];
+
+        if (SHEARUPDATE)
+        {
+            shear[0] += vtr1*dt;
+            shear[1] += vtr2*dt;
+            shear[2] += vtr3*dt;
+
+            // rotate shear displacements
+
+            rsht = shear[0]*delx + shear[1]*dely + shear[2]*delz;
+            rsht *= rsqinv;
+            shear[0] -= rsht*delx;
+            shear[1] -= rsht*dely;
+            shear[2] -= rsht*delz;
+        }
+
+        shrmag = sqrt(shear[0]*shear[0] + shear[1]*shear[1] +  shear[2]*shear[2]);
+
+        // tangential forces = shear + tangential velocity damping
+
+        fs1 = - (kt*shear[0]);
+        fs2 = - (kt*shear[1]);
+        fs3 = - (kt*shear[2]);
+
+        // rescale frictional displacements and forces if needed
+
+        fs = sqrt(fs1*fs1 + fs2*fs2 + fs3*fs3);
+        fn = xmu * fabs(ccel*r);
+
+        // energy loss from sliding or damping
+        if (fs > fn) {
+            if (shrmag != 0.0) {
+                fs1 *= fn/fs;
+                fs2 *= fn/fs;
+                fs3 *= fn/fs;
+                shear[0] = -fs1/kt;
+                shear[1] = -fs2/kt;
+                shear[2] = -fs3/kt;
+            }
+            else fs1 = fs2 = fs3 = 0.0;
+        }
+        else
+        {
+            fs1 -= (gammat*vtr1);
+            fs2 -= (gammat*vtr2);
+            fs3 -= (gammat*vtr3);
+        }
+
+        // forces & torques
+
+        fx = delx*ccel + fs1;
+        fy = dely*ccel + fs2;
+        fz = delz*ccel + fs3;
+
+        tor1 = rinv * (dely*fs3 - delz*fs2);
+        tor2 = rinv * (delz*fs1 - delx*fs3);
+        tor3 = rinv * (delx*fs2 - dely*fs1);
+
+        // add rolling friction torque
+        vectorZeroize3D(r_torque);
+        if(ROLLINGFLAG)
+        {
+            vectorSubtract3D(omega[i],omega[j],wr_roll);
+            wr_rollmag = vectorMag3D(wr_roll);
+
+            if(wr_rollmag > 0.)
+            {
+                // calculate torque
+                reff=radi*radj/(radi+radj);
+                vectorScalarMult3D(wr_roll,rmu*kn*deltan*reff/wr_rollmag,r_torque);
+
+                // remove normal (torsion) part of torque
+                double rtorque_dot_delta = r_torque[0]*delx + r_torque[1]*dely + r_torque[2]*delz;
+                r_torque_n[0] = delx * rtorque_dot_delta * rsqinv;
+                r_torque_n[1] = dely * rtorque_dot_delta * rsqinv;
+                r_torque_n[2] = delz * rtorque_dot_delta * rsqinv;
+                vectorSubtract3D(r_torque,r_torque_n,r_torque);
+            }
+        }
+
+        f[i][0] += fx;
+        f[i][1] += fy;
+        f[i][2] += fz;
+        torque[i][0] -= cri*tor1 + r_torque[0];
+        torque[i][1] -= cri*tor2 + r_torque[1];
+        torque[i][2] -= cri*tor3 + r_torque[2];
+
+        if (j < nlocal) {
+          f[j][0] -= fx;
+          f[j][1] -= fy;
+          f[j][2] -= fz;
+          torque[j][0] -= crj*tor1 - r_torque[0];
+          torque[j][1] -= crj*tor2 - r_torque[1];
+          torque[j][2] -= crj*tor3 - r_torque[2];
+        }
+
+        if (EVFLAG) ev_tally_xyz_thr(this,i,j,nlocal,/* newton_pair */ 0,
+                                     0.0,0.0,fx,fy,fz,delx,dely,delz,thr);
       }
     }
-    f[i][0] += fxtmp;
-    f[i][1] += fytmp;
-    f[i][2] += fztmp;
-    torque[i][0] += t1tmp;
-    torque[i][1] += t2tmp;
-    torque[i][2] += t3tmp;
   }
 }
 
@@ -5,7 +5,7 @@
 
    Copyright (2003) Sandia Corporation.  Under the terms of Contract
    DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
-   certain rights in this software.  This software is distributed under 
+   certain rights in this software.  This software is distributed under
    the GNU General Public License.
 
    See the README file in the top-level LAMMPS directory.
@@ -34,11 +34,13 @@ class PairGranHertzHistoryOMP : public PairGranHertzHistory, public ThrOMP {
  public:
   PairGranHertzHistoryOMP(class LAMMPS *);
 
-  virtual void compute(int, int);
+  virtual void compute_force(int eflag, int vflag, int addflag);
   virtual double memory_usage();
 
  private:
   template <int EVFLAG, int SHEARUPDATE>
+  void eval_dispatch(int ifrom, int ito, ThrData * const thr);
+  template <int EVFLAG, int SHEARUPDATE, int COHESIONFLAG, int ROLLINGFLAG, int RIGIDFLAG>
   void eval(int ifrom, int ito, ThrData * const thr);
 };
 
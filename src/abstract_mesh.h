@@ -65,6 +65,14 @@ namespace LAMMPS_NS
 
         virtual bool isMoving() = 0;
 
+        // rigid frame for moving mesh
+        virtual void setRigidFrame() = 0;
+        virtual bool isRigidFrame() = 0;
+        virtual void updateRigidFrame() = 0;
+        virtual void zeroRigidVelocity() = 0;
+        virtual void addRigidVelocity(double *vel) = 0;
+        virtual void addRigidAngularVelocity(double *omega, double *p) = 0;
+
         // get node j of element i
         
         virtual void node_slow(int i,int j,double *node) = 0;
@@ -0,0 +1,720 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "mpi.h"
+#include "math.h"
+#include "stdlib.h"
+#include "string.h"
+#include "balance.h"
+#include "atom.h"
+#include "comm.h"
+#include "irregular.h"
+#include "domain.h"
+#include "force.h"
+#include "modify.h"
+#include "timer.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+enum{NONE,UNIFORM,USER,DYNAMIC};
+enum{X,Y,Z};
+enum{COUNT,TIME};
+
+/* ---------------------------------------------------------------------- */
+
+Balance::Balance(LAMMPS *lmp) : Pointers(lmp)
+{
+  MPI_Comm_rank(world,&me);
+  MPI_Comm_size(world,&nprocs);
+
+  weightflag = COUNT;
+
+  xflag = yflag = zflag = NONE;
+  user_xsplit = user_ysplit = user_zsplit = NULL;
+  dflag = 0;
+  ndim = 0;
+
+  maxnp = 0;
+  onecost = allcost = sum = target = NULL;
+  lo = hi = losum = hisum = NULL;
+
+  weight = NULL;
+  maxweight = 0;
+  time_last = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+Balance::~Balance()
+{
+  delete [] user_xsplit;
+  delete [] user_ysplit;
+  delete [] user_zsplit;
+
+  memory->destroy(onecost);
+  memory->destroy(allcost);
+  memory->destroy(sum);
+  memory->destroy(target);
+  memory->destroy(lo);
+  memory->destroy(hi);
+  memory->destroy(losum);
+  memory->destroy(hisum);
+
+  memory->destroy(weight);
+}
+
+/* ----------------------------------------------------------------------
+   called as balance command in input script
+------------------------------------------------------------------------- */
+
+void Balance::command(int narg, char **arg)
+{
+  if (domain->box_exist == 0)
+    error->all(FLERR,"Balance command before simulation box is defined");
+
+  if (comm->me == 0 && screen) fprintf(screen,"Balancing ...\n");
+
+  // parse arguments
+
+  if (narg < 2) error->all(FLERR,"Illegal balance command");
+
+  int dimension = domain->dimension;
+  int *procgrid = comm->procgrid;
+
+  double thresh = force->numeric(arg[0]);
+  if (thresh < 1.0) error->all(FLERR,"Illegal balance command");
+
+  int iarg = 1;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"x") == 0) {
+      if (xflag == DYNAMIC) error->all(FLERR,"Illegal balance command");
+      if (iarg+2 > narg) error->all(FLERR,"Illegal balance command");
+      if (strcmp(arg[iarg+1],"uniform") == 0) {
+        xflag = UNIFORM;
+        iarg += 2;
+      } else {
+        xflag = USER;
+        delete [] user_xsplit;
+        user_xsplit = new double[procgrid[0]+1];
+        user_xsplit[0] = 0.0;
+        iarg++;
+        for (int i = 1; i < procgrid[0]; i++) {
+          if (iarg >= narg) error->all(FLERR,"Illegal balance command");
+          user_xsplit[i] = force->numeric(arg[iarg++]);
+        }
+        user_xsplit[procgrid[0]] = 1.0;
+      }
+    } else if (strcmp(arg[iarg],"y") == 0) {
+      if (yflag == DYNAMIC) error->all(FLERR,"Illegal balance command");
+      if (iarg+2 > narg) error->all(FLERR,"Illegal balance command");
+      if (strcmp(arg[iarg+1],"uniform") == 0) {
+        yflag = UNIFORM;
+        iarg += 2;
+      } else {
+        yflag = USER;
+        delete [] user_ysplit;
+        user_ysplit = new double[procgrid[1]+1];
+        user_ysplit[0] = 0.0;
+        iarg++;
+        for (int i = 1; i < procgrid[1]; i++) {
+          if (iarg >= narg) error->all(FLERR,"Illegal balance command");
+          user_ysplit[i] = force->numeric(arg[iarg++]);
+        }
+        user_ysplit[procgrid[1]] = 1.0;
+      }
+    } else if (strcmp(arg[iarg],"z") == 0) {
+      if (zflag == DYNAMIC) error->all(FLERR,"Illegal balance command");
+      if (iarg+2 > narg) error->all(FLERR,"Illegal balance command");
+      if (strcmp(arg[iarg+1],"uniform") == 0) {
+        zflag = UNIFORM;
+        iarg += 2;
+      } else {
+        zflag = USER;
+        delete [] user_zsplit;
+        user_zsplit = new double[procgrid[2]+1];
+        user_zsplit[0] = 0.0;
+        iarg++;
+        for (int i = 1; i < procgrid[2]; i++) {
+          if (iarg >= narg) error->all(FLERR,"Illegal balance command");
+          user_zsplit[i] = force->numeric(arg[iarg++]);
+        }
+        user_zsplit[procgrid[2]] = 1.0;
+      }
+
+    } else if (strcmp(arg[iarg],"shift") == 0) {
+      if (xflag != NONE || yflag != NONE || zflag != NONE)
+        error->all(FLERR,"Illegal balance command");
+      if (iarg+4 > narg) error->all(FLERR,"Illegal balance command");
+      dflag = 1;
+      shift_setup(arg[iarg+1],force->inumeric(arg[iarg+2]),
+                  force->numeric(arg[iarg+3]));
+      for (int i = 0; i < ndim; i++) {
+        if (bdim[i] == X) xflag = DYNAMIC;
+        else if (bdim[i] == Y) yflag = DYNAMIC;
+        else zflag = DYNAMIC;
+      }
+      iarg += 4;
+
+    } else if (strcmp(arg[iarg],"weight") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal balance command");
+      weight_setup(arg[iarg+1]);
+      iarg += 2;
+
+    } else error->all(FLERR,"Illegal balance command");
+  }
+
+  // error check
+
+  if (zflag && dimension == 2)
+    error->all(FLERR,"Cannot balance in z dimension for 2d simulation");
+
+  if (xflag == USER)
+    for (int i = 1; i <= procgrid[0]; i++)
+      if (user_xsplit[i-1] >= user_xsplit[i])
+        error->all(FLERR,"Illegal balance command");
+  if (yflag == USER)
+    for (int i = 1; i <= procgrid[1]; i++)
+      if (user_ysplit[i-1] >= user_ysplit[i])
+        error->all(FLERR,"Illegal balance command");
+  if (zflag == USER)
+    for (int i = 1; i <= procgrid[2]; i++)
+      if (user_zsplit[i-1] >= user_zsplit[i])
+        error->all(FLERR,"Illegal balance command");
+
+  double start_time = MPI_Wtime();
+
+  // time cost of last run, before init resets fix timing
+
+  double mycost = cost();
+
+  // insure atoms are in current box & update box via shrink-wrap
+  // init entire system since comm->exchange is done
+  // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
+
+  lmp->init();
+
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  domain->pbc();
+  domain->reset_box();
+  comm->setup();
+  comm->exchange();
+
+  // imbinit = initial imbalance
+  // use timing of last run if weighted by time
+
+  set_weights(mycost);
+  double maxinit;
+  double imbinit = imbalance_factor(maxinit);
+
+  // no load-balance if imbalance doesn't exceed threshold
+
+  if (imbinit < thresh) {
+    if (domain->triclinic) domain->lamda2x(atom->nlocal);
+    if (me == 0) {
+      if (screen) {
+        fprintf(screen,"  initial max load/proc = %g\n",maxinit);
+        fprintf(screen,"  imbalance factor = %g below threshold, "
+                "no rebalancing\n",imbinit);
+      }
+      if (logfile) {
+        fprintf(logfile,"  initial max load/proc = %g\n",maxinit);
+        fprintf(logfile,"  imbalance factor = %g below threshold, "
+                "no rebalancing\n",imbinit);
+      }
+    }
+    return;
+  }
+
+  // explicit setting of sub-domain sizes
+
+  if (xflag == UNIFORM) {
+    for (int i = 0; i < procgrid[0]; i++)
+      comm->xsplit[i] = i * 1.0/procgrid[0];
+    comm->xsplit[procgrid[0]] = 1.0;
+  } else if (xflag == USER)
+    for (int i = 0; i <= procgrid[0]; i++) comm->xsplit[i] = user_xsplit[i];
+
+  if (yflag == UNIFORM) {
+    for (int i = 0; i < procgrid[1]; i++)
+      comm->ysplit[i] = i * 1.0/procgrid[1];
+    comm->ysplit[procgrid[1]] = 1.0;
+  } else if (yflag == USER)
+    for (int i = 0; i <= procgrid[1]; i++) comm->ysplit[i] = user_ysplit[i];
+
+  if (zflag == UNIFORM) {
+    for (int i = 0; i < procgrid[2]; i++)
+      comm->zsplit[i] = i * 1.0/procgrid[2];
+    comm->zsplit[procgrid[2]] = 1.0;
+  } else if (zflag == USER)
+    for (int i = 0; i <= procgrid[2]; i++) comm->zsplit[i] = user_zsplit[i];
+
+  // shift sub-domain boundaries to balance the load
+
+  int niter = 0;
+  if (dflag) niter = shift();
+
+  // predicted final imbalance, then move atoms to new procs
+  // particles carry their per-atom fix data, e.g. contact history,
+  // mesh elements follow in the setup of the next run
+
+  double maxfinal;
+  double imbfinal = imbalance_splits(maxfinal);
+
+  migrate_atoms();
+
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+
+  // stats output
+
+  double stop_time = MPI_Wtime();
+
+  if (me == 0) {
+    if (screen) {
+      fprintf(screen,"  rebalancing time: %g seconds\n",stop_time-start_time);
+      fprintf(screen,"  iteration count = %d\n",niter);
+      fprintf(screen,"  initial/final max load/proc = %g %g\n",
+              maxinit,maxfinal);
+      fprintf(screen,"  initial/final imbalance factor = %g %g\n",
+              imbinit,imbfinal);
+    }
+    if (logfile) {
+      fprintf(logfile,"  rebalancing time: %g seconds\n",stop_time-start_time);
+      fprintf(logfile,"  iteration count = %d\n",niter);
+      fprintf(logfile,"  initial/final max load/proc = %g %g\n",
+              maxinit,maxfinal);
+      fprintf(logfile,"  initial/final imbalance factor = %g %g\n",
+              imbinit,imbfinal);
+    }
+    print_cuts(screen);
+    print_cuts(logfile);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   setup shift balance with dimensions in str, also used by fix balance
+------------------------------------------------------------------------- */
+
+void Balance::shift_setup(char *str, int nitermax, double thresh)
+{
+  if (strlen(str) > 3) error->all(FLERR,"Balance shift string is invalid");
+  strcpy(bstr,str);
+
+  int nstr = strlen(bstr);
+  ndim = 0;
+  for (int i = 0; i < nstr; i++) {
+    if (bstr[i] != 'x' && bstr[i] != 'y' && bstr[i] != 'z')
+      error->all(FLERR,"Balance shift string is invalid");
+    if (bstr[i] == 'z' && domain->dimension == 2)
+      error->all(FLERR,"Balance shift string is invalid");
+    for (int j = i+1; j < nstr; j++)
+      if (bstr[i] == bstr[j])
+        error->all(FLERR,"Balance shift string is invalid");
+    if (bstr[i] == 'x') bdim[ndim++] = X;
+    else if (bstr[i] == 'y') bdim[ndim++] = Y;
+    else bdim[ndim++] = Z;
+  }
+
+  niter = nitermax;
+  if (niter <= 0) error->all(FLERR,"Illegal balance command");
+  stopthresh = thresh;
+  if (stopthresh < 1.0) error->all(FLERR,"Illegal balance command");
+
+  int *procgrid = comm->procgrid;
+  int n = MAX(procgrid[0],procgrid[1]);
+  n = MAX(n,procgrid[2]) + 1;
+  if (n > maxnp) {
+    maxnp = n;
+    memory->destroy(onecost);
+    memory->destroy(allcost);
+    memory->destroy(sum);
+    memory->destroy(target);
+    memory->destroy(lo);
+    memory->destroy(hi);
+    memory->destroy(losum);
+    memory->destroy(hisum);
+    memory->create(onecost,maxnp,"balance:onecost");
+    memory->create(allcost,maxnp,"balance:allcost");
+    memory->create(sum,maxnp,"balance:sum");
+    memory->create(target,maxnp,"balance:target");
+    memory->create(lo,maxnp,"balance:lo");
+    memory->create(hi,maxnp,"balance:hi");
+    memory->create(losum,maxnp,"balance:losum");
+    memory->create(hisum,maxnp,"balance:hisum");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set how particles are weighted, also used by fix balance
+   count = each particle has weight 1
+   time = measured pair, neighbor and fix time of a proc is spread
+          evenly over its particles
+------------------------------------------------------------------------- */
+
+void Balance::weight_setup(char *str)
+{
+  if (strcmp(str,"count") == 0) weightflag = COUNT;
+  else if (strcmp(str,"time") == 0) weightflag = TIME;
+  else error->all(FLERR,"Illegal balance weight style");
+}
+
+/* ----------------------------------------------------------------------
+   time cost of this proc since last call or reset_time()
+   0.0 unless particles are weighted by time
+------------------------------------------------------------------------- */
+
+double Balance::cost()
+{
+  if (weightflag != TIME) return 0.0;
+
+  double time_now = timed_cost();
+  double mycost = MAX(time_now - time_last,0.0);
+  time_last = time_now;
+  return mycost;
+}
+
+/* ----------------------------------------------------------------------
+   timers were reset at start of run, time cost counts from zero again
+------------------------------------------------------------------------- */
+
+void Balance::reset_time()
+{
+  time_last = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   set weight of each owned particle
+   for time weights, mycost = time cost of this proc
+   fall back to count if no time was measured on any proc
+------------------------------------------------------------------------- */
+
+void Balance::set_weights(double mycost)
+{
+  int nlocal = atom->nlocal;
+
+  if (nlocal > maxweight) {
+    maxweight = atom->nmax;
+    memory->destroy(weight);
+    memory->create(weight,maxweight,"balance:weight");
+  }
+
+  double w = 1.0;
+
+  if (weightflag == TIME) {
+    double costmax;
+    MPI_Allreduce(&mycost,&costmax,1,MPI_DOUBLE,MPI_MAX,world);
+    if (costmax > 0.0 && nlocal) w = mycost/nlocal;
+  }
+
+  for (int i = 0; i < nlocal; i++) weight[i] = w;
+}
+
+/* ----------------------------------------------------------------------
+   time spent by this proc on pair, neighbor and fix computations
+   wall fixes and meshes are timed as fixes
+------------------------------------------------------------------------- */
+
+double Balance::timed_cost()
+{
+  double cost = timer->array[TIME_PAIR] + timer->array[TIME_NEIGHBOR];
+  for (int i = 0; i < modify->nfix; i++)
+    for (int j = 0; j < Modify::FIXTIME_N; j++)
+      cost += modify->fix_time[i][j];
+  return cost;
+}
+
+/* ----------------------------------------------------------------------
+   calculate imbalance based on weights of owned particles
+   return max = max load per proc
+   return imbalance factor = max load per proc / ave load per proc
+------------------------------------------------------------------------- */
+
+double Balance::imbalance_factor(double &max)
+{
+  double mycost = 0.0;
+  for (int i = 0; i < atom->nlocal; i++) mycost += weight[i];
+
+  double total;
+  MPI_Allreduce(&mycost,&max,1,MPI_DOUBLE,MPI_MAX,world);
+  MPI_Allreduce(&mycost,&total,1,MPI_DOUBLE,MPI_SUM,world);
+
+  double imbalance = 1.0;
+  if (total > 0.0) imbalance = max / (total/nprocs);
+  return imbalance;
+}
+
+/* ----------------------------------------------------------------------
+   calculate imbalance the current splits will have once owned particles
+   are migrated to their new procs
+   return max = max load per proc
+   return imbalance factor = max load per proc / ave load per proc
+------------------------------------------------------------------------- */
+
+double Balance::imbalance_splits(double &max)
+{
+  int *procgrid = comm->procgrid;
+  int ***grid2proc = comm->grid2proc;
+  double *boxlo = domain->boxlo;
+  double *prd = domain->prd;
+  int triclinic = domain->triclinic;
+
+  double *proccost = new double[nprocs];
+  double *allproccost = new double[nprocs];
+  for (int i = 0; i < nprocs; i++) proccost[i] = 0.0;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  int ix,iy,iz;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (triclinic) {
+      ix = binary(x[i][0],procgrid[0],comm->xsplit);
+      iy = binary(x[i][1],procgrid[1],comm->ysplit);
+      iz = binary(x[i][2],procgrid[2],comm->zsplit);
+    } else {
+      ix = binary((x[i][0]-boxlo[0])/prd[0],procgrid[0],comm->xsplit);
+      iy = binary((x[i][1]-boxlo[1])/prd[1],procgrid[1],comm->ysplit);
+      iz = binary((x[i][2]-boxlo[2])/prd[2],procgrid[2],comm->zsplit);
+    }
+    proccost[grid2proc[ix][iy][iz]] += weight[i];
+  }
+
+  MPI_Allreduce(proccost,allproccost,nprocs,MPI_DOUBLE,MPI_SUM,world);
+
+  double total = 0.0;
+  max = 0.0;
+  for (int i = 0; i < nprocs; i++) {
+    total += allproccost[i];
+    max = MAX(max,allproccost[i]);
+  }
+
+  delete [] proccost;
+  delete [] allproccost;
+
+  double imbalance = 1.0;
+  if (total > 0.0) imbalance = max / (total/nprocs);
+  return imbalance;
+}
+
+/* ----------------------------------------------------------------------
+   shift the split planes of each dim in bstr so that the slabs between
+     them carry equal weight, dims are independent for a proc grid
+   each split is bracketed by two positions with weight below and above
+     its target, the bracket is narrowed by interpolating the cumulative
+     weight, keeping at least 10% of the bracket on either side
+   stop when slabs are balanced within stopthresh or after niter iterations
+   owned particles must be in lamda coords for triclinic
+   return total # of iterations
+------------------------------------------------------------------------- */
+
+int Balance::shift()
+{
+  int i,j,idim,dim,iter;
+  double *split;
+  double total,maxslab,frac;
+
+  int *procgrid = comm->procgrid;
+  int niter_total = 0;
+
+  for (idim = 0; idim < ndim; idim++) {
+    dim = bdim[idim];
+    if (dim == X) split = comm->xsplit;
+    else if (dim == Y) split = comm->ysplit;
+    else split = comm->zsplit;
+
+    np = procgrid[dim];
+    if (np == 1) continue;
+
+    tally(dim,np,split);
+    total = sum[np];
+    if (total == 0.0) continue;
+
+    for (i = 0; i <= np; i++) target[i] = total * i/np;
+
+    // initial bracket = current splits whose weights enclose target
+
+    lo[0] = hi[0] = 0.0;
+    losum[0] = hisum[0] = 0.0;
+    lo[np] = hi[np] = 1.0;
+    losum[np] = hisum[np] = total;
+    for (i = 1; i < np; i++) {
+      for (j = 0; j < np-1 && sum[j+1] < target[i]; j++);
+      lo[i] = split[j];
+      losum[i] = sum[j];
+      hi[i] = split[j+1];
+      hisum[i] = sum[j+1];
+    }
+
+    for (iter = 0; iter < niter; iter++) {
+      maxslab = 0.0;
+      for (i = 0; i < np; i++) maxslab = MAX(maxslab,sum[i+1]-sum[i]);
+      if (maxslab*np/total <= stopthresh) break;
+
+      for (i = 1; i < np; i++) {
+        if (hisum[i] > losum[i])
+          frac = (target[i]-losum[i]) / (hisum[i]-losum[i]);
+        else frac = 0.5;
+        frac = MAX(frac,0.1);
+        frac = MIN(frac,0.9);
+        split[i] = lo[i] + frac*(hi[i]-lo[i]);
+      }
+      for (i = 1; i < np; i++)
+        if (split[i] < split[i-1]) split[i] = split[i-1];
+
+      tally(dim,np,split);
+      niter_total++;
+
+      for (i = 1; i < np; i++) {
+        if (sum[i] < target[i]) {
+          lo[i] = split[i];
+          losum[i] = sum[i];
+        } else {
+          hi[i] = split[i];
+          hisum[i] = sum[i];
+        }
+      }
+    }
+
+    for (i = 1; i <= np; i++)
+      if (split[i] < split[i-1])
+        error->all(FLERR,"Balance produced bad splits");
+  }
+
+  return niter_total;
+}
+
+/* ----------------------------------------------------------------------
+   sum[i] = weight of all particles below split i in dim
+------------------------------------------------------------------------- */
+
+void Balance::tally(int dim, int n, double *split)
+{
+  int i;
+
+  for (i = 0; i < n; i++) onecost[i] = 0.0;
+
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+  double boxlo = domain->boxlo[dim];
+  double prdinv = 1.0/domain->prd[dim];
+  int triclinic = domain->triclinic;
+
+  if (triclinic)
+    for (i = 0; i < nlocal; i++)
+      onecost[binary(x[i][dim],n,split)] += weight[i];
+  else
+    for (i = 0; i < nlocal; i++)
+      onecost[binary((x[i][dim]-boxlo)*prdinv,n,split)] += weight[i];
+
+  MPI_Allreduce(onecost,allcost,n,MPI_DOUBLE,MPI_SUM,world);
+
+  sum[0] = 0.0;
+  for (i = 0; i < n; i++) sum[i+1] = sum[i] + allcost[i];
+}
+
+/* ----------------------------------------------------------------------
+   reset sub-domains to current splits and move owned particles there
+   owned particles must be in lamda coords for triclinic
+------------------------------------------------------------------------- */
+
+void Balance::migrate_atoms()
+{
+  // uniform = 1 only if all splits are still uniform
+
+  int *procgrid = comm->procgrid;
+  double *split[3] = {comm->xsplit,comm->ysplit,comm->zsplit};
+
+  comm->uniform = 1;
+  for (int dim = 0; dim < 3; dim++)
+    for (int i = 0; i <= procgrid[dim]; i++)
+      if (fabs(split[dim][i] - i * 1.0/procgrid[dim]) > 1.0e-12)
+        comm->uniform = 0;
+
+  domain->set_local_box();
+
+  Irregular *irregular = new Irregular(lmp);
+  irregular->migrate_atoms();
+  delete irregular;
+
+  // check if any atoms were lost
+
+  bigint natoms;
+  bigint nblocal = atom->nlocal;
+  MPI_Allreduce(&nblocal,&natoms,1,MPI_LMP_BIGINT,MPI_SUM,world);
+  if (natoms != atom->natoms && me == 0) {
+    char str[128];
+    sprintf(str,"Lost atoms via balance: original " BIGINT_FORMAT
+            " current " BIGINT_FORMAT,atom->natoms,natoms);
+    error->warning(FLERR,str);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   print sub-domain boundaries of each dim to fp
+------------------------------------------------------------------------- */
+
+void Balance::print_cuts(FILE *fp)
+{
+  if (!fp) return;
+
+  int *procgrid = comm->procgrid;
+  double *split[3] = {comm->xsplit,comm->ysplit,comm->zsplit};
+  const char *name[3] = {"x","y","z"};
+
+  for (int dim = 0; dim < domain->dimension; dim++) {
+    fprintf(fp,"  %s cuts:",name[dim]);
+    for (int i = 0; i <= procgrid[dim]; i++) fprintf(fp," %g",split[dim][i]);
+    fprintf(fp,"\n");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   binary search for where value falls in N-length vec
+   note that vec actually has N+1 values, but ignore last one
+   values in vec are monotonically increasing, but adjacent values can be ==
+   return index = 0 to N-1, such that vec[index] <= value < vec[index+1]
+   value < vec[0] returns 0, value >= vec[N-1] returns N-1
+   for adjacent values that are equal, return index of the last one
+------------------------------------------------------------------------- */
+
+int Balance::binary(double value, int n, double *vec)
+{
+  int ilo = 0;
+  int ihi = n-1;
+
+  if (value < vec[ilo]) return ilo;
+  if (value >= vec[ihi]) return ihi;
+
+  // insure vec[ilo] <= value < vec[ihi] at every iteration
+  // done when ilo,ihi are adjacent
+
+  int index = (ilo+ihi)/2;
+  while (ilo < ihi-1) {
+    if (value < vec[index]) ihi = index;
+    else if (value >= vec[index]) ilo = index;
+    index = (ilo+ihi)/2;
+  }
+
+  return index;
+}
@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMMAND_CLASS
+
+CommandStyle(balance,Balance)
+
+#else
+
+#ifndef LMP_BALANCE_H
+#define LMP_BALANCE_H
+
+#include "mpi.h"
+#include "stdio.h"
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+class Balance : protected Pointers {
+ public:
+  Balance(class LAMMPS *);
+  ~Balance();
+  void command(int, char **);
+  void shift_setup(char *, int, double);
+  void weight_setup(char *);
+  int shift();
+  double cost();
+  void set_weights(double);
+  void reset_time();
+  double imbalance_factor(double &);
+  double imbalance_splits(double &);
+  void migrate_atoms();
+  void print_cuts(FILE *);
+
+ private:
+  int me,nprocs;
+
+  int weightflag;                  // COUNT or TIME
+
+  int xflag,yflag,zflag;           // xyz LB flags
+  double *user_xsplit,*user_ysplit,*user_zsplit;    // params for xyz LB
+
+  int dflag;                       // shift LB flag
+  int niter;                       // # of iterations for shift LB
+  double stopthresh;               // threshold for stopping shift LB
+  char bstr[4];                    // dimensions to shift
+  int ndim;                        // length of bstr
+  int bdim[3];                     // XYZ for each char in bstr
+
+  int np;                          // # of procs in dim being shifted
+  int maxnp;                       // size of per-split arrays
+  double *onecost,*allcost;        // weight of my/all atoms in each slab
+  double *sum;                     // cumulative weight below each split
+  double *target;                  // desired cumulative weight at split
+  double *lo,*hi;                  // bracket of each split
+  double *losum,*hisum;            // cumulative weight at lo,hi
+
+  double *weight;                  // weight of each owned atom
+  int maxweight;                   // size of weight array
+  double time_last;                // timed cost at last call of cost()
+
+  double timed_cost();
+  void tally(int, int, double *);
+  int binary(double, int, double *);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Balance command before simulation box is defined
+
+The balance command cannot be used before a read_data, read_restart,
+or create_box command.
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Cannot balance in z dimension for 2d simulation
+
+Self-explanatory.
+
+E: Balance shift string is invalid
+
+The string can only contain the characters "x", "y", or "z".
+
+E: Balance produced bad splits
+
+This should not occur.  It means two or more cutting plane locations
+are out of order.  Report the problem to the developers.
+
+E: Illegal balance weight style
+
+The weight style must be "count" or "time".
+
+W: Lost atoms via balance
+
+Atoms were lost while they were migrated to their new processors.
+
+*/
@@ -172,6 +172,25 @@ void CfdDatacoupling::push(char *name,char *type,void *&ptr,char *datatype)
     }
 }
 
+/* ----------------------------------------------------------------------
+   sub-domain of the calling program on this proc
+   only used by data coupling models that exchange per-atom data sparsely
+------------------------------------------------------------------------- */
+
+void CfdDatacoupling::set_external_domain(double *lo, double *hi)
+{
+    error->all(FLERR,"Setting the domain of the calling program is not supported by this data coupling model");
+}
+
+/* ----------------------------------------------------------------------
+   length of per-atom arrays of the calling program
+------------------------------------------------------------------------- */
+
+int CfdDatacoupling::n_external()
+{
+    return atom->tag_max();
+}
+
 /* ----------------------------------------------------------------------
    check if all properties that were requested are actually communicated
 ------------------------------------------------------------------------- */
@@ -45,6 +45,12 @@ class CfdDatacoupling : protected Pointers {
   virtual void allocate_external(int    **&data, int len2,char *keyword,int initvalue);
   virtual void allocate_external(double **&data, int len2,char *keyword,double initvalue);
 
+  // per-atom data layout on the calling program side
+  // by default, per-atom arrays are indexed by tag-1 on all procs
+  virtual void set_external_domain(double *lo, double *hi);
+  virtual int n_external();
+  virtual int* external_tags() { return NULL; }
+
   void init();
   virtual void post_create() {}
 
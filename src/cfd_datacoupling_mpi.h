@@ -53,10 +53,12 @@ class CfdDatacouplingMPI : public CfdDatacoupling {
   void allocate_external(double **&data, int len2,int len1,     double initvalue);
   void allocate_external(double **&data, int len2,char *keyword,double initvalue);
 
- private:
+ protected:
   template <typename T> T* check_grow(int len);
   template <typename T> MPI_Datatype mpi_type_dc();
 
+ private:
+
   // 1D helper array needed to allreduce the quantities
   int len_allred_double;
   double *allred_double;
@@ -0,0 +1,522 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "string.h"
+#include "stdlib.h"
+#include "atom.h"
+#include "update.h"
+#include "domain.h"
+#include "error.h"
+#include "memory.h"
+#include "comm.h"
+#include "fix_cfd_coupling.h"
+#include "fix_multisphere.h"
+#include "cfd_datacoupling_mpi_sparse.h"
+
+using namespace LAMMPS_NS;
+
+#define DELTA 10000
+
+/* ---------------------------------------------------------------------- */
+
+CfdDatacouplingMPISparse::CfdDatacouplingMPISparse(LAMMPS *lmp,int iarg, int narg, char **arg,FixCfdCoupling* fc) :
+  CfdDatacouplingMPI(lmp, iarg, narg, arg,fc)
+{
+  MPI_Comm_rank(world,&me_);
+  MPI_Comm_size(world,&nprocs_);
+
+  extlo_ = exthi_ = NULL;
+  setup_step_ = -1;
+
+  extgrid_ = false;
+  extn_[0] = extn_[1] = extn_[2] = 0;
+  extcut_[0] = extcut_[1] = extcut_[2] = NULL;
+  extgridproc_ = NULL;
+
+  nextdata_ = maxextdata_ = 0;
+  extdata_ = NULL;
+  extlen_ = NULL;
+
+  nsend_ = maxsend_ = 0;
+  sendlist_ = NULL;
+  nrecv_ = maxrecv_ = 0;
+  recvtag_ = NULL;
+
+  memory->create(sendoffset_,nprocs_+1,"CfdDatacouplingMPISparse:sendoffset_");
+  memory->create(recvoffset_,nprocs_+1,"CfdDatacouplingMPISparse:recvoffset_");
+  memory->create(sendcount_,nprocs_,"CfdDatacouplingMPISparse:sendcount_");
+  memory->create(recvcount_,nprocs_,"CfdDatacouplingMPISparse:recvcount_");
+  request_ = (MPI_Request*) memory->smalloc(nprocs_*sizeof(MPI_Request),"CfdDatacouplingMPISparse:request_");
+
+  sendbuf_ = recvbuf_ = NULL;
+  maxsendbuf_ = maxrecvbuf_ = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+CfdDatacouplingMPISparse::~CfdDatacouplingMPISparse()
+{
+  memory->destroy(extlo_);
+  memory->destroy(exthi_);
+  for(int dim = 0; dim < 3; dim++)
+    memory->destroy(extcut_[dim]);
+  memory->destroy(extgridproc_);
+  memory->sfree(extdata_);
+  memory->destroy(extlen_);
+  memory->destroy(sendlist_);
+  memory->destroy(sendoffset_);
+  memory->destroy(recvtag_);
+  memory->destroy(recvoffset_);
+  memory->destroy(sendcount_);
+  memory->destroy(recvcount_);
+  memory->sfree(request_);
+  memory->sfree(sendbuf_);
+  memory->sfree(recvbuf_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::pull(char *name,char *type,void *&from,char *datatype)
+{
+    if(!is_atom_type(type))
+    {
+        CfdDatacouplingMPI::pull(name,type,from,datatype);
+        return;
+    }
+
+    CfdDatacoupling::pull(name,type,from,datatype);
+
+    if(strcmp(datatype,"double") == 0)
+        pull_sparse<double>(name,type,from);
+    else if(strcmp(datatype,"int") == 0)
+        pull_sparse<int>(name,type,from);
+    else error->one(FLERR,"Illegal call to CfdDatacouplingMPISparse::pull, valid datatypes are 'int' and double'");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::push(char *name,char *type,void *&to,char *datatype)
+{
+    if(!is_atom_type(type))
+    {
+        CfdDatacouplingMPI::push(name,type,to,datatype);
+        return;
+    }
+
+    CfdDatacoupling::push(name,type,to,datatype);
+
+    if(strcmp(datatype,"double") == 0)
+        push_sparse<double>(name,type,to);
+    else if(strcmp(datatype,"int") == 0)
+        push_sparse<int>(name,type,to);
+    else error->one(FLERR,"Illegal call to CfdDatacouplingMPISparse::push, valid datatypes are 'int' and double'");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::allocate_external(int **&data, int len2,int len1,int initvalue)
+{
+  void *olddata = data;
+  CfdDatacouplingMPI::allocate_external(data,len2,len1,initvalue);
+  register_external(olddata,data,len1,len2);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::allocate_external(int **&data, int len2,char *keyword,int initvalue)
+{
+  if(strcmp(keyword,"nparticles"))
+  {
+    CfdDatacouplingMPI::allocate_external(data,len2,keyword,initvalue);
+    return;
+  }
+
+  setup_exchange();
+
+  int len1 = nrecv_;
+  if(len1 < 1 || len2 < 1)
+    len1 = len2 = 1;
+
+  void *olddata = data;
+  memory->grow(data, len1,len2, "CfdDatacouplingMPISparse:data");
+  for (int i = 0; i < len1; i++)
+    for (int j = 0; j < len2; j++)
+      data[i][j] = initvalue;
+  register_external(olddata,data,len1,len2);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::allocate_external(double **&data, int len2,int len1,double initvalue)
+{
+  void *olddata = data;
+  CfdDatacouplingMPI::allocate_external(data,len2,len1,initvalue);
+  register_external(olddata,data,len1,len2);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::allocate_external(double **&data, int len2,char *keyword,double initvalue)
+{
+  if(strcmp(keyword,"nparticles"))
+  {
+    CfdDatacouplingMPI::allocate_external(data,len2,keyword,initvalue);
+    return;
+  }
+
+  setup_exchange();
+
+  int len1 = nrecv_;
+  if(len1 < 1 || len2 < 1)
+    len1 = len2 = 1;
+
+  void *olddata = data;
+  memory->grow(data, len1,len2, "CfdDatacouplingMPISparse:data");
+  for (int i = 0; i < len1; i++)
+    for (int j = 0; j < len2; j++)
+      data[i][j] = initvalue;
+  register_external(olddata,data,len1,len2);
+}
+
+/* ----------------------------------------------------------------------
+   remember size of an array allocated for the calling program
+   olddata is the array before it was grown
+   a record with the same address belongs to an array that has been
+   freed by the calling program in the meantime, so it is replaced
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::register_external(void *olddata,void *data,int len1,int len2)
+{
+  int i = 0;
+  while(i < nextdata_ && extdata_[i] != data && (!olddata || extdata_[i] != olddata))
+    i++;
+
+  // drop other records of the old or new address
+  for(int k = i+1; k < nextdata_; k++)
+  {
+    if(extdata_[k] != data && (!olddata || extdata_[k] != olddata)) continue;
+    nextdata_--;
+    extdata_[k] = extdata_[nextdata_];
+    extlen_[k][0] = extlen_[nextdata_][0];
+    extlen_[k][1] = extlen_[nextdata_][1];
+    k--;
+  }
+
+  if(i == nextdata_)
+  {
+    if(nextdata_ == maxextdata_)
+    {
+      maxextdata_ += 16;
+      extdata_ = (void**) memory->srealloc(extdata_,maxextdata_*sizeof(void*),"CfdDatacouplingMPISparse:extdata_");
+      memory->grow(extlen_,maxextdata_,2,"CfdDatacouplingMPISparse:extlen_");
+    }
+    nextdata_++;
+  }
+
+  extdata_[i] = data;
+  extlen_[i][0] = len1;
+  extlen_[i][1] = len2;
+}
+
+/* ----------------------------------------------------------------------
+   per-atom array of the calling program must hold n_external() x len2
+   values, i.e. it has to be re-allocated if n_external() has grown
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::check_external(void *data,int len2,char *name)
+{
+  if(nrecv_ == 0) return;
+
+  for(int i = 0; i < nextdata_; i++)
+  {
+    if(extdata_[i] != data) continue;
+    if(extlen_[i][0] >= nrecv_ && extlen_[i][1] == len2) return;
+
+    if(screen) fprintf(screen,"Array of calling program for property %s has size %d x %d, need %d x %d\n",
+                       name,extlen_[i][0],extlen_[i][1],nrecv_,len2);
+    error->one(FLERR,"Per-atom array of calling program too small for coupling model mpi/sparse, "
+                     "re-allocate it with allocate_external() after the # of particles has changed");
+  }
+
+  if(screen) fprintf(screen,"Array of calling program for property %s\n",name);
+  error->one(FLERR,"Per-atom arrays of calling program have to be allocated with allocate_external() "
+                   "for coupling model mpi/sparse");
+}
+
+/* ----------------------------------------------------------------------
+   sub-domain of the calling program on this proc
+   must be called by all procs
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::set_external_domain(double *lo, double *hi)
+{
+    if(!extlo_)
+    {
+        memory->create(extlo_,nprocs_,3,"CfdDatacouplingMPISparse:extlo_");
+        memory->create(exthi_,nprocs_,3,"CfdDatacouplingMPISparse:exthi_");
+    }
+
+    MPI_Allgather(lo,3,MPI_DOUBLE,&(extlo_[0][0]),3,MPI_DOUBLE,world);
+    MPI_Allgather(hi,3,MPI_DOUBLE,&(exthi_[0][0]),3,MPI_DOUBLE,world);
+
+    setup_external_grid();
+
+    // force set-up of exchange pattern
+    setup_step_ = -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int CfdDatacouplingMPISparse::n_external()
+{
+    setup_exchange();
+    return nrecv_;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int* CfdDatacouplingMPISparse::external_tags()
+{
+    setup_exchange();
+    return recvtag_;
+}
+
+/* ----------------------------------------------------------------------
+   set up which owned particle goes to which proc
+   done once per coupling step since particles move between sub-domains
+   of the calling program also without re-neighboring
+------------------------------------------------------------------------- */
+
+void CfdDatacouplingMPISparse::setup_exchange()
+{
+    if(setup_step_ == update->ntimestep) return;
+    setup_step_ = update->ntimestep;
+
+    // without a domain set by the calling program, use the LIGGGHTS
+    // sub-domains so that data stays on the proc
+
+    if(!extlo_)
+    {
+        double lo[3],hi[3];
+        for(int k = 0; k < 3; k++)
+        {
+            lo[k] = domain->sublo[k];
+            hi[k] = domain->subhi[k];
+        }
+        set_external_domain(lo,hi);
+        setup_step_ = update->ntimestep;
+    }
+
+    int nlocal = atom->nlocal;
+    double **x = atom->x;
+    int *tag = atom->tag;
+
+    if(nlocal > maxsend_)
+    {
+        maxsend_ = nlocal + DELTA;
+        memory->destroy(sendlist_);
+        memory->create(sendlist_,maxsend_,"CfdDatacouplingMPISparse:sendlist_");
+    }
+
+    // receiving proc for each particle, counting sort by proc
+
+    int *dest = (int*) grow_buf(recvbuf_,maxrecvbuf_,(nlocal > 0 ? nlocal : 1)*sizeof(int));
+
+    for(int p = 0; p < nprocs_; p++)
+        sendcount_[p] = 0;
+
+    for(int i = 0; i < nlocal; i++)
+    {
+        dest[i] = find_external_proc(x[i]);
+        if(dest[i] >= 0) sendcount_[dest[i]]++;
+    }
+
+    sendoffset_[0] = 0;
+    for(int p = 0; p < nprocs_; p++)
+        sendoffset_[p+1] = sendoffset_[p] + sendcount_[p];
+    nsend_ = sendoffset_[nprocs_];
+
+    for(int i = 0; i < nlocal; i++)
+        if(dest[i] >= 0)
+            sendlist_[sendoffset_[dest[i]]++] = i;
+
+    for(int p = nprocs_; p > 0; p--)
+        sendoffset_[p] = sendoffset_[p-1];
+    sendoffset_[0] = 0;
+
+    // # of particles received from each proc
+
+    MPI_Alltoall(sendcount_,1,MPI_INT,recvcount_,1,MPI_INT,world);
+
+    recvoffset_[0] = 0;
+    for(int p = 0; p < nprocs_; p++)
+        recvoffset_[p+1] = recvoffset_[p] + recvcount_[p];
+    nrecv_ = recvoffset_[nprocs_];
+
+    if(nrecv_ > maxrecv_)
+    {
+        maxrecv_ = nrecv_ + DELTA;
+        memory->destroy(recvtag_);
+        memory->create(recvtag_,maxrecv_,"CfdDatacouplingMPISparse:recvtag_");
+    }
+
+    // tags of received particles
+
+    int *sendtag = (int*) grow_buf(sendbuf_,maxsendbuf_,(nsend_ > 0 ? nsend_ : 1)*sizeof(int));
+    for(int k = 0; k < nsend_; k++)
+        sendtag[k] = tag[sendlist_[k]];
+
+    exchange_sparse<int>(sendtag,sendoffset_,recvtag_,recvoffset_,1);
+}
+
+/* ----------------------------------------------------------------------
+   check if the sub-domains of the calling program form a regular grid
+   as for a regular CFD decomposition, if so set up cut table so that
+   the proc of a position is found by a binary search per dim
+------------------------------------------------------------------------- */
+
+static int compare_double(const void *a, const void *b)
+{
+    double da = *(const double*) a, db = *(const double*) b;
+    if(da < db) return -1;
+    if(da > db) return 1;
+    return 0;
+}
+
+void CfdDatacouplingMPISparse::setup_external_grid()
+{
+    extgrid_ = false;
+
+    // cuts per dim are the unique lower bounds plus the global upper bound
+
+    for(int dim = 0; dim < 3; dim++)
+    {
+        memory->destroy(extcut_[dim]);
+        memory->create(extcut_[dim],nprocs_+1,"CfdDatacouplingMPISparse:extcut_");
+
+        double *cut = extcut_[dim];
+        double hi = exthi_[0][dim];
+        for(int p = 0; p < nprocs_; p++)
+        {
+            cut[p] = extlo_[p][dim];
+            if(exthi_[p][dim] > hi) hi = exthi_[p][dim];
+        }
+        qsort(cut,nprocs_,sizeof(double),compare_double);
+
+        int n = 0;
+        for(int p = 0; p < nprocs_; p++)
+            if(p == 0 || cut[p] != cut[n-1])
+                cut[n++] = cut[p];
+        extn_[dim] = n;
+        cut[n] = hi;
+    }
+
+    if(extn_[0]*extn_[1]*extn_[2] != nprocs_)
+        return;
+
+    // every grid cell has to be the sub-domain of exactly one proc
+
+    memory->destroy(extgridproc_);
+    memory->create(extgridproc_,nprocs_,"CfdDatacouplingMPISparse:extgridproc_");
+    for(int i = 0; i < nprocs_; i++)
+        extgridproc_[i] = -1;
+
+    for(int p = 0; p < nprocs_; p++)
+    {
+        int index[3];
+        for(int dim = 0; dim < 3; dim++)
+        {
+            double *cut = extcut_[dim];
+            double *pos = (double*) bsearch(&extlo_[p][dim],cut,extn_[dim],sizeof(double),compare_double);
+            index[dim] = pos - cut;
+            if(exthi_[p][dim] != cut[index[dim]+1])
+                return;
+        }
+
+        int icell = (index[2]*extn_[1] + index[1])*extn_[0] + index[0];
+        if(extgridproc_[icell] >= 0)
+            return;
+        extgridproc_[icell] = p;
+    }
+
+    extgrid_ = true;
+}
+
+/* ----------------------------------------------------------------------
+   proc of the calling program whose sub-domain contains x, -1 if none
+   uses the cut table for a regular grid of sub-domains, otherwise
+   checks own sub-domain first
+------------------------------------------------------------------------- */
+
+int CfdDatacouplingMPISparse::find_external_proc(double *x)
+{
+    if(extgrid_)
+    {
+        int index[3];
+        for(int dim = 0; dim < 3; dim++)
+        {
+            double *cut = extcut_[dim];
+            int n = extn_[dim];
+            if(x[dim] < cut[0] || x[dim] >= cut[n])
+                return -1;
+
+            // largest i with cut[i] <= x
+            int lo = 0, hi = n-1;
+            while(lo < hi)
+            {
+                int mid = (lo+hi+1)/2;
+                if(cut[mid] <= x[dim]) lo = mid;
+                else hi = mid-1;
+            }
+            index[dim] = lo;
+        }
+        return extgridproc_[(index[2]*extn_[1] + index[1])*extn_[0] + index[0]];
+    }
+
+    for(int i = 0; i < nprocs_; i++)
+    {
+        int p = (me_ + i) % nprocs_;
+        if(x[0] >= extlo_[p][0] && x[0] < exthi_[p][0] &&
+           x[1] >= extlo_[p][1] && x[1] < exthi_[p][1] &&
+           x[2] >= extlo_[p][2] && x[2] < exthi_[p][2])
+            return p;
+    }
+    return -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void* CfdDatacouplingMPISparse::grow_buf(char *&buf,int &maxbuf,int nbytes)
+{
+    if(nbytes > maxbuf)
+    {
+        maxbuf = nbytes;
+        buf = (char*) memory->srealloc(buf,maxbuf,"CfdDatacouplingMPISparse:buf");
+    }
+    return (void*) buf;
+}
+
+/* ---------------------------------------------------------------------- */
+
+bool CfdDatacouplingMPISparse::is_atom_type(char *type)
+{
+    return strcmp(type,"scalar-atom") == 0 || strcmp(type,"vector-atom") == 0;
+}
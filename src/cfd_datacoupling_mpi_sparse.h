@@ -0,0 +1,254 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef CFD_DATACOUPLING_CLASS
+
+   CfdDataCouplingStyle(mpi/sparse,CfdDatacouplingMPISparse)
+
+#else
+
+#ifndef LMP_CFD_DATACOUPLING_MPI_SPARSE_H
+#define LMP_CFD_DATACOUPLING_MPI_SPARSE_H
+
+#include "cfd_datacoupling_mpi.h"
+
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   per-atom data is exchanged only between the proc owning a particle
+   and the proc of the calling program whose sub-domain contains it
+   per-atom arrays of the calling program hold n_external() particles
+   in the order given by external_tags(), this layout is updated once
+   per coupling step
+   multisphere and global data are exchanged as in model 'mpi'
+------------------------------------------------------------------------- */
+
+class CfdDatacouplingMPISparse : public CfdDatacouplingMPI {
+ public:
+  CfdDatacouplingMPISparse(class LAMMPS *, int,int, char **,class FixCfdCoupling*);
+  ~CfdDatacouplingMPISparse();
+
+  void pull(char *,char *,void *&,char *);
+  void push(char *,char *,void *&,char *);
+
+  void allocate_external(int    **&data, int len2,int len1,     int initvalue);
+  void allocate_external(int    **&data, int len2,char *keyword,int initvalue);
+  void allocate_external(double **&data, int len2,int len1,     double initvalue);
+  void allocate_external(double **&data, int len2,char *keyword,double initvalue);
+
+  void set_external_domain(double *lo, double *hi);
+  int n_external();
+  int* external_tags();
+
+ private:
+  template <typename T> void pull_sparse(char *,char *,void *&);
+  template <typename T> void push_sparse(char *,char *,void *&);
+  template <typename T> void exchange_sparse(T *sendbuf,int *sendoffset,
+                                             T *recvbuf,int *recvoffset,int len2);
+
+  void setup_exchange();
+  void setup_external_grid();
+  int find_external_proc(double *x);
+  void register_external(void *olddata,void *data,int len1,int len2);
+  void check_external(void *data,int len2,char *name);
+  void *grow_buf(char *&buf,int &maxbuf,int nbytes);
+
+  bool is_atom_type(char *type);
+
+  int me_,nprocs_;
+
+  // sub-domains of the calling program, one per proc
+  double **extlo_, **exthi_;
+
+  // if the sub-domains form a regular grid, cuts of the grid per dim
+  // and proc of each grid cell, cell (ix,iy,iz) is at (iz*ny+iy)*nx+ix
+  bool extgrid_;
+  int extn_[3];
+  double *extcut_[3];
+  int *extgridproc_;
+
+  // per-atom arrays allocated for the calling program and their size
+  int nextdata_,maxextdata_;
+  void **extdata_;
+  int **extlen_;
+
+  // timestep the exchange pattern was set up
+  bigint setup_step_;
+
+  // particles sent by this proc, local indices grouped by receiving proc
+  // particles of proc p are sendlist_[sendoffset_[p]] ... sendlist_[sendoffset_[p+1]-1]
+  int nsend_,maxsend_;
+  int *sendlist_;
+  int *sendoffset_;
+
+  // particles received by this proc, grouped by sending proc
+  int nrecv_,maxrecv_;
+  int *recvtag_;
+  int *recvoffset_;
+
+  // persistent communication buffers
+  int *sendcount_,*recvcount_;
+  MPI_Request *request_;
+  char *sendbuf_, *recvbuf_;
+  int maxsendbuf_, maxrecvbuf_;
+};
+
+/* ---------------------------------------------------------------------- */
+
+template <typename T>
+void CfdDatacouplingMPISparse::push_sparse(char *name,char *type,void *&to)
+{
+    int len1 = -1, len2 = -1;
+
+    // get reference where to read the data from
+    void * from = find_push_property(name,type,len1,len2);
+
+    if (atom->nlocal && (!from || len1 < 0 || len2 < 0))
+    {
+        if(screen) fprintf(screen,"LIGGGHTS could not find property %s to write data from calling program to.\n",name);
+        lmp->error->one(FLERR,"This is fatal");
+    }
+
+    setup_exchange();
+
+    // procs without particles may not know the data length
+    int len2_all;
+    MPI_Allreduce(&len2,&len2_all,1,MPI_INT,MPI_MAX,world);
+    len2 = len2_all;
+    if(len2 < 1) return;
+
+    check_external(to,len2,name);
+
+    T *sendbuf = (T*) grow_buf(sendbuf_,maxsendbuf_,nsend_*len2*sizeof(T));
+
+    // pack owned particles in send order
+
+    if(strcmp(type,"scalar-atom") == 0)
+    {
+        T *from_t = (T*) from;
+        for (int k = 0; k < nsend_; k++)
+            sendbuf[k] = from_t[sendlist_[k]];
+    }
+    else
+    {
+        T **from_t = (T**) from;
+        for (int k = 0; k < nsend_; k++)
+            for (int j = 0; j < len2; j++)
+                sendbuf[k*len2 + j] = from_t[sendlist_[k]][j];
+    }
+
+    // receive directly into the array of the calling program
+
+    T **to_t = (T**) to;
+    exchange_sparse<T>(sendbuf,sendoffset_,nrecv_ > 0 ? &(to_t[0][0]) : NULL,recvoffset_,len2);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <typename T>
+void CfdDatacouplingMPISparse::pull_sparse(char *name,char *type,void *&from)
+{
+    int len1 = -1, len2 = -1;
+    int nlocal = atom->nlocal;
+
+    // get reference where to write the data
+    void * to = find_pull_property(name,type,len1,len2);
+
+    if (atom->nlocal && (!to || len1 < 0 || len2 < 0))
+    {
+        if(screen) fprintf(screen,"LIGGGHTS could not find property %s to write data from calling program to.\n",name);
+        lmp->error->one(FLERR,"This is fatal");
+    }
+
+    setup_exchange();
+
+    // procs without particles may not know the data length
+    int len2_all;
+    MPI_Allreduce(&len2,&len2_all,1,MPI_INT,MPI_MAX,world);
+    len2 = len2_all;
+    if(len2 < 1) return;
+
+    check_external(from,len2,name);
+
+    // reverse of push: calling program sends back in the order it received
+
+    T *recvbuf = (T*) grow_buf(recvbuf_,maxrecvbuf_,nsend_*len2*sizeof(T));
+    T **from_t = (T**) from;
+    exchange_sparse<T>(nrecv_ > 0 ? &(from_t[0][0]) : NULL,recvoffset_,recvbuf,sendoffset_,len2);
+
+    // particles outside the domain of the calling program get zero
+
+    if(strcmp(type,"scalar-atom") == 0)
+    {
+        T *to_t = (T*) to;
+        for (int i = 0; i < nlocal; i++)
+            to_t[i] = 0;
+        for (int k = 0; k < nsend_; k++)
+            to_t[sendlist_[k]] = recvbuf[k];
+    }
+    else
+    {
+        T **to_t = (T**) to;
+        for (int i = 0; i < nlocal; i++)
+            for (int j = 0; j < len2; j++)
+                to_t[i][j] = 0;
+        for (int k = 0; k < nsend_; k++)
+            for (int j = 0; j < len2; j++)
+                to_t[sendlist_[k]][j] = recvbuf[k*len2 + j];
+    }
+}
+
+/* ----------------------------------------------------------------------
+   point-to-point exchange with procs that have data for this proc
+   block of proc p is at offset[p]*len2 in the send and receive buffer
+------------------------------------------------------------------------- */
+
+template <typename T>
+void CfdDatacouplingMPISparse::exchange_sparse(T *sendbuf,int *sendoffset,
+                                               T *recvbuf,int *recvoffset,int len2)
+{
+    int nrequest = 0;
+
+    for(int p = 0; p < nprocs_; p++)
+    {
+        int n = (recvoffset[p+1]-recvoffset[p])*len2;
+        if(n > 0 && p != me_)
+            MPI_Irecv(&recvbuf[recvoffset[p]*len2],n,mpi_type_dc<T>(),p,0,world,&request_[nrequest++]);
+    }
+
+    for(int p = 0; p < nprocs_; p++)
+    {
+        int n = (sendoffset[p+1]-sendoffset[p])*len2;
+        if(n == 0) continue;
+        if(p == me_)
+            memcpy(&recvbuf[recvoffset[p]*len2],&sendbuf[sendoffset[p]*len2],n*sizeof(T));
+        else
+            MPI_Send(&sendbuf[sendoffset[p]*len2],n,mpi_type_dc<T>(),p,0,world);
+    }
+
+    if(nrequest)
+        MPI_Waitall(nrequest,request_,MPI_STATUSES_IGNORE);
+}
+
+}
+
+#endif
+#endif
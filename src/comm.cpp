@@ -51,6 +51,10 @@
 #include "memory.h"
 #include "fix_insert.h"
 
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
 using namespace LAMMPS_NS;
 
 #define BUFFACTOR 1.5
@@ -92,6 +96,9 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   cutghostuser = 0.0;
   ghost_velocity = 0;
 
+  size_batch = NULL;
+  maxbatch = 0;
+
   // use of OpenMP threads
   // query OpenMP for number of threads/process set by user at run-time
   // need to be in a parallel area for this operation
@@ -154,6 +161,7 @@ Comm::~Comm()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+  memory->destroy(size_batch);
 }
 
 /* ----------------------------------------------------------------------
@@ -1240,6 +1248,130 @@ void Comm::reverse_comm_fix(Fix *fix)
   }
 }
 
+/* ----------------------------------------------------------------------
+   forward communication invoked by several Fixes at once
+   data of all fixes is packed back to back, one message per swap
+------------------------------------------------------------------------- */
+
+void Comm::forward_comm_fix_batch(int nbatch, Fix **fixes)
+{
+  int iswap,ifix,m,n,nsize;
+  double *buf;
+  MPI_Request request;
+  MPI_Status status;
+
+  if (nbatch == 1) {
+    forward_comm_fix(fixes[0]);
+    return;
+  }
+
+  if (nbatch > maxbatch) grow_batch(nbatch);
+
+  // buffers are only sized for the largest single comm in setup()
+
+  nsize = 0;
+  for (ifix = 0; ifix < nbatch; ifix++) nsize += fixes[ifix]->comm_forward;
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+
+    if (nsize*sendnum[iswap] > maxsend) grow_send(nsize*sendnum[iswap],0);
+    if (nsize*recvnum[iswap] > maxrecv) grow_recv(nsize*recvnum[iswap]);
+
+    // pack buffer
+
+    n = m = 0;
+    for (ifix = 0; ifix < nbatch; ifix++) {
+      size_batch[ifix] =
+        fixes[ifix]->pack_comm(sendnum[iswap],sendlist[iswap],&buf_send[m],
+                               pbc_flag[iswap],pbc[iswap]);
+      n += size_batch[ifix];
+      m += size_batch[ifix]*sendnum[iswap];
+    }
+
+    // exchange with another proc
+    // if self, set recv buffer to send buffer
+
+    if (sendproc[iswap] != me) {
+      if (recvnum[iswap])
+        MPI_Irecv(buf_recv,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,
+                  world,&request);
+      if (sendnum[iswap])
+        MPI_Send(buf_send,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,world);
+      if (recvnum[iswap]) MPI_Wait(&request,&status);
+      buf = buf_recv;
+    } else buf = buf_send;
+
+    // unpack buffer
+
+    m = 0;
+    for (ifix = 0; ifix < nbatch; ifix++) {
+      fixes[ifix]->unpack_comm(recvnum[iswap],firstrecv[iswap],&buf[m]);
+      m += size_batch[ifix]*recvnum[iswap];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   reverse communication invoked by several Fixes at once
+   data of all fixes is packed back to back, one message per swap
+------------------------------------------------------------------------- */
+
+void Comm::reverse_comm_fix_batch(int nbatch, Fix **fixes)
+{
+  int iswap,ifix,m,n,nsize;
+  double *buf;
+  MPI_Request request;
+  MPI_Status status;
+
+  if (nbatch == 1) {
+    reverse_comm_fix(fixes[0]);
+    return;
+  }
+
+  if (nbatch > maxbatch) grow_batch(nbatch);
+
+  nsize = 0;
+  for (ifix = 0; ifix < nbatch; ifix++) nsize += fixes[ifix]->comm_reverse;
+
+  for (iswap = nswap-1; iswap >= 0; iswap--) {
+
+    if (nsize*recvnum[iswap] > maxsend) grow_send(nsize*recvnum[iswap],0);
+    if (nsize*sendnum[iswap] > maxrecv) grow_recv(nsize*sendnum[iswap]);
+
+    // pack buffer
+
+    n = m = 0;
+    for (ifix = 0; ifix < nbatch; ifix++) {
+      size_batch[ifix] =
+        fixes[ifix]->pack_reverse_comm(recvnum[iswap],firstrecv[iswap],
+                                       &buf_send[m]);
+      n += size_batch[ifix];
+      m += size_batch[ifix]*recvnum[iswap];
+    }
+
+    // exchange with another proc
+    // if self, set recv buffer to send buffer
+
+    if (sendproc[iswap] != me) {
+      if (sendnum[iswap])
+        MPI_Irecv(buf_recv,n*sendnum[iswap],MPI_DOUBLE,sendproc[iswap],0,
+                  world,&request);
+      if (recvnum[iswap])
+        MPI_Send(buf_send,n*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,world);
+      if (sendnum[iswap]) MPI_Wait(&request,&status);
+      buf = buf_recv;
+    } else buf = buf_send;
+
+    // unpack buffer
+
+    m = 0;
+    for (ifix = 0; ifix < nbatch; ifix++) {
+      fixes[ifix]->unpack_reverse_comm(sendnum[iswap],sendlist[iswap],&buf[m]);
+      m += size_batch[ifix]*sendnum[iswap];
+    }
+  }
+}
+
 /* ----------------------------------------------------------------------
    forward communication invoked by a Compute
 ------------------------------------------------------------------------- */
@@ -1414,6 +1546,17 @@ void Comm::grow_recv(int n)
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 }
 
+/* ----------------------------------------------------------------------
+   realloc the per-fix sizes of a batched comm
+------------------------------------------------------------------------- */
+
+void Comm::grow_batch(int n)
+{
+  maxbatch = n;
+  memory->destroy(size_batch);
+  memory->create(size_batch,maxbatch,"comm:size_batch");
+}
+
 /* ----------------------------------------------------------------------
    realloc the size of the iswap sendlist as needed with BUFFACTOR
 ------------------------------------------------------------------------- */
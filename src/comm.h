@@ -63,6 +63,10 @@ class Comm : protected Pointers {
   virtual void reverse_comm_pair(class Pair *);    // reverse comm from a Pair
   virtual void forward_comm_fix(class Fix *);      // forward comm from a Fix
   virtual void reverse_comm_fix(class Fix *);      // reverse comm from a Fix
+  virtual void forward_comm_fix_batch(int, class Fix **); // forward comm
+                                                          // from several Fixes
+  virtual void reverse_comm_fix_batch(int, class Fix **); // reverse comm
+                                                          // from several Fixes
   virtual void forward_comm_compute(class Compute *);  // forward from a Compute
   virtual void reverse_comm_compute(class Compute *);  // reverse from a Compute
   virtual void forward_comm_dump(class Dump *);    // forward comm from a Dump
@@ -119,12 +123,15 @@ class Comm : protected Pointers {
   double *buf_recv;                 // recv buffer for all comm
   int maxsend,maxrecv;              // current size of send/recv buffer
   int maxforward,maxreverse;        // max # of datums in forward/reverse comm
+  int *size_batch;                  // per-atom # of datums of each batched Fix
+  int maxbatch;                     // current size of size_batch
 
   int updown(int, int, int, double, int, double *);
                                             // compare cutoff to procs
   virtual void grow_send(int,int);          // reallocate send buffer
   virtual void grow_recv(int);              // free/allocate recv buffer
   virtual void grow_list(int, int);         // reallocate one sendlist
+  void grow_batch(int);                     // reallocate size_batch
   virtual void grow_swap(int);              // grow swap and multi arrays
   virtual void allocate_swap(int);          // allocate swap arrays
   virtual void allocate_multi(int);         // allocate multi arrays
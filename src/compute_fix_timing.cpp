@@ -0,0 +1,106 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "string.h"
+#include "compute_fix_timing.h"
+#include "update.h"
+#include "modify.h"
+#include "memory.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+// columns: total time ave/min/max over procs, then ave per phase
+
+#define NCOL (Modify::FIXTIME_N+3)
+
+/* ---------------------------------------------------------------------- */
+
+ComputeFixTiming::ComputeFixTiming(LAMMPS *lmp, int narg, char **arg) :
+  Compute(lmp, narg, arg)
+{
+  if (narg < 4) error->all(FLERR,"Illegal compute fix/timing command");
+
+  array_flag = 1;
+  size_array_cols = NCOL;
+  extarray = 0;
+
+  nids = narg-3;
+  ids = new char*[nids];
+  for (int i = 0; i < nids; i++) {
+    int n = strlen(arg[3+i]) + 1;
+    ids[i] = new char[n];
+    strcpy(ids[i],arg[3+i]);
+  }
+  size_array_rows = nids;
+
+  memory->create(array,nids,NCOL,"fix/timing:array");
+}
+
+/* ---------------------------------------------------------------------- */
+
+ComputeFixTiming::~ComputeFixTiming()
+{
+  for (int i = 0; i < nids; i++) delete [] ids[i];
+  delete [] ids;
+  memory->destroy(array);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeFixTiming::init()
+{
+  for (int i = 0; i < nids; i++)
+    if (modify->find_fix(ids[i]) < 0)
+      error->all(FLERR,"Could not find compute fix/timing fix ID");
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeFixTiming::compute_array()
+{
+  invoked_array = update->ntimestep;
+
+  int nfix = modify->nfix;
+  int ncol = Modify::FIXTIME_N+1;
+  double *ave = new double[nfix*ncol];
+  double *min = new double[nfix*ncol];
+  double *max = new double[nfix*ncol];
+  modify->fix_time_stats(ave,min,max);
+
+  // look up fixes each time, fixes may be added or deleted after init()
+
+  for (int i = 0; i < nids; i++) {
+    int ifix = modify->find_fix(ids[i]);
+    if (ifix < 0) error->all(FLERR,"Could not find compute fix/timing fix ID");
+    int m = ifix*ncol;
+    array[i][0] = ave[m+Modify::FIXTIME_N];
+    array[i][1] = min[m+Modify::FIXTIME_N];
+    array[i][2] = max[m+Modify::FIXTIME_N];
+    for (int j = 0; j < Modify::FIXTIME_N; j++) array[i][3+j] = ave[m+j];
+  }
+
+  delete [] ave;
+  delete [] min;
+  delete [] max;
+}
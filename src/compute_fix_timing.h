@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMPUTE_CLASS
+
+ComputeStyle(fix/timing,ComputeFixTiming)
+
+#else
+
+#ifndef LMP_COMPUTE_FIX_TIMING_H
+#define LMP_COMPUTE_FIX_TIMING_H
+
+#include "compute.h"
+
+namespace LAMMPS_NS {
+
+class ComputeFixTiming : public Compute {
+ public:
+  ComputeFixTiming(class LAMMPS *, int, char **);
+  ~ComputeFixTiming();
+  void init();
+  void compute_array();
+
+ private:
+  int nids;
+  char **ids;        // fix IDs, one row each
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+E: Could not find compute fix/timing fix ID
+
+Self-explanatory.
+
+*/
@@ -55,6 +55,11 @@ ComputePairGranLocal::ComputePairGranLocal(LAMMPS *lmp, int narg, char **arg) :
   nmax = 0;
   array = NULL;
 
+  // store the output steps, contacts are recorded by the force pass then
+  timeflag = 1;
+  capture_step = -1;
+  ipair = iheat = 0;
+
   // store everything by default expect heat flux
   posflag = idflag = fflag = tflag = hflag = aflag = 1;
 
@@ -247,6 +252,15 @@ void ComputePairGranLocal::compute_local()
 
   if(!reference_exists) error->one(FLERR,"Compute pair/gran/local or wall/gran/local reference does no longer exist (pair or fix deleted)");
 
+  // contacts already recorded in the force pass of this step
+
+  if(capture_step == update->ntimestep)
+  {
+      ncount = ipair;
+      size_local_rows = ncount;
+      return;
+  }
+
   // count local entries and compute pair info
 
   if(wall == 0) ncount = count_pairs();        // # pairs is ensured to be the same for pair and heat
@@ -265,7 +279,7 @@ void ComputePairGranLocal::compute_local()
       // get heat flux data
       if(fixheat)
       {
-          ipair = 0;
+          iheat = 0;
           fixheat->cpl_evaluate(this);
       }
   }
@@ -278,6 +292,30 @@ void ComputePairGranLocal::compute_local()
   }
 }
 
+/* ----------------------------------------------------------------------
+   called by pair or wall before the force pass
+   if this compute is due on this step, the force pass hands its
+   contacts over via add_pair() or add_wall_1() / add_wall_2()
+------------------------------------------------------------------------- */
+
+bool ComputePairGranLocal::begin_capture()
+{
+  if(!matchstep(update->ntimestep)) return false;
+
+  ipair = iheat = 0;
+  capture_step = update->ntimestep;
+  return true;
+}
+
+/* ----------------------------------------------------------------------
+   true if contacts are being recorded on this step
+------------------------------------------------------------------------- */
+
+bool ComputePairGranLocal::capturing()
+{
+  return capture_step == update->ntimestep;
+}
+
 /* ----------------------------------------------------------------------
    count pairs on this proc
 ------------------------------------------------------------------------- */
@@ -365,6 +403,8 @@ void ComputePairGranLocal::add_pair(int i,int j,double fx,double fy,double fz,do
 
     if (newton_pair == 0 && j >= nlocal && atom->tag[i] <= atom->tag[j]) return;
 
+    if (ipair == nmax) grow_capture();
+
     xi = atom->x[i];
     xj = atom->x[j];
 
@@ -428,18 +468,19 @@ void ComputePairGranLocal::add_pair(int i,int j,double fx,double fy,double fz,do
 
 void ComputePairGranLocal::add_heat(int i,int j,double hf)
 {
+    // same selection as add_pair() so rows match
+    if (!(atom->mask[i] & groupbit)) return;
+    if (!(atom->mask[j] & groupbit)) return;
+
     if (newton_pair == 0 && j >= atom->nlocal && atom->tag[i] <= atom->tag[j]) return;
 
-    if(hfflag)
-    {
-        // heat flux is always last value
-        array[ipair][nvalues-1] = hf;
-        
-    }
-    else error->one(FLERR,"Illegal situation in ComputePairGranLocal::add_heat");
+    if(!hfflag) error->one(FLERR,"Illegal situation in ComputePairGranLocal::add_heat");
 
-    // inc counter again, since reset in compute_local() after getting pair data
-    ipair++;
+    // one heat flux per recorded pair, heat flux is always last value
+    if(iheat >= ipair) error->one(FLERR,"Illegal situation in ComputePairGranLocal::add_heat: more heat fluxes than pairs");
+    array[iheat][nvalues-1] = hf;
+
+    iheat++;
 }
 
 /* ----------------------------------------------------------------------
@@ -450,6 +491,8 @@ void ComputePairGranLocal::add_wall_1(int iFMG,int idTri,int iP,double *contact_
 {
     if (!(atom->mask[iP] & groupbit)) return;
 
+    if (ipair == nmax) grow_capture();
+
     int n = 0;
 
     if(posflag)
@@ -550,6 +593,17 @@ void ComputePairGranLocal::reallocate(int n)
   array_local = array;
 }
 
+/* ----------------------------------------------------------------------
+   grow array while contacts are added, keeps the rows added so far
+------------------------------------------------------------------------- */
+
+void ComputePairGranLocal::grow_capture()
+{
+  nmax += DELTA;
+  memory->grow(array,nmax,nvalues,"pair/local:array");
+  array_local = array;
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local data
 ------------------------------------------------------------------------- */
@@ -51,6 +51,10 @@ class ComputePairGranLocal : public Compute {
   void add_wall_2(int i,double fx,double fy,double fz,double tor1,double tor2,double tor3,double *hist,double rsq);
   void add_heat_wall(int i,double hf);
 
+  // record contacts during the regular force pass on output steps
+  bool begin_capture();
+  bool capturing();
+
  private:
   int nvalues;
   int ncount;
@@ -69,7 +73,10 @@ class ComputePairGranLocal : public Compute {
   class FixHeatGranCond *fixheat;
   class FixWallGran *fixwall;
 
-  int ipair;
+  int ipair,iheat;
+
+  // time-step contacts were last recorded in the force pass
+  bigint capture_step;
 
   int posflag,idflag,fflag,tflag,hflag,aflag,hfflag;
 
@@ -84,6 +91,7 @@ class ComputePairGranLocal : public Compute {
   int count_pairs();
   int count_wallcontacts();
   void reallocate(int);
+  void grow_capture();
 };
 
 }
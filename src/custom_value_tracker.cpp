@@ -144,6 +144,31 @@ using namespace LAMMPS_NS;
       globalProperties_.move(vecIncremental);
   }
 
+  /* ----------------------------------------------------------------------
+   move or rotate only per-element or only global properties
+   used for moving mesh in rigid frame
+  ------------------------------------------------------------------------- */
+
+  void CustomValueTracker::moveElements(double *vecIncremental)
+  {
+      elementProperties_.move(vecIncremental);
+  }
+
+  void CustomValueTracker::rotateElements(double *dQ)
+  {
+      elementProperties_.rotate(dQ);
+  }
+
+  void CustomValueTracker::moveGlobal(double *vecTotal)
+  {
+      globalProperties_.move(vecTotal);
+  }
+
+  void CustomValueTracker::rotateGlobal(double *totalQ)
+  {
+      globalProperties_.rotate(totalQ);
+  }
+
   /* ----------------------------------------------------------------------
    clear reverse properties, i.e. reset all of them to 0
   ------------------------------------------------------------------------- */
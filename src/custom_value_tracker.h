@@ -91,6 +91,12 @@ namespace LAMMPS_NS
         void rotate(double *dQ);
         void scale(double factor);
 
+        // per-element or global properties only
+        void moveElements(double *vecIncremental);
+        void rotateElements(double *dQ);
+        void moveGlobal(double *vecTotal);
+        void rotateGlobal(double *totalQ);
+
         // buffer operations
 
         inline int elemListBufSize(int n,int operation,bool scale,bool translate,bool rotate);
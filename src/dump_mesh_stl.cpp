@@ -209,6 +209,9 @@ int DumpMeshSTL::count()
 
   for(int imesh = 0; imesh < nMesh_; imesh++)
   {
+      // bring moving mesh in rigid frame to current pos
+      meshList_[imesh]->updateRigidFrame();
+
       bounds(imesh,ilo,ihi);
       if(iregion_ == -1)
       {
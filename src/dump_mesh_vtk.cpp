@@ -376,6 +376,9 @@ int DumpMeshVTK::count()
 
   for(int i = 0; i < nMesh_; i++)
   {
+    // bring moving mesh in rigid frame to current pos
+    meshList_[i]->updateRigidFrame();
+
     if(!meshList_[i]->isParallel() && 0 != comm->me)
         continue;
     numTri += meshList_[i]->sizeLocal();
@@ -28,6 +28,8 @@
 #include "neigh_list.h"
 #include "neigh_request.h"
 #include "output.h"
+#include "modify.h"
+#include "fix.h"
 #include "memory.h"
 
 using namespace LAMMPS_NS;
@@ -415,6 +417,10 @@ void Finish::end(int flag)
     }
   }
 
+  // per-fix timing, part of the breakdown above
+
+  if (timeflag) fix_timing(time_loop);
+
   // FFT timing statistics
   // time3d,time1d = total time during run for 3d and 1d FFTs
   // time_kspace may be 0.0 if another partition is doing Kspace
@@ -633,6 +639,56 @@ void Finish::end(int flag)
   if (logfile) fflush(logfile);
 }
 
+/* ----------------------------------------------------------------------
+   print wall time spent in each fix per timestep phase
+   ave/min/max over procs, only fixes and phases with non-zero time
+------------------------------------------------------------------------- */
+
+void Finish::fix_timing(double time_loop)
+{
+  const char *phase[Modify::FIXTIME_N] =
+    {"initial_integrate","post_integrate","pre_exchange","pre_neighbor",
+     "pre_force","post_force","final_integrate","end_of_step"};
+
+  int nfix = modify->nfix;
+  if (nfix == 0) return;
+
+  int ncol = Modify::FIXTIME_N+1;
+  double *ave = new double[nfix*ncol];
+  double *min = new double[nfix*ncol];
+  double *max = new double[nfix*ncol];
+  modify->fix_time_stats(ave,min,max);
+
+  int me = comm->me;
+  if (me == 0) {
+    FILE *fp;
+    for (int k = 0; k < 2; k++) {
+      fp = k ? logfile : screen;
+      if (!fp) continue;
+
+      fprintf(fp,"\nFix timing (ave min max over procs, %% of loop time):\n");
+      for (int i = 0; i < nfix; i++) {
+        double *a = &ave[i*ncol];
+        if (max[i*ncol+Modify::FIXTIME_N] == 0.0) continue;
+        Fix *f = modify->fix[i];
+        fprintf(fp,"Fix %s (%s) = %g ave %g min %g max (%g)\n",
+                f->id,f->style,a[Modify::FIXTIME_N],min[i*ncol+Modify::FIXTIME_N],
+                max[i*ncol+Modify::FIXTIME_N],a[Modify::FIXTIME_N]/time_loop*100.0);
+        for (int j = 0; j < Modify::FIXTIME_N; j++) {
+          if (max[i*ncol+j] == 0.0) continue;
+          fprintf(fp,"  %-17s = %g ave %g min %g max (%g)\n",
+                  phase[j],a[j],min[i*ncol+j],max[i*ncol+j],
+                  a[j]/time_loop*100.0);
+        }
+      }
+    }
+  }
+
+  delete [] ave;
+  delete [] min;
+  delete [] max;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void Finish::stats(int n, double *data,
@@ -41,6 +41,8 @@
 
 #define INVOKED_PERATOM 8
 
+#define NSUM 17
+
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
@@ -54,21 +56,22 @@ FixAveEuler::FixAveEuler(LAMMPS *lmp, int narg, char **arg) :
   cell_size_ideal_(0.),
   ncells_(0),
   ncells_max_(0),
-  ncellptr_max_(0),
-  cellhead_(NULL),
-  cellptr_(NULL),
+  running_average_(false),
+  nsample_(0),
   center_(NULL),
   v_av_(NULL),
   vol_fr_(NULL),
   mass_(NULL),
   stress_(NULL),
+  ncount_(NULL),
+  sum_(NULL),
   compute_stress_(NULL)
 {
   // this fix produces a global array
 
   array_flag = 1;
   size_array_rows = BIG;
-  size_array_cols = 3 + 1 + 3;
+  size_array_cols = 3 + 1 + 3 + 7;
 
   triclinic_ = domain->triclinic;  
 
@@ -82,6 +85,7 @@ FixAveEuler::FixAveEuler(LAMMPS *lmp, int narg, char **arg) :
   if(exec_every_ < 1)
     error->fix_error(FLERR,this,"'nevery' > 0 required");
   nevery = exec_every_;
+  global_freq = nevery;
 
   if(strcmp(arg[iarg++],"cell_size_relative"))
     error->fix_error(FLERR,this,"expecting keyword 'cell_size_relative'");
@@ -89,25 +93,34 @@ FixAveEuler::FixAveEuler(LAMMPS *lmp, int narg, char **arg) :
   if(cell_size_ideal_rel_ < 3.)
     error->fix_error(FLERR,this,"'cell_size_relative' > 3 required");
 
-  // add nfirst to all computes that store invocation times
-  // since don't know a priori which are invoked via variables by this fix
-  // once in end_of_step() can set timestep for ones actually invoked
+  if(iarg < narg)
+  {
+      if(strcmp(arg[iarg++],"running_average"))
+        error->fix_error(FLERR,this,"expecting keyword 'running_average'");
+      if(iarg >= narg)
+        error->fix_error(FLERR,this,"not enough arguments for 'running_average'");
+      if(strcmp(arg[iarg],"yes") == 0)
+        running_average_ = true;
+      else if(strcmp(arg[iarg],"no") == 0)
+        running_average_ = false;
+      else
+        error->fix_error(FLERR,this,"expecting 'yes' or 'no' for 'running_average'");
+      iarg++;
+  }
 
-  int nfirst = (update->ntimestep/nevery)*nevery + nevery;
-  modify->addstep_compute_all(nfirst);
 }
 
 /* ---------------------------------------------------------------------- */
 
 FixAveEuler::~FixAveEuler()
 {
-  memory->destroy(cellhead_);
-  memory->destroy(cellptr_);
   memory->destroy(center_);
   memory->destroy(v_av_);
   memory->destroy(vol_fr_);
   memory->destroy(mass_);
   memory->destroy(stress_);
+  memory->destroy(ncount_);
+  memory->destroy(sum_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -160,6 +173,23 @@ void FixAveEuler::init()
 void FixAveEuler::setup(int vflag)
 {
     setup_bins();
+    nsample_ = 0;
+
+    // no values before first sample
+    for(int icell = 0; icell < ncells_; icell++)
+    {
+        vectorZeroize3D(v_av_[icell]);
+        vol_fr_[icell] = 0.;
+        mass_[icell] = 0.;
+        vectorZeroizeN(stress_[icell],7);
+    }
+
+    // add nfirst to all computes that store invocation times
+    // done here since stress compute is created after the constructor
+    // once in end_of_step() can set timestep for ones actually invoked
+
+    int nfirst = (update->ntimestep/nevery)*nevery + nevery;
+    modify->addstep_compute_all(nfirst);
     //end_of_step();
 }
 
@@ -242,14 +272,16 @@ void FixAveEuler::setup_bins()
     if (ncells_ > ncells_max_)
     {
         ncells_max_ = ncells_;
-        memory->grow(cellhead_,ncells_max_,"ave/euler:cellhead_");
         memory->grow(center_,ncells_max_,3,"ave/euler:center_");
         memory->grow(v_av_,  ncells_max_,3,"ave/euler:v_av_");
         memory->grow(vol_fr_,ncells_max_,  "ave/euler:vol_fr_");
         memory->grow(mass_,ncells_max_,  "ave/euler:mass_");
         memory->grow(stress_,ncells_max_,7,"ave/euler:stress_");
+        memory->grow(ncount_,ncells_max_,"ave/euler:ncount_");
+        memory->grow(sum_,ncells_max_,NSUM,"ave/euler:sum_");
     }
 
+
     // calculate center corrdinates for cells
     for(int ix = 0; ix < ncells_dim_[0]; ix++)
     {
@@ -292,59 +324,24 @@ void FixAveEuler::end_of_step()
 {
     
     // have to adapt grid if box changes
+    // a running average starts over if the cell layout changes
     if(box_change_)
+    {
+        int ncells_dim_old[3];
+        vectorCopy3D(ncells_dim_,ncells_dim_old);
         setup_bins();
-
-    // bin atoms
-    bin_atoms();
+        if(ncells_dim_[0] != ncells_dim_old[0] || ncells_dim_[1] != ncells_dim_old[1] ||
+           ncells_dim_[2] != ncells_dim_old[2])
+            nsample_ = 0;
+    }
 
     // calculate Eulerian grid properties
     calculate_eu();
 }
 
 /* ----------------------------------------------------------------------
-   bin owned and ghost atoms
-   this also implies we do not need to wrap around PBCs
-   bin ghost atoms only if inside my grid
-------------------------------------------------------------------------- */
-
-void FixAveEuler::bin_atoms()
-{
-  int i,ibin;
-  double **x = atom->x;
-  int nall = atom->nlocal + atom->nghost;
-
-  for (i = 0; i < ncells_max_; i++)
-    cellhead_[i] = -1;
-
-  // re-alloc cellptr_ if necessary
-  if(nall > ncellptr_max_)
-  {
-      ncellptr_max_ = nall;
-      memory->grow(cellptr_,ncellptr_max_,"ave/pic:cellptr_");
-  }
-
-  // bin in reverse order so linked list will be in forward order
-  // also puts ghost atoms at end of list
-
-  for (i = nall-1; i >= 0; i--)
-  {
-    ibin = coord2bin(x[i]);
-
-      // ghosts outside grid may return values ibin < 0 || ibin >= ncells_
-      // lets ignore them
-      if (ibin < 0 || ibin >= ncells_) {
-        
-        continue;
-      }
-
-      cellptr_[i] = cellhead_[ibin];
-      cellhead_[ibin] = i;
-  }
-}
-
-/* ----------------------------------------------------------------------
-   map coord to grid, also return ix,iy,iz indices in each dim
+   map coord to grid
+   return -1 if outside my grid, e.g. for ghosts
 ------------------------------------------------------------------------- */
 
 inline int FixAveEuler::coord2bin(double *x)
@@ -357,12 +354,16 @@ inline int FixAveEuler::coord2bin(double *x)
     domain->x2lamda(x,tmp_x);
     for (i=0;i<3;i++) {
       float_iCell[i] = (tmp_x[i]-lo_lamda_[i])*cell_size_lamda_inv_[i];
-      iCell[i] = static_cast<int> (float_iCell[i] >= 0 ? float_iCell[i] : float_iCell[i]-1);
+      if (float_iCell[i] < 0.) return -1;
+      iCell[i] = static_cast<int> (float_iCell[i]);
+      if (iCell[i] >= ncells_dim_[i]) return -1;
     }
   } else {
     for (i=0;i<3;i++) {
       float_iCell[i] = (x[i]-lo_[i])*cell_size_inv_[i];
-      iCell[i] = static_cast<int> (float_iCell[i] >= 0 ? float_iCell[i] : float_iCell[i]-1);
+      if (float_iCell[i] < 0.) return -1;
+      iCell[i] = static_cast<int> (float_iCell[i]);
+      if (iCell[i] >= ncells_dim_[i]) return -1;
     }
   }
 
@@ -370,19 +371,25 @@ inline int FixAveEuler::coord2bin(double *x)
 }
 
 /* ----------------------------------------------------------------------
-   calculate Eulerian data, use interpolation function
+   calculate Eulerian data
+   one streaming pass over owned and ghost atoms in memory order sums up
+   all per-cell quantities, so no per-cell atom lists are needed
+   ghost atoms are included only if inside my grid
+   the velocity fluctuation part of the stress is recovered from the
+   sums of m*v and m*v*v once the cell velocity is known
 ------------------------------------------------------------------------- */
 
 void FixAveEuler::calculate_eu()
 {
-    int ncount;
+    int icell;
+    double **x = atom->x;
     double **v = atom->v;
     double *radius = atom->radius;
     double *rmass = atom->rmass;
+    int nall = atom->nlocal + atom->nghost;
 
     double prefactor_vol_fr = 4./3.*M_PI/cell_volume_;
     double prefactor_stress = 1./cell_volume_;
-    double vel_x_mass[3];
 
     // wrap compute with clear/add
     modify->clearstep_compute();
@@ -397,48 +404,96 @@ void FixAveEuler::calculate_eu()
     // need to get pointer here since compute_peratom() may realloc
     double **stress_atom = compute_stress_->array_atom;
 
-    // loop all binned particles
-    // each particle can contribute to the cell that it has been binned
-    // to plus its 26 neighs
+    for(icell = 0; icell < ncells_; icell++)
+    {
+        ncount_[icell] = 0;
+        vectorZeroizeN(sum_[icell],NSUM);
+    }
 
-    for(int icell = 0; icell < ncells_; icell++)
+    // add contributions of particles
+    // v is favre-averaged (mass-averaged)
+    // stress is molecular diffusion + contact forces
+
+    double m,*vi,*si,*sum;
+    for(int i = 0; i < nall; i++)
     {
-        ncount = 0;
-        vectorZeroize3D(v_av_[icell]);
-        vol_fr_[icell] = 0.;
-        mass_[icell] = 0.;
-        vectorZeroizeN(stress_[icell],7);
+        icell = coord2bin(x[i]);
+        if(icell < 0) continue;
+
+        m = rmass[i];
+        vi = v[i];
+        si = stress_atom[i];
+        sum = sum_[icell];
+
+        ncount_[icell]++;
+
+        sum[0] += m*vi[0];
+        sum[1] += m*vi[1];
+        sum[2] += m*vi[2];
+
+        sum[3] += m*vi[0]*vi[0];
+        sum[4] += m*vi[1]*vi[1];
+        sum[5] += m*vi[2]*vi[2];
+        sum[6] += m*vi[0]*vi[1];
+        sum[7] += m*vi[0]*vi[2];
+        sum[8] += m*vi[1]*vi[2];
+
+        sum[9] += si[0];
+        sum[10] += si[1];
+        sum[11] += si[2];
+        sum[12] += si[3];
+        sum[13] += si[4];
+        sum[14] += si[5];
+
+        sum[15] += radius[i]*radius[i]*radius[i];
+        sum[16] += m;
+    }
 
-        // add contributions of particle - v and volume fraction
-        // v is favre-averaged (mass-averaged)
+    // per-cell values of this sample
+    // sum of m*(va-Va)*(vb-Vb) = mvv_ab - Va*mv_b - Vb*mv_a + Va*Vb*mass
+    // running average keeps the values of previous samples
 
-        for(int iatom = cellhead_[icell/*+stencil*/]; iatom >= 0; iatom = cellptr_[iatom])
-        {
-            vectorScalarMult3D(v[iatom],rmass[iatom],vel_x_mass);
-            vectorAdd3D(v_av_[icell],vel_x_mass,v_av_[icell]);
-            vol_fr_[icell] += radius[iatom]*radius[iatom]*radius[iatom];
-            mass_[icell] += rmass[iatom];
-            ncount++;
-        }
+    nsample_++;
+    bool average = running_average_ && nsample_ > 1;
+    double weight = 1./static_cast<double>(nsample_);
+
+    double vc[3],volc,sc[7];
+    const int ia[6] = {0,1,2,0,0,1};
+    const int ib[6] = {0,1,2,1,2,2};
 
-        if(ncount) vectorScalarDiv3D(v_av_[icell],static_cast<double>(ncount)*mass_[icell]);
-        vol_fr_[icell] *= prefactor_vol_fr;
+    for(icell = 0; icell < ncells_; icell++)
+    {
+        sum = sum_[icell];
+        mass_[icell] = sum[16];
 
-        // add contribution of particle - stress
-        // need v before can calculate stress
-        // stress is molecular diffusion + contact forces
+        vectorZeroize3D(vc);
+        if(ncount_[icell])
+            vectorScalarDiv3D(sum,static_cast<double>(ncount_[icell])*mass_[icell],vc);
 
-        for(int iatom = cellhead_[icell/*+stencil*/]; iatom >= 0; iatom = cellptr_[iatom])
+        volc = sum[15]*prefactor_vol_fr;
+
+        for(int k = 0; k < 6; k++)
+        {
+            int a = ia[k], b = ib[k];
+            sc[k+1] = -(sum[3+k] - vc[a]*sum[b] - vc[b]*sum[a] + vc[a]*vc[b]*mass_[icell]) + sum[9+k];
+        }
+        sc[0] = -0.333333333333333*(sc[1]+sc[2]+sc[3]);
+        vectorScalarMultN(7,sc,prefactor_stress);
+
+        if(average)
+        {
+            for(int k = 0; k < 3; k++)
+                v_av_[icell][k] += weight*(vc[k]-v_av_[icell][k]);
+            vol_fr_[icell] += weight*(volc-vol_fr_[icell]);
+            for(int k = 0; k < 7; k++)
+                stress_[icell][k] += weight*(sc[k]-stress_[icell][k]);
+        }
+        else
         {
-            stress_[icell][1] += -rmass[iatom]*(v[iatom][0]-v_av_[icell][0])*(v[iatom][0]-v_av_[icell][0]) + stress_atom[iatom][0];
-            stress_[icell][2] += -rmass[iatom]*(v[iatom][1]-v_av_[icell][1])*(v[iatom][1]-v_av_[icell][1]) + stress_atom[iatom][1];
-            stress_[icell][3] += -rmass[iatom]*(v[iatom][2]-v_av_[icell][2])*(v[iatom][2]-v_av_[icell][2]) + stress_atom[iatom][2];
-            stress_[icell][4] += -rmass[iatom]*(v[iatom][0]-v_av_[icell][0])*(v[iatom][1]-v_av_[icell][1]) + stress_atom[iatom][3];
-            stress_[icell][5] += -rmass[iatom]*(v[iatom][0]-v_av_[icell][0])*(v[iatom][2]-v_av_[icell][2]) + stress_atom[iatom][4];
-            stress_[icell][6] += -rmass[iatom]*(v[iatom][1]-v_av_[icell][1])*(v[iatom][2]-v_av_[icell][2]) + stress_atom[iatom][5]; 
-            stress_[icell][0] = -0.333333333333333*(stress_[icell][1]+stress_[icell][2]+stress_[icell][3]);
+            vectorCopy3D(vc,v_av_[icell]);
+            vol_fr_[icell] = volc;
+            vectorCopyN(sc,stress_[icell],7);
         }
-        vectorScalarMultN(7,stress_[icell],prefactor_stress);
     }
 
     // wrap with clear/add
@@ -460,6 +515,6 @@ double FixAveEuler::compute_array(int i, int j)
   else if(j == 3) return vol_fr_[i];
   else if(j < 7) return v_av_[i][j-4];
   else if(j == 7) return stress_[i][0];
-  else if(j < 14) return stress_[i][j-8];
+  else if(j < 14) return stress_[i][j-7];
   else return 0.0;
 }
@@ -78,7 +78,6 @@ class FixAveEuler : public Fix {
  private:
 
   void setup_bins();
-  void bin_atoms();
   void calculate_eu();
   inline int coord2bin(double *x); 
 
@@ -107,15 +106,12 @@ class FixAveEuler : public Fix {
   double cell_size_lamda_[3]; 
   double cell_size_lamda_inv_[3]; 
 
-  // length of cellhead_, center_, v_av_, vol_fr_ arrays
+  // length of center_, v_av_, vol_fr_ arrays
   int ncells_max_;
 
-  // length of cellptr_ array
-  int ncellptr_max_;
-
-  // atom - cell mapping
-  int *cellhead_;    // ptr to 1st atom in each cell
-  int *cellptr_;       // ptr to next atom in each bin
+  // running average over all samples of a run
+  bool running_average_;
+  int nsample_;
 
   /* ---------  DATA  --------- */
 
@@ -137,6 +133,15 @@ class FixAveEuler : public Fix {
   // [4-6]: 01-02-12
   double **stress_;
 
+  // per-cell sums accumulated in one pass over the atoms
+  // [0-2]: m*v
+  // [3-8]: m*v*v, 00-11-22-01-02-12
+  // [9-14]: per-atom stress
+  // [15]: r^3
+  // [16]: m
+  int *ncount_;
+  double **sum_;
+
   // stress computation
   class ComputeStressAtom *compute_stress_;
 };
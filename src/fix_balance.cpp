@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "string.h"
+#include "fix_balance.h"
+#include "balance.h"
+#include "update.h"
+#include "atom.h"
+#include "domain.h"
+#include "force.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg)
+{
+  if (narg < 9) error->all(FLERR,"Illegal fix balance command");
+
+  box_change = 1;
+  scalar_flag = 1;
+  extscalar = 0;
+  vector_flag = 1;
+  size_vector = 3;
+  extvector = 0;
+  global_freq = 1;
+
+  // parse arguments
+
+  nevery = force->inumeric(arg[3]);
+  if (nevery < 0) error->all(FLERR,"Illegal fix balance command");
+  thresh = force->numeric(arg[4]);
+  if (thresh < 1.0) error->all(FLERR,"Illegal fix balance command");
+  if (strcmp(arg[5],"shift") != 0)
+    error->all(FLERR,"Illegal fix balance command");
+
+  balance = new Balance(lmp);
+  balance->shift_setup(arg[6],force->inumeric(arg[7]),force->numeric(arg[8]));
+
+  int iarg = 9;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"weight") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix balance command");
+      balance->weight_setup(arg[iarg+1]);
+      iarg += 2;
+    } else error->all(FLERR,"Illegal fix balance command");
+  }
+
+  // rebalancing is done in pre_exchange on reneighboring steps
+  // new sub-domains require comm and neighbor setup, hence box_change
+
+  force_reneighbor = 1;
+  next_reneighbor = -1;
+  lastbalance = -1;
+
+  imbnow = imbprev = imbfinal = maxloadperproc = 0.0;
+  itercount = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixBalance::~FixBalance()
+{
+  delete balance;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixBalance::setmask()
+{
+  int mask = 0;
+  mask |= PRE_EXCHANGE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixBalance::init()
+{
+  // timers are reset at start of run
+
+  balance->reset_time();
+}
+
+/* ----------------------------------------------------------------------
+   rebalance at start of run, no timing is available yet
+------------------------------------------------------------------------- */
+
+void FixBalance::setup_pre_exchange()
+{
+  rebalance(0);
+
+  if (nevery) next_reneighbor = (update->ntimestep/nevery)*nevery + nevery;
+}
+
+/* ----------------------------------------------------------------------
+   rebalance every nevery steps, reneighboring is forced on these steps
+------------------------------------------------------------------------- */
+
+void FixBalance::pre_exchange()
+{
+  if (nevery == 0 || update->ntimestep < next_reneighbor) return;
+
+  rebalance(1);
+
+  next_reneighbor = (update->ntimestep/nevery)*nevery + nevery;
+}
+
+/* ----------------------------------------------------------------------
+   shift sub-domains if imbalance exceeds threshold
+   particles migrate to their new procs here with their per-atom fix data,
+     e.g. contact history, comm->exchange() could not move them far enough
+   mesh elements follow in the parallel operations of their fix mesh,
+     which are done on every step the box (here: sub-domains) changes
+   timed = 1 if time weights may be used
+------------------------------------------------------------------------- */
+
+void FixBalance::rebalance(int timed)
+{
+  // do not allow rebalance twice on same timestep
+
+  if (update->ntimestep == lastbalance) return;
+  lastbalance = update->ntimestep;
+
+  // insure atoms are in current box & update box via shrink-wrap
+
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  domain->pbc();
+  domain->reset_box();
+
+  double mycost = balance->cost();
+  balance->set_weights(timed ? mycost : 0.0);
+  imbnow = balance->imbalance_factor(maxloadperproc);
+
+  if (imbnow > thresh) {
+    imbprev = imbnow;
+    itercount = balance->shift();
+    imbfinal = balance->imbalance_splits(maxloadperproc);
+    balance->migrate_atoms();
+  } else imbfinal = imbnow;
+
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+}
+
+/* ----------------------------------------------------------------------
+   return imbalance factor after last rebalance
+------------------------------------------------------------------------- */
+
+double FixBalance::compute_scalar()
+{
+  return imbfinal;
+}
+
+/* ----------------------------------------------------------------------
+   return stats for last rebalance
+------------------------------------------------------------------------- */
+
+double FixBalance::compute_vector(int i)
+{
+  if (i == 0) return maxloadperproc;
+  if (i == 1) return (double) itercount;
+  return imbprev;
+}
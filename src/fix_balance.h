@@ -0,0 +1,77 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   This file was modified with respect to the release in LAMMPS
+   Modifications are Copyright 2009-2012 JKU Linz
+                     Copyright 2012-     DCS Computing GmbH, Linz
+
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(balance,FixBalance)
+
+#else
+
+#ifndef LMP_FIX_BALANCE_H
+#define LMP_FIX_BALANCE_H
+
+#include "fix.h"
+
+namespace LAMMPS_NS {
+
+class FixBalance : public Fix {
+ public:
+  FixBalance(class LAMMPS *, int, char **);
+  ~FixBalance();
+  int setmask();
+  void init();
+  void setup_pre_exchange();
+  void pre_exchange();
+  double compute_scalar();
+  double compute_vector(int);
+
+ private:
+  int nevery;
+  double thresh;
+  bigint lastbalance;        // last timestep balancing was attempted
+
+  double imbnow;             // current imbalance factor
+  double imbprev;            // imbalance factor before last rebalancing
+  double imbfinal;           // imbalance factor after last rebalancing
+  double maxloadperproc;     // max load on any processor
+  int itercount;             // iteration count of last rebalancing
+
+  class Balance *balance;
+
+  void rebalance(int);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+*/
@@ -36,11 +36,13 @@
 #include "fix_mesh_surface.h"
 #include "neighbor.h"
 #include "mpi_liggghts.h"
+#include "memory.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
 #define BIG 1000000.
+#define HUGE_VAL_CHECK 1.e300
 
 /* ---------------------------------------------------------------------- */
 
@@ -68,6 +70,19 @@ FixCheckTimestepGran::FixCheckTimestepGran(LAMMPS *lmp, int narg, char **arg) :
   extvector = 1;
 
   fraction_rayleigh = fraction_hertz = fraction_skin = 0.;
+
+  ntypes = 0;
+  rayleigh_coeff = hertz_coeff = minval = minval_all = NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixCheckTimestepGran::~FixCheckTimestepGran()
+{
+  memory->destroy(rayleigh_coeff);
+  memory->destroy(hertz_coeff);
+  memory->destroy(minval);
+  memory->destroy(minval_all);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -107,6 +122,29 @@ void FixCheckTimestepGran::init()
 
   if(!Y || !nu)
     error->all(FLERR,"Fix check/timestep/gran only works with a pair style that defines youngsModulus and poissonsRatio");
+
+  // cache material terms per type so the per-particle loop is free of
+  // sqrt and pow, they are applied to the per-type minima only
+
+  ntypes = max_type;
+  memory->destroy(rayleigh_coeff);
+  memory->destroy(hertz_coeff);
+  memory->destroy(minval);
+  memory->destroy(minval_all);
+  memory->create(rayleigh_coeff,ntypes+1,"check/timestep/gran:rayleigh_coeff");
+  memory->create(hertz_coeff,ntypes+1,"check/timestep/gran:hertz_coeff");
+  memory->create(minval,3+2*ntypes,"check/timestep/gran:minval");
+  memory->create(minval_all,3+2*ntypes,"check/timestep/gran:minval_all");
+
+  for(int t = 1; t < ntypes+1; t++)
+  {
+      double shear_mod = Y->values[t-1]/(2.*(nu->values[t-1]+1.));
+      rayleigh_coeff[t] = M_PI/(sqrt(shear_mod)*(0.1631*nu->values[t-1]+0.8766));
+
+      // meff^2/reff with meff = 4/3*PI*r^3*density and reff = r/2
+      double Eeff = pg->Yeff[t][t];
+      hertz_coeff[t] = 32.*M_PI*M_PI/(9.*Eeff*Eeff);
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -160,41 +198,50 @@ void FixCheckTimestepGran::calc_rayleigh_hertz_estims()
   int *mask = atom->mask;
   int nlocal = atom->nlocal;
 
-  int max_type = mpg->max_type();
-  int min_type = 1;
+  // one pass over particles collects all minima
+  //   minval[0] = min radius
+  //   minval[1] = -max squared particle velocity
+  //   minval[2] = -max squared mesh node velocity
+  //   minval[3+t-1] = min r^2*density of type t (rayleigh time)
+  //   minval[3+ntypes+t-1] = min r^5*density^2 of type t (hertz time)
+  // all are reduced in one MPI call
 
-  //check rayleigh time and vmax of particles
-  rayleigh_time = BIG;
-  r_min = BIG;
-  vmax = 0;
+  double *rr_min = &minval[3];
+  double *hh_min = &minval[3+ntypes];
 
-  double vmag;
-  double rayleigh_time_i;
+  minval[0] = BIG;
+  minval[1] = minval[2] = 0.;
+  for(int t = 0; t < ntypes; t++)
+      rr_min[t] = hh_min[t] = HUGE_VAL_CHECK;
+
+  double vmag2,vmax2 = 0.;
+  double rsq,rr,hh;
+  int t;
 
   for (int i = 0; i < nlocal; i++)
   {
     if (mask[i] & groupbit)
     {
-        double shear_mod = Y->values[type[i]-1]/(2.*(nu->values[type[i]-1]+1.));
-        rayleigh_time_i = M_PI*r[i]*sqrt(density[i]/shear_mod)/(0.1631*nu->values[type[i]-1]+0.8766);
-        if(rayleigh_time_i < rayleigh_time) rayleigh_time = rayleigh_time_i;
+        t = type[i]-1;
+        rsq = r[i]*r[i];
+        rr = rsq*density[i];
+        if(rr < rr_min[t]) rr_min[t] = rr;
+        hh = rr*rr*r[i];
+        if(hh < hh_min[t]) hh_min[t] = hh;
 
-        vmag = sqrt(v[i][0]*v[i][0]+v[i][1]*v[i][1]+v[i][2]*v[i][2]);
-        if(vmag > vmax) vmax=vmag;
+        vmag2 = v[i][0]*v[i][0]+v[i][1]*v[i][1]+v[i][2]*v[i][2];
+        if(vmag2 > vmax2) vmax2 = vmag2;
 
-        if(r[i] < r_min) r_min = r[i];
+        if(r[i] < minval[0]) minval[0] = r[i];
     }
   }
-
- MPI_Min_Scalar(r_min,world);
- MPI_Max_Scalar(vmax,world);
- MPI_Min_Scalar(rayleigh_time,world);
+  minval[1] = -vmax2;
 
   // get vmax of geometry
   FixMeshSurface ** mesh_list;
   TriMesh * mesh;
-  double *v_node;
-  double vmax_mesh=0.;
+  double ***v_node;
+  double vmax_mesh2 = 0.;
 
   if(fwg)
   {
@@ -204,54 +251,53 @@ void FixCheckTimestepGran::calc_rayleigh_hertz_estims()
           mesh = (mesh_list[imesh])->triMesh();
           if(mesh->isMoving())
           {
+              // set node velocity of mesh in rigid frame
+              mesh->updateRigidFrame();
+
               // loop local elements only
-              for(int itri=0;itri<mesh->sizeLocal();itri++)
+              v_node = mesh->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v")->begin();
+              int nTri = mesh->sizeLocal();
+              for(int itri=0;itri<nTri;itri++)
                   for(int inode=0;inode<3;inode++)
                   {
-                      v_node = mesh->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v")->begin()[itri][inode];
-                      vmag = vectorMag3D(v_node);
-                      if(vmag>vmax_mesh) vmax_mesh=vmag;
+                      vmag2 = vectorMag3DSquared(v_node[itri][inode]);
+                      if(vmag2>vmax_mesh2) vmax_mesh2=vmag2;
                   }
           }
       }
   }
+  minval[2] = -vmax_mesh2;
+
+  MPI_Allreduce(minval,minval_all,3+2*ntypes,MPI_DOUBLE,MPI_MIN,world);
 
- MPI_Max_Scalar(vmax_mesh,world);
+  rr_min = &minval_all[3];
+  hh_min = &minval_all[3+ntypes];
+
+  r_min = minval_all[0];
+  vmax = sqrt(-minval_all[1]);
+  double vmax_mesh = sqrt(-minval_all[2]);
 
   // decide vmax - either particle-particle or particle-mesh contact
   vmax = fmax(2.*vmax,vmax+vmax_mesh);
 
-  // check estimation for hertz time
+  // rayleigh time and estimation for hertz time from per-type minima
+  // hertz time is estimated by a collision of each particle with itself
   // this is not exact...
-  // loop over all material comibinations
-  //  loop all particles
-  //     test collision of particle with itself
-  double hertz_time_min = 1000000.;
-  double hertz_time_i,meff,reff,Eeff;
+  rayleigh_time = BIG;
+  hertz_time = BIG;
+
+  double rayleigh_time_t,hertz_time_t;
 
-  for(int ti = 1; ti < max_type+1; ti++)
+  for(int t = 1; t < ntypes+1; t++)
   {
-      for(int tj =  ti; tj < max_type+1; tj++)
-      {
-          Eeff=pg->Yeff[ti][tj];
+      if(rr_min[t-1] >= HUGE_VAL_CHECK) continue;
 
-          for(int i = 0; i < nlocal; i++)
-          {
-            if (mask[i] & groupbit)
-            {
-                if(type[i]!=ti || type[i]!=tj) continue;
-                meff = 4.*r[i]*r[i]*r[i]*M_PI/3.*density[i];
-                reff = r[i]/2.;
-                hertz_time_i = 2.87*pow(meff*meff/(reff*Eeff*Eeff*vmax),0.2);
-                if(hertz_time_i<hertz_time_min)
-                    hertz_time_min=hertz_time_i;
-            }
-          }
-      }
-  }
+      rayleigh_time_t = rayleigh_coeff[t]*sqrt(rr_min[t-1]);
+      if(rayleigh_time_t < rayleigh_time) rayleigh_time = rayleigh_time_t;
 
- MPI_Min_Scalar(hertz_time_min,world);
-  hertz_time = hertz_time_min;
+      hertz_time_t = 2.87*pow(hertz_coeff[t]*hh_min[t-1]/vmax,0.2);
+      if(hertz_time_t < hertz_time) hertz_time = hertz_time_t;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -35,6 +35,7 @@ namespace LAMMPS_NS {
 class FixCheckTimestepGran : public Fix {
  public:
   FixCheckTimestepGran(class LAMMPS *, int, char **);
+  ~FixCheckTimestepGran();
   int setmask();
   void init();
   void end_of_step();
@@ -53,6 +54,14 @@ class FixCheckTimestepGran : public Fix {
   double vmax; //max relative velocity
   double r_min;
   bool warnflag;
+
+  // per-type material terms, cached in init()
+  // rayleigh time = rayleigh_coeff * sqrt(r^2*density)
+  // hertz time = 2.87 * (hertz_coeff * r^5*density^2 / vmax)^0.2
+
+  int ntypes;
+  double *rayleigh_coeff,*hertz_coeff;
+  double *minval,*minval_all; // minima of a check, reduced in one MPI call
 };
 
 }
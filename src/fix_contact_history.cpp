@@ -29,7 +29,6 @@
 #include "pair_gran.h"
 #include "force.h"
 #include "update.h"
-#include "fix_mesh_surface.h"
 #include "modify.h"
 #include "memory.h"
 #include "error.h"
@@ -39,7 +38,6 @@ using namespace LAMMPS_NS;
 using namespace FixConst;
 
 #define DELTA_MAXTOUCH_PAIR 15
-#define DELTA_MAXTOUCH_MESH 3
 
 /* ---------------------------------------------------------------------- */
 
@@ -52,23 +50,11 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
 
   int iarg = 3;
 
-  if(strcmp(arg[iarg],"pair") == 0)
-    is_pair = true;
-  else if(strcmp(arg[iarg],"mesh") == 0)
-    is_pair = false;
-  else
-    error->fix_error(FLERR,this,"expecting keyword 'pair' or 'mesh'");
+  // mesh contacts are handled by fix contacthistory/mesh
+  if(strcmp(arg[iarg],"pair") != 0)
+    error->fix_error(FLERR,this,"expecting keyword 'pair'");
   iarg++;
 
-  // for mesh style, read mesh
-  if(!is_pair)
-  {
-      Fix *f = modify->find_fix_id(arg[iarg++]);
-      if(!f || strncmp(f->style,"mesh/surface",12) )
-        error->fix_error(FLERR,this,"wrong ID for fix mesh/surface");
-      mesh_ = (static_cast<FixMeshSurface*>(f))->triMesh();
-  }
-
   //read dnum
   dnum = atoi(arg[iarg++]);
   
@@ -77,37 +63,28 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
   if(dnum > 10)
     error->warning(FLERR,"dnum >10 in fix contacthistory - are you really sure you intend this?");
 
-  newtonflag = NULL;
-  history_id = NULL;
-  if(is_pair)
-  {
-      //read newtonflag
-      if(narg-iarg < 2*dnum)
-        error->all(FLERR,"Illegal fix contacthistory command - not enough parameters (need to specify an id and a newtonflag for each dnum)");
+  //read newtonflag
+  if(narg-iarg < 2*dnum)
+    error->all(FLERR,"Illegal fix contacthistory command - not enough parameters (need to specify an id and a newtonflag for each dnum)");
 
-      newtonflag = new int[dnum];
-      //history_id = new char*[dnum];
-      history_id = (char**) memory->smalloc((dnum)*sizeof(char*),"FixContactHistory:history_id");
+  newtonflag = new int[dnum];
+  history_id = (char**) memory->smalloc((dnum)*sizeof(char*),"FixContactHistory:history_id");
 
-      for(int i = 0 ; i < dnum; i++)
-      {
-        
-        history_id[i] = new char[strlen(arg[iarg])+1];
-        strcpy(history_id[i],arg[iarg++]);
-        newtonflag[i] = atoi(arg[iarg++]);
-        if(newtonflag[i] != 0 && newtonflag[i] != 1)
-            error->all(FLERR,"Illegal fix history command - newtonflag must be either 0 or 1");
-      }
+  for(int i = 0 ; i < dnum; i++)
+  {
+    
+    history_id[i] = new char[strlen(arg[iarg])+1];
+    strcpy(history_id[i],arg[iarg++]);
+    newtonflag[i] = atoi(arg[iarg++]);
+    if(newtonflag[i] != 0 && newtonflag[i] != 1)
+        error->all(FLERR,"Illegal fix history command - newtonflag must be either 0 or 1");
   }
 
   restart_peratom = 1;
   restart_global = 1; 
   create_attribute = 1;
 
-  if(is_pair)
-    maxtouch = DELTA_MAXTOUCH_PAIR;
-  else
-    maxtouch = DELTA_MAXTOUCH_MESH;
+  maxtouch = DELTA_MAXTOUCH_PAIR;
 
   // perform initial allocation of atom-based arrays
   // register with atom class
@@ -118,7 +95,6 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
   npartner = NULL;
   partner = NULL;
   contacthistory = NULL;
-  delflag = NULL;
   pair_gran = NULL;
 
   // initialize npartner to 0 so neighbor list creation is OK the 1st time
@@ -130,14 +106,6 @@ FixContactHistory::FixContactHistory(LAMMPS *lmp, int narg, char **arg) :
   }
 }
 
-/* ---------------------------------------------------------------------- */
-
-void FixContactHistory::post_create()
-{
-    if( ( (strcmp(style,"contacthistory") == 0) && ! is_pair ) ||
-        ( (strcmp(style,"contacthistory/mesh") == 0) &&  is_pair ) )
-        error->fix_error(FLERR,this,"illegal call");
-}
 
 /* ---------------------------------------------------------------------- */
 
@@ -152,17 +120,13 @@ FixContactHistory::~FixContactHistory()
     memory->destroy(npartner);
     memory->destroy(partner);
     memory->destroy(contacthistory);
-    memory->destroy(delflag);
 
-    if(is_pair)
-    {
-        delete[]newtonflag;
+    delete[]newtonflag;
 
-        for(int i = 0; i < dnum; i++)
-            delete [](history_id[i]);
+    for(int i = 0; i < dnum; i++)
+        delete [](history_id[i]);
 
-        memory->sfree(history_id);
-    }
+    memory->sfree(history_id);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -190,16 +154,11 @@ void FixContactHistory::init()
     if (atom->tag_enable == 0)
       error->fix_error(FLERR,this,"using contact history requires atoms have IDs");
 
-    if(is_pair)
-    {
-        if(!force->pair_match("gran", 0))
-            error->fix_error(FLERR,this,"Please use a granular pair style for fix contacthistory");
-        pair_gran = static_cast<PairGran*>(force->pair_match("gran", 0));
-        int dim;
-        computeflag = (int *) pair_gran->extract("computeflag",dim);
-    }
-    else if(!mesh_)
-        error->fix_error(FLERR,this,"illegal");
+    if(!force->pair_match("gran", 0))
+        error->fix_error(FLERR,this,"Please use a granular pair style for fix contacthistory");
+    pair_gran = static_cast<PairGran*>(force->pair_match("gran", 0));
+    int dim;
+    computeflag = (int *) pair_gran->extract("computeflag",dim);
 }
 
 /* ----------------------------------------------------------------------
@@ -219,24 +178,16 @@ void FixContactHistory::init()
 
 void FixContactHistory::setup_pre_exchange()
 {
-  if(is_pair)
-  {
-    
-    if (*computeflag) pre_exchange();
-    *computeflag = 0;
-  }
+  if (*computeflag) pre_exchange();
+  *computeflag = 0;
 }
 
 /* ---------------------------------------------------------------------- */
 
 void FixContactHistory::min_setup_pre_exchange()
 {
-  if(is_pair)
-  {
-    
-    if (*computeflag) pre_exchange();
-    *computeflag = 0;
-  }
+  if (*computeflag) pre_exchange();
+  *computeflag = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -246,15 +197,11 @@ void FixContactHistory::min_pre_exchange()
   pre_exchange();
 }
 
-/* ----------------------------------------------------------------------
-   pre_exchange - decide if pair or mesh
-------------------------------------------------------------------------- */
+/* ---------------------------------------------------------------------- */
 
 void FixContactHistory::pre_exchange()
 {
-    
-    if(is_pair)
-        pre_exchange_pair();
+    pre_exchange_pair();
 
     check_grow();
 }
@@ -357,7 +304,6 @@ void FixContactHistory::grow_arrays(int nmax)
   memory->grow(npartner,nmax,"contacthistory:npartner");
   memory->grow(partner,nmax,maxtouch,"contacthistory:partner");
   memory->grow(contacthistory,nmax,maxtouch,dnum,"contact_history:contacthistory");
-  memory->grow(delflag,nmax,maxtouch,"contact_history:delflag");
 }
 
 /* ----------------------------------------------------------------------
@@ -368,29 +314,22 @@ void FixContactHistory::grow_arrays_maxtouch(int nmax)
 {
   if(comm->me==0)
   {
-      if(screen) fprintf(screen,  "INFO: more than %d touching neighbor %s found, growing contact history.\n",maxtouch,is_pair?"atoms":"mesh elements");
-      if(logfile) fprintf(logfile,"INFO: more than %d touching neighbor %s found, growing contact history.\n",maxtouch,is_pair?"atoms":"mesh elements");
+      if(screen) fprintf(screen,  "INFO: more than %d touching neighbor atoms found, growing contact history.\n",maxtouch);
+      if(logfile) fprintf(logfile,"INFO: more than %d touching neighbor atoms found, growing contact history.\n",maxtouch);
   }
 
-  int delta;
-  if(is_pair)
-    delta = DELTA_MAXTOUCH_PAIR;
-  else
-    delta = DELTA_MAXTOUCH_MESH;
+  int delta = DELTA_MAXTOUCH_PAIR;
 
   int **partner_g;
   memory->create(partner_g,nmax,maxtouch+delta,"contacthistory:partner_g");
   double ***contacthistory_g;
   memory->create(contacthistory_g,nmax,maxtouch+delta,dnum,"contacthistory:contacthistory_g");
-  bool **delflag_g;
-  memory->create(delflag_g,nmax,maxtouch+delta,"contacthistory:delflag_g");
 
   for (int i = 0; i < nmax; i++)
   {
       for (int j = 0; j < maxtouch; j++)
       {
           partner_g[i][j] = partner[i][j];
-          delflag_g[i][j] = delflag[i][j];
           for (int k = 0 ; k < dnum; k++)
             contacthistory_g[i][j][k] = contacthistory[i][j][k];
       }
@@ -399,16 +338,13 @@ void FixContactHistory::grow_arrays_maxtouch(int nmax)
 
   maxtouch += delta;
 
-  int **h1; double ***h2; bool **h3;
+  int **h1; double ***h2;
   h1 = partner;
   h2 = contacthistory;
-  h3 = delflag;
   partner = partner_g;
   contacthistory = contacthistory_g;
-  delflag = delflag_g;
   memory->destroy(h1);
   memory->destroy(h2);
-  memory->destroy(h3);
 }
 
 /* ----------------------------------------------------------------------
@@ -421,7 +357,6 @@ void FixContactHistory::copy_arrays(int i, int j)
   npartner[j] = npartner[i];
   for (int m = 0; m < npartner[j]; m++) {
     partner[j][m] = partner[i][m];
-    delflag[j][m] = delflag[i][m];
     for (int d = 0; d < dnum; d++) {
       contacthistory[j][m][d] = contacthistory[i][m][d];
     }
@@ -448,7 +383,6 @@ int FixContactHistory::pack_exchange(int i, double *buf)
   buf[m++] = npartner[i];
   for (int n = 0; n < npartner[i]; n++) {
     buf[m++] = partner[i][n];
-    buf[m++] = static_cast<double>(delflag[i][n]);
     for (int d = 0; d < dnum; d++) {
       buf[m++] = contacthistory[i][n][d];
     }
@@ -466,7 +400,6 @@ int FixContactHistory::unpack_exchange(int nlocal, double *buf)
   npartner[nlocal] = static_cast<int> (buf[m++]);
   for (int n = 0; n < npartner[nlocal]; n++) {
     partner[nlocal][n] = static_cast<int> (buf[m++]);
-    delflag[nlocal][n] = static_cast<bool> (buf[m++]);
     for (int d = 0; d < dnum; d++) {
       contacthistory[nlocal][n][d] = buf[m++];
     }
@@ -548,7 +481,6 @@ void FixContactHistory::unpack_restart(int nlocal, int nth)
   npartner[nlocal] = static_cast<int> (extra[nlocal][m++]);
   for (int n = 0; n < npartner[nlocal]; n++) {
     partner[nlocal][n] = static_cast<int> (extra[nlocal][m++]);
-    delflag[nlocal][n] = false;
     for (d = 0; d < dnum; d++) {
       contacthistory[nlocal][n][d] = extra[nlocal][m++];
     }
@@ -572,45 +504,3 @@ int FixContactHistory::size_restart(int nlocal)
 {
   return (dnum+1)*npartner[nlocal] + 2;
 }
-
-/* ----------------------------------------------------------------------
-   clear all entries where deleteFlag is set
-------------------------------------------------------------------------- */
-
-void FixContactHistory::cleanUpContacts()
-{
-    int nlocal = atom->nlocal;
-
-    for(int i = 0; i < nlocal; i++)
-    {
-        int j = 0;
-        while(j < npartner[i])
-        {
-            // delete and copy values
-            if(delflag[i][j])
-            {
-                
-                // swap with last contact if more than 1
-                if(npartner[i] > 1)
-                {
-                    partner[i][j] = partner[i][npartner[i]-1];
-                    delflag[i][j] = delflag[i][npartner[i]-1];
-
-                    if(dnum)
-                        for(int d = 0; d < dnum; d++)
-                            contacthistory[i][j][d] = contacthistory[i][npartner[i]-1][d];
-                }
-
-                partner[i][npartner[i]-1] = -1;
-                delflag[i][npartner[i]-1] = false;
-
-                if(dnum)
-                    for(int d = 0; d < dnum; d++)
-                        contacthistory[i][npartner[i]-1][d] = 0.;
-
-                npartner[i]--;
-            }
-            else j++;
-        }
-    }
-}
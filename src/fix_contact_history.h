@@ -23,15 +23,12 @@
 
 FixStyle(contacthistory,FixContactHistory) 
 
-FixStyle(contacthistory/mesh,FixContactHistory) 
-
 #else
 
 #ifndef LMP_FIX_CONTACT_HISTORY_H
 #define LMP_FIX_CONTACT_HISTORY_H
 
 #include "fix.h"
-#include "tri_mesh.h"
 #include "atom.h"
 
 namespace LAMMPS_NS {
@@ -47,7 +44,6 @@ class FixContactHistory : public Fix {
 
   // inherited from Fix
 
-  void post_create();
   int setmask();
   void init();
   void initial_integrate(int dummy);
@@ -69,29 +65,14 @@ class FixContactHistory : public Fix {
   void write_restart(FILE *);
   void restart(char *);
 
-  // spefific interface for mesh
-
-  bool handleContact(int iPart, int idTri, double *&history);
-  void markAllContacts();
-  void cleanUpContacts();
-
   // return # of contacts
   int n_contacts();
   int n_contacts(int contact_groupbit);
 
  private:
 
-  // functions specific for pair
-
   void pre_exchange_pair();
 
-  // functions specific for mesh - contact management
-
-  bool haveContact(int indexPart, int idTri, double *&history);
-  bool coplanarContactAlready(int indexPart, int idTri);
-  void checkCoplanarContactHistory(int indexPart, int idTri, double *&history);
-  void addNewTriContactToExistingParticle(int indexPart, int idTri, double *&history);
-
   // mem management
   void check_grow();
 
@@ -103,12 +84,8 @@ class FixContactHistory : public Fix {
   int maxtouch;                 // max number of partners per atom
   void grow_arrays_maxtouch(int);
 
-  bool **delflag;               
-
-  bool is_pair;
   class PairGran *pair_gran;
   int *computeflag;             // computeflag in PairGranHookeHistory
-  class TriMesh *mesh_;
 
   int dnum;
   int *newtonflag;
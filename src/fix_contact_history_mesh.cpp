@@ -0,0 +1,559 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Contributing authors:
+   Christoph Kloss (JKU Linz, DCS Computing GmbH, Linz)
+   Philippe Seil (JKU Linz)
+------------------------------------------------------------------------- */
+
+#include "string.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "fix_contact_history_mesh.h"
+#include "atom.h"
+#include "fix_mesh_surface.h"
+#include "modify.h"
+#include "memory.h"
+#include "error.h"
+#include "comm.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+#define DELTA_CONTACTS 1024
+#define INDEX_BITS_MIN 10
+
+/* ---------------------------------------------------------------------- */
+
+FixContactHistoryMesh::FixContactHistoryMesh(LAMMPS *lmp, int narg, char **arg) :
+  Fix(lmp, narg, arg),
+  nContacts_(0),
+  maxContacts_(0),
+  contactTag_(0),
+  contactOwner_(0),
+  contactTri_(0),
+  contactGen_(0),
+  contactNext_(0),
+  contactPrev_(0),
+  contactHistory_(0),
+  npartner_(0),
+  firstContact_(0),
+  nmax_(0),
+  indexSize_(0),
+  indexBits_(0),
+  indexKey_(0),
+  indexContact_(0),
+  generation_(0),
+  mesh_(0)
+{
+  //parse args
+  if(narg < 6)
+    error->fix_error(FLERR,this,"not enough parameters");
+
+  int iarg = 3;
+
+  if(strcmp(arg[iarg++],"mesh"))
+    error->fix_error(FLERR,this,"expecting keyword 'mesh'");
+
+  Fix *f = modify->find_fix_id(arg[iarg++]);
+  if(!f || strncmp(f->style,"mesh/surface",12) )
+    error->fix_error(FLERR,this,"wrong ID for fix mesh/surface");
+  mesh_ = (static_cast<FixMeshSurface*>(f))->triMesh();
+
+  //read dnum
+  dnum_ = atoi(arg[iarg++]);
+
+  if(dnum_ < 1)
+    error->fix_error(FLERR,this,"dnum must be >=1");
+  if(dnum_ > 10)
+    error->warning(FLERR,"dnum >10 in fix contacthistory/mesh - are you really sure you intend this?");
+
+  restart_peratom = 1;
+  restart_global = 1;
+  create_attribute = 1;
+
+  // allocate contact pool and index
+
+  growPool();
+  growIndex();
+
+  // perform initial allocation of atom-based arrays
+  // register with atom class
+
+  atom->add_callback(0);
+  atom->add_callback(1);
+
+  // initially no atom has contacts
+  if(atom->nmax > 0)
+      grow_arrays(atom->nmax);
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixContactHistoryMesh::~FixContactHistoryMesh()
+{
+    // unregister this fix so atom class doesn't invoke it any more
+    atom->delete_callback(id,0);
+    atom->delete_callback(id,1);
+
+    // delete locally stored arrays
+
+    memory->destroy(npartner_);
+    memory->destroy(firstContact_);
+
+    memory->destroy(contactTag_);
+    memory->destroy(contactOwner_);
+    memory->destroy(contactTri_);
+    memory->destroy(contactGen_);
+    memory->destroy(contactNext_);
+    memory->destroy(contactPrev_);
+    memory->destroy(contactHistory_);
+
+    memory->sfree(indexKey_);
+    memory->destroy(indexContact_);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::setmask()
+{
+  int mask = 0;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::init()
+{
+    if (atom->tag_enable == 0)
+      error->fix_error(FLERR,this,"using contact history requires atoms have IDs");
+
+    if(!mesh_)
+      error->fix_error(FLERR,this,"illegal");
+}
+
+/* ----------------------------------------------------------------------
+   add a new contact to the pool and the index
+   contact is put at the head of the chain of the particle
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::addContact(int iP, int idTri)
+{
+    int tag = atom->tag[iP];
+    uint64_t key = contactKey(tag,idTri);
+
+    // remove a left-over entry with the same key
+    // may only happen if the atom has left and re-entered before clean-up
+
+    int iOld = indexFind(key);
+    if(iOld >= 0) deleteContact(iOld);
+
+    if(nContacts_ == maxContacts_) growPool();
+    if(2*(nContacts_+1) > indexSize_) growIndex();
+
+    int iContact = nContacts_++;
+
+    contactTag_[iContact] = tag;
+    contactOwner_[iContact] = iP;
+    contactTri_[iContact] = idTri;
+    contactGen_[iContact] = generation_;
+
+    contactPrev_[iContact] = -1;
+    contactNext_[iContact] = firstContact_[iP];
+    if(firstContact_[iP] >= 0) contactPrev_[firstContact_[iP]] = iContact;
+    firstContact_[iP] = iContact;
+    npartner_[iP]++;
+
+    double *history = &contactHistory_[iContact*dnum_];
+    for(int d = 0; d < dnum_; d++)
+        history[d] = 0.;
+
+    indexInsert(key,iContact);
+
+    return iContact;
+}
+
+/* ----------------------------------------------------------------------
+   remove contact from particle chain, index and pool
+   last contact in the pool is moved to the free position
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::deleteContact(int iContact)
+{
+    bool orphan = isOrphan(iContact);
+    int iP = contactOwner_[iContact];
+    int prev = contactPrev_[iContact];
+    int next = contactNext_[iContact];
+
+    // unlink from chain, chains of orphans are not referenced by any atom
+
+    if(prev >= 0) contactNext_[prev] = next;
+    else if(!orphan) firstContact_[iP] = next;
+    if(next >= 0) contactPrev_[next] = prev;
+    if(!orphan) npartner_[iP]--;
+
+    indexErase(contactKey(contactTag_[iContact],contactTri_[iContact]));
+
+    // fill the gap with the last contact
+
+    int iLast = --nContacts_;
+    if(iContact == iLast) return;
+
+    contactTag_[iContact] = contactTag_[iLast];
+    contactOwner_[iContact] = contactOwner_[iLast];
+    contactTri_[iContact] = contactTri_[iLast];
+    contactGen_[iContact] = contactGen_[iLast];
+    contactPrev_[iContact] = prev = contactPrev_[iLast];
+    contactNext_[iContact] = next = contactNext_[iLast];
+    vectorCopyN(&contactHistory_[iLast*dnum_],&contactHistory_[iContact*dnum_],dnum_);
+
+    if(prev >= 0) contactNext_[prev] = iContact;
+    else if(!isOrphan(iContact)) firstContact_[contactOwner_[iContact]] = iContact;
+    if(next >= 0) contactPrev_[next] = iContact;
+
+    indexUpdate(contactKey(contactTag_[iContact],contactTri_[iContact]),iContact);
+}
+
+/* ----------------------------------------------------------------------
+   clear all contacts not handled in this generation
+   also removes contacts of atoms that have left this proc
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::cleanUpContacts()
+{
+    int iContact = 0;
+
+    while(iContact < nContacts_)
+    {
+        if(contactGen_[iContact] != generation_ || isOrphan(iContact))
+            deleteContact(iContact);
+        else
+            iContact++;
+    }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::growPool()
+{
+    maxContacts_ += DELTA_CONTACTS;
+
+    memory->grow(contactTag_,maxContacts_,"contacthistory/mesh:contactTag");
+    memory->grow(contactOwner_,maxContacts_,"contacthistory/mesh:contactOwner");
+    memory->grow(contactTri_,maxContacts_,"contacthistory/mesh:contactTri");
+    memory->grow(contactGen_,maxContacts_,"contacthistory/mesh:contactGen");
+    memory->grow(contactNext_,maxContacts_,"contacthistory/mesh:contactNext");
+    memory->grow(contactPrev_,maxContacts_,"contacthistory/mesh:contactPrev");
+    memory->grow(contactHistory_,maxContacts_*dnum_,"contacthistory/mesh:contactHistory");
+}
+
+/* ----------------------------------------------------------------------
+   double index size (or do initial allocation) and re-hash
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::growIndex()
+{
+    indexBits_ = indexBits_ ? indexBits_+1 : INDEX_BITS_MIN;
+    indexSize_ = 1 << indexBits_;
+
+    memory->sfree(indexKey_);
+    memory->destroy(indexContact_);
+    indexKey_ = (uint64_t*) memory->smalloc(indexSize_*sizeof(uint64_t),"contacthistory/mesh:indexKey");
+    memory->create(indexContact_,indexSize_,"contacthistory/mesh:indexContact");
+
+    for(int i = 0; i < indexSize_; i++)
+        indexContact_[i] = -1;
+
+    for(int iContact = 0; iContact < nContacts_; iContact++)
+        indexInsert(contactKey(contactTag_[iContact],contactTri_[iContact]),iContact);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::indexInsert(uint64_t key, int iContact)
+{
+    int mask = indexSize_ - 1;
+    int i = indexHome(key);
+    while(indexContact_[i] >= 0)
+        i = (i+1) & mask;
+
+    indexKey_[i] = key;
+    indexContact_[i] = iContact;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::indexUpdate(uint64_t key, int iContact)
+{
+    int mask = indexSize_ - 1;
+    for(int i = indexHome(key); indexContact_[i] >= 0; i = (i+1) & mask)
+    {
+        if(indexKey_[i] == key)
+        {
+            indexContact_[i] = iContact;
+            return;
+        }
+    }
+    error->one(FLERR,"Internal error in fix contacthistory/mesh: index out of sync");
+}
+
+/* ----------------------------------------------------------------------
+   remove key, entries of the same probe sequence are shifted back
+   so no tombstones are needed
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::indexErase(uint64_t key)
+{
+    int mask = indexSize_ - 1;
+    int i = indexHome(key);
+
+    while(indexContact_[i] >= 0 && indexKey_[i] != key)
+        i = (i+1) & mask;
+
+    if(indexContact_[i] < 0) return;
+
+    int j = i;
+    while(true)
+    {
+        j = (j+1) & mask;
+        if(indexContact_[j] < 0) break;
+
+        // entry j may stay if its home bucket is cyclically in (i,j]
+        int k = indexHome(indexKey_[j]);
+        if( (i <= j) ? (i < k && k <= j) : (i < k || k <= j) )
+            continue;
+
+        indexKey_[i] = indexKey_[j];
+        indexContact_[i] = indexContact_[j];
+        i = j;
+    }
+
+    indexContact_[i] = -1;
+}
+
+/* ----------------------------------------------------------------------
+   memory usage of local atom-based arrays and contact pool
+------------------------------------------------------------------------- */
+
+double FixContactHistoryMesh::memory_usage()
+{
+  int nmax = atom->nmax;
+  double bytes = 2 * nmax * sizeof(int);
+  bytes += 6 * maxContacts_ * sizeof(int);
+  bytes += maxContacts_ * dnum_ * sizeof(double);
+  bytes += indexSize_ * (sizeof(uint64_t) + sizeof(int));
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   allocate local atom-based arrays
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::grow_arrays(int nmax)
+{
+  memory->grow(npartner_,nmax,"contacthistory/mesh:npartner");
+  memory->grow(firstContact_,nmax,"contacthistory/mesh:firstContact");
+
+  // chains must be valid for every slot
+  for(int i = nmax_; i < nmax; i++)
+    set_arrays(i);
+  nmax_ = nmax;
+}
+
+/* ----------------------------------------------------------------------
+   copy values within local atom-based arrays from i to j
+   the chain of j (if any) is orphaned and removed in cleanUpContacts()
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::copy_arrays(int i, int j)
+{
+  npartner_[j] = npartner_[i];
+  firstContact_[j] = firstContact_[i];
+
+  for(int iContact = firstContact_[j]; iContact >= 0; iContact = contactNext_[iContact])
+    contactOwner_[iContact] = j;
+}
+
+/* ----------------------------------------------------------------------
+   initialize one atom's array values, called when atom is created
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::set_arrays(int i)
+{
+  npartner_[i] = 0;
+  firstContact_[i] = -1;
+}
+
+/* ----------------------------------------------------------------------
+   pack values in local atom-based arrays for exchange with another proc
+   contacts are packed oldest first so the order survives unpacking
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::pack_exchange(int i, double *buf)
+{
+  int m = 0;
+  buf[m++] = npartner_[i];
+
+  int iContact = firstContact_[i];
+  while(iContact >= 0 && contactNext_[iContact] >= 0)
+    iContact = contactNext_[iContact];
+
+  for( ; iContact >= 0; iContact = contactPrev_[iContact]) {
+    buf[m++] = contactTri_[iContact];
+    buf[m++] = static_cast<double>(contactGen_[iContact] == generation_);
+    for (int d = 0; d < dnum_; d++) {
+      buf[m++] = contactHistory_[iContact*dnum_+d];
+    }
+  }
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   unpack values in local atom-based arrays from exchange with another proc
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::unpack_exchange(int nlocal, double *buf)
+{
+  int m = 0;
+  set_arrays(nlocal);
+
+  int n = static_cast<int> (buf[m++]);
+  for (int k = 0; k < n; k++) {
+    int iContact = addContact(nlocal,static_cast<int> (buf[m++]));
+    if(!static_cast<bool> (buf[m++])) contactGen_[iContact] = generation_-1;
+    for (int d = 0; d < dnum_; d++) {
+      contactHistory_[iContact*dnum_+d] = buf[m++];
+    }
+  }
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   pack entire state of Fix into one write
+   layout is identical to fix contacthistory so restart files stay compatible
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::write_restart(FILE *fp)
+{
+  int maxpartner = 0;
+  int nlocal = atom->nlocal;
+  for(int i = 0; i < nlocal; i++)
+    if(npartner_[i] > maxpartner) maxpartner = npartner_[i];
+
+  int maxpartner_all;
+  MPI_Allreduce(&maxpartner,&maxpartner_all,1,MPI_INT,MPI_MAX,world);
+
+  int n = 0;
+  double list[6];
+  list[n++] = static_cast<double>(dnum_);
+  list[n++] = static_cast<double>(maxpartner_all);
+
+  if (comm->me == 0) {
+    int size = n * sizeof(double);
+    fwrite(&size,sizeof(int),1,fp);
+    fwrite(list,sizeof(double),n,fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   use state info from restart file to restart the Fix
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::restart(char *buf)
+{
+  double *list = (double *) buf;
+
+  int unpack_dnum = static_cast<int> (list[0]);
+  if(unpack_dnum != dnum_)
+    error->all(FLERR,"Saved simulation state used different contact history model - can not restart");
+}
+
+/* ----------------------------------------------------------------------
+   pack values in local atom-based arrays for restart file
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::pack_restart(int i, double *buf)
+{
+  int m = 0;
+  buf[m++] = (dnum_+1)*npartner_[i] + 2;
+  buf[m++] = npartner_[i];
+
+  int iContact = firstContact_[i];
+  while(iContact >= 0 && contactNext_[iContact] >= 0)
+    iContact = contactNext_[iContact];
+
+  for( ; iContact >= 0; iContact = contactPrev_[iContact]) {
+    buf[m++] = contactTri_[iContact];
+    for (int d = 0; d < dnum_; d++) {
+      buf[m++] = contactHistory_[iContact*dnum_+d];
+    }
+  }
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   unpack values from atom->extra array to restart the fix
+------------------------------------------------------------------------- */
+
+void FixContactHistoryMesh::unpack_restart(int nlocal, int nth)
+{
+  double **extra = atom->extra;
+
+  // skip to Nth set of extra values
+
+  int m = 0;
+  for (int i = 0; i < nth; i++) m += static_cast<int> (extra[nlocal][m]);
+  m++;
+
+  set_arrays(nlocal);
+
+  int n = static_cast<int> (extra[nlocal][m++]);
+  for (int k = 0; k < n; k++) {
+    int iContact = addContact(nlocal,static_cast<int> (extra[nlocal][m++]));
+    for (int d = 0; d < dnum_; d++) {
+      contactHistory_[iContact*dnum_+d] = extra[nlocal][m++];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   maxsize of any atom's restart data
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::maxsize_restart()
+{
+  int maxpartner = 0;
+  int nlocal = atom->nlocal;
+  for(int i = 0; i < nlocal; i++)
+    if(npartner_[i] > maxpartner) maxpartner = npartner_[i];
+
+  return (dnum_+1)*maxpartner + 2;
+}
+
+/* ----------------------------------------------------------------------
+   size of atom nlocal's restart data
+------------------------------------------------------------------------- */
+
+int FixContactHistoryMesh::size_restart(int nlocal)
+{
+  return (dnum_+1)*npartner_[nlocal] + 2;
+}
@@ -0,0 +1,146 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Contributing authors:
+   Christoph Kloss (JKU Linz, DCS Computing GmbH, Linz)
+   Philippe Seil (JKU Linz)
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(contacthistory/mesh,FixContactHistoryMesh)
+
+#else
+
+#ifndef LMP_FIX_CONTACT_HISTORY_MESH_H
+#define LMP_FIX_CONTACT_HISTORY_MESH_H
+
+#include "fix.h"
+#include "tri_mesh.h"
+#include "atom.h"
+
+namespace LAMMPS_NS {
+
+class FixContactHistoryMesh : public Fix {
+
+ public:
+
+  FixContactHistoryMesh(class LAMMPS *, int, char **);
+  ~FixContactHistoryMesh();
+
+  // inherited from Fix
+
+  int setmask();
+  void init();
+
+  double memory_usage();
+  void grow_arrays(int);
+  void copy_arrays(int, int);
+  void set_arrays(int);
+  int pack_exchange(int, double *);
+  int unpack_exchange(int, double *);
+  int pack_restart(int, double *);
+  void unpack_restart(int, int);
+  int size_restart(int);
+  int maxsize_restart();
+  void write_restart(FILE *);
+  void restart(char *);
+
+  // specific interface for mesh
+
+  bool handleContact(int iPart, int idTri, double *&history);
+  double *contactHistory(int iPart, int idTri);
+  void markAllContacts();
+  void cleanUpContacts();
+
+  // return # of contacts
+  int n_contacts();
+  int n_contacts(int contact_groupbit);
+
+ private:
+
+  // contact management
+
+  bool coplanarContactAlready(int iPart, int idTri);
+  void checkCoplanarContactHistory(int iContact, double *history);
+  bool isOrphan(int iContact);
+  int addContact(int iPart, int idTri);
+  void deleteContact(int iContact);
+  void growPool();
+
+  // open-addressing index (linear probing) on (atom tag, element id)
+
+  uint64_t contactKey(int tag, int idTri);
+  int indexHome(uint64_t key);
+  int indexFind(uint64_t key);
+  void indexInsert(uint64_t key, int iContact);
+  void indexErase(uint64_t key);
+  void indexUpdate(uint64_t key, int iContact);
+  void growIndex();
+
+  // contact pool, one entry per contact, structure of arrays
+  // contacts of one particle are chained via contactNext_/contactPrev_
+
+  int nContacts_,maxContacts_;
+  int *contactTag_;             // tag of the particle
+  int *contactOwner_;           // local index of the particle
+  int *contactTri_;             // id of the mesh element
+  int *contactGen_;             // generation in which the contact was handled last
+  int *contactNext_, *contactPrev_;
+  double *contactHistory_;      // dnum history values per contact
+
+  // per-atom data
+
+  int *npartner_;               // # of touching mesh elements of each atom
+  int *firstContact_;           // head of contact chain for each atom
+  int nmax_;
+
+  // index
+
+  int indexSize_,indexBits_;
+  uint64_t *indexKey_;
+  int *indexContact_;           // -1 marks an empty bucket
+
+  // contacts not handled in current generation are deleted in cleanUpContacts()
+  int generation_;
+
+  class TriMesh *mesh_;
+  int dnum_;
+};
+
+// *************************************
+#include "fix_contact_history_mesh_I.h"
+// *************************************
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Fix contacthistory/mesh: using contact history requires atoms have IDs
+
+Atoms in the simulation do not have IDs, so history effects
+cannot be tracked for mesh contacts.
+
+*/
@@ -0,0 +1,190 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Contributing authors:
+   Christoph Kloss (JKU Linz, DCS Computing GmbH, Linz)
+   Philippe Seil (JKU Linz)
+------------------------------------------------------------------------- */
+
+#ifndef LMP_CONTACT_HISTORY_MESH_I_H
+#define LMP_CONTACT_HISTORY_MESH_I_H
+
+  /* ---------------------------------------------------------------------- */
+
+  inline bool FixContactHistoryMesh::handleContact(int iP, int idTri, double *&history)
+  {
+    // check if contact with iTri was there before
+    // if so, set history to correct location and return
+
+    int iContact = indexFind(contactKey(atom->tag[iP],idTri));
+
+    if(iContact >= 0 && contactOwner_[iContact] == iP)
+    {
+        contactGen_[iContact] = generation_;
+        history = &contactHistory_[iContact*dnum_];
+        return true;
+    }
+
+    // else new contact - add contact if did not calculate contact with coplanar neighbor already
+
+    if(!coplanarContactAlready(iP,idTri))
+    {
+        iContact = addContact(iP,idTri);
+        history = &contactHistory_[iContact*dnum_];
+
+        // check if one of the contacts of previous steps is coplanar with iTri
+        // if so, copy history
+        checkCoplanarContactHistory(iContact,history);
+        return true;
+    }
+
+    // did not add new contact
+    return false;
+  }
+
+  /* ----------------------------------------------------------------------
+     history of a contact that has been handled already
+     does not modify the store, so may be called concurrently
+  ------------------------------------------------------------------------- */
+
+  inline double* FixContactHistoryMesh::contactHistory(int iP, int idTri)
+  {
+    int iContact = indexFind(contactKey(atom->tag[iP],idTri));
+    return &contactHistory_[iContact*dnum_];
+  }
+
+  /* ----------------------------------------------------------------------
+     mark all contacts for deletion
+     starting a new generation, so no per-contact work is needed
+  ------------------------------------------------------------------------- */
+
+  inline void FixContactHistoryMesh::markAllContacts()
+  {
+      generation_++;
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  inline bool FixContactHistoryMesh::coplanarContactAlready(int iP, int idTri)
+  {
+    for(int iContact = firstContact_[iP]; iContact >= 0; iContact = contactNext_[iContact])
+    {
+      // only contacts handled this step are relevant, check this first
+      // since the coplanarity test is expensive
+
+      if(contactGen_[iContact] != generation_)
+        continue;
+
+      int idOther = contactTri_[iContact];
+      if(idOther != idTri && mesh_->map(idOther) >= 0 && mesh_->areCoplanarNodeNeighs(idOther,idTri))
+      {
+        // other coplanar contact handled already - do not handle this contact
+        return true;
+      }
+    }
+
+    // no coplanar contact found - handle this contact
+    return false;
+  }
+
+  /* ----------------------------------------------------------------------
+     new contacts are at the head of the chain, so the first coplanar
+     contact found is the most recent one
+  ------------------------------------------------------------------------- */
+
+  inline void FixContactHistoryMesh::checkCoplanarContactHistory(int iNew, double *history)
+  {
+    int idTri = contactTri_[iNew];
+
+    for(int iContact = contactNext_[iNew]; iContact >= 0; iContact = contactNext_[iContact])
+    {
+      int idOther = contactTri_[iContact];
+      if(idOther != idTri && mesh_->map(idOther) >= 0 && mesh_->areCoplanarNodeNeighs(idOther,idTri))
+      {
+          // copy contact history
+          vectorCopyN(&contactHistory_[iContact*dnum_],history,dnum_);
+          return;
+      }
+    }
+  }
+
+  /* ----------------------------------------------------------------------
+     contact belongs to an atom that has left or was deleted
+  ------------------------------------------------------------------------- */
+
+  inline bool FixContactHistoryMesh::isOrphan(int iContact)
+  {
+    int iP = contactOwner_[iContact];
+    return (iP >= atom->nlocal || atom->tag[iP] != contactTag_[iContact]);
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  inline uint64_t FixContactHistoryMesh::contactKey(int tag, int idTri)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(tag)) << 32) | static_cast<uint32_t>(idTri);
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  inline int FixContactHistoryMesh::indexHome(uint64_t key)
+  {
+    // fibonacci hashing
+    return static_cast<int>((key * 0x9E3779B97F4A7C15ULL) >> (64 - indexBits_));
+  }
+
+  /* ----------------------------------------------------------------------
+     return contact for key, -1 if not found
+  ------------------------------------------------------------------------- */
+
+  inline int FixContactHistoryMesh::indexFind(uint64_t key)
+  {
+    int mask = indexSize_ - 1;
+    for(int i = indexHome(key); indexContact_[i] >= 0; i = (i+1) & mask)
+        if(indexKey_[i] == key) return indexContact_[i];
+    return -1;
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  inline int FixContactHistoryMesh::n_contacts()
+  {
+    int ncontacts = 0, nlocal = atom->nlocal;
+
+    for(int i = 0; i < nlocal; i++)
+           ncontacts += npartner_[i];
+    return ncontacts;
+  }
+
+  /* ---------------------------------------------------------------------- */
+
+  inline int FixContactHistoryMesh::n_contacts(int contact_groupbit)
+  {
+    int ncontacts = 0, nlocal = atom->nlocal;
+    int *mask = atom->mask;
+
+    for(int i = 0; i < nlocal; i++)
+        if(mask[i] & contact_groupbit)
+           ncontacts += npartner_[i];
+    return ncontacts;
+  }
+#endif
@@ -62,6 +62,8 @@ FixHeatGran::FixHeatGran(LAMMPS *lmp, int narg, char **arg) : Fix(lmp, narg, arg
 
   cpl = NULL;
 
+  integrate_every = 1;
+
   FHG_init_flag = false;
 
 }
@@ -74,7 +76,7 @@ void FixHeatGran::post_create(){
 
   if(!fix_ste)
   {
-    char **newarg = new char*[15];
+    char **newarg = new char*[17];
     newarg[0] = (char *) "ste_heattransfer";
     newarg[1] = group->names[igroup];
     newarg[2] = (char *) "transportequation/scalar";
@@ -91,9 +93,13 @@ void FixHeatGran::post_create(){
     newarg[12] = (char *) "heatSource";
     newarg[13] = (char *) "capacity_quantity";
     newarg[14] = (char *) "thermalCapacity";
-    modify->add_fix(15,newarg);
+    newarg[15] = (char *) "integrate_every";
+    newarg[16] = new char[30];
+    sprintf(newarg[16],"%d",integrate_every);
+    modify->add_fix(17,newarg);
 
     delete [] newarg[8];
+    delete [] newarg[16];
     delete [] newarg;
   }
 }
@@ -127,6 +133,8 @@ void FixHeatGran::init(){
 
   fix_ste = modify->find_fix_scalar_transport_equation("heattransfer");
   if(!fix_ste) error->all(FLERR,"Fix heat/gran needs a fix transportequation/scalar to work with");
+  if(integrate_every > 1 && fix_ste->integrate_every() != integrate_every)
+    error->fix_error(FLERR,this,"'integrate_every' does not match the one of the existing fix transportequation/scalar");
 
   fix_temp = static_cast<FixPropertyAtom*>(modify->find_fix_property("Temp","property/atom","scalar",0,0,style));
   fix_heatFlux = static_cast<FixPropertyAtom*>(modify->find_fix_property("heatFlux","property/atom","scalar",0,0,style));
@@ -61,6 +61,9 @@ namespace LAMMPS_NS {
 
     class PairGran *pair_gran;
     int history_flag;
+
+    // thermal super-stepping, passed to the transport equation
+    int integrate_every;
   };
 
 }
@@ -25,6 +25,7 @@
 #include "compute_pair_gran_local.h"
 #include "fix_property_atom.h"
 #include "fix_property_global.h"
+#include "fix_scalar_transport_equation.h"
 #include "force.h"
 #include "math_extra.h"
 #include "mech_param_gran.h"
@@ -42,6 +43,8 @@ FixHeatGranCond::FixHeatGranCond(class LAMMPS *lmp, int narg, char **arg) : FixH
   int iarg = 5;
 
   area_correction_flag = 0;
+  sampling_flag = 0;
+  flux_weight = 1.;
 
   bool hasargs = true;
   while(iarg < narg && hasargs)
@@ -56,6 +59,21 @@ FixHeatGranCond::FixHeatGranCond(class LAMMPS *lmp, int narg, char **arg) : FixH
       else error->fix_error(FLERR,this,"");
       iarg += 2;
       hasargs = true;
+    } else if(strcmp(arg[iarg],"integrate_every") == 0) {
+      if (iarg+2 > narg) error->fix_error(FLERR,this,"not enough arguments for keyword 'integrate_every'");
+      integrate_every = atoi(arg[iarg+1]);
+      if (integrate_every < 1) error->fix_error(FLERR,this,"'integrate_every' > 0 required");
+      iarg += 2;
+      hasargs = true;
+    } else if(strcmp(arg[iarg],"sampling") == 0) {
+      if (iarg+2 > narg) error->fix_error(FLERR,this,"not enough arguments for keyword 'sampling'");
+      if(strcmp(arg[iarg+1],"yes") == 0)
+        sampling_flag = 1;
+      else if(strcmp(arg[iarg+1],"no") == 0)
+        sampling_flag = 0;
+      else error->fix_error(FLERR,this,"expecting 'yes' or 'no' for 'sampling'");
+      iarg += 2;
+      hasargs = true;
     } else if(strcmp(style,"heat/gran/conduction") == 0)
       	error->fix_error(FLERR,this,"unknown keyword");
   }
@@ -158,6 +176,9 @@ void FixHeatGranCond::init()
     deltan_ratio = static_cast<FixPropertyGlobal*>(modify->find_fix_property("youngsModulusOriginal","property/global","peratomtype",max_type,0,style))->get_array_modified();
   }
 
+  // let the pair style record the touching pairs of its force pass
+  pair_gran->request_contact_buffer();
+
   updatePtrs();
 }
 
@@ -165,9 +186,32 @@ void FixHeatGranCond::init()
 
 void FixHeatGranCond::post_force(int vflag){
 
+  // thermal super-stepping with sampling:
+  // conduction is evaluated on the last step of a cycle only and stands
+  // for all steps of the cycle, other steps only serve compute pair/gran/local
+
+  int cpl_flag = 0;
+  flux_weight = 1.;
+
+  if(sampling_flag && fix_ste->integrate_every() > 1)
+  {
+    if(fix_ste->integration_step())
+      flux_weight = static_cast<double>(fix_ste->integrate_every());
+    else if(cpl && cpl->capturing())
+      cpl_flag = 1;
+    else return;
+  }
+
+  // use contacts recorded by the pair style if available
+  if(pair_gran->contact_buffer_valid())
+  {
+    post_force_eval_contact_buffer(vflag,cpl_flag);
+    return;
+  }
+
   //template function for using touchflag or not
-  if(history_flag == 0) post_force_eval<0>(vflag,0);
-  if(history_flag == 1) post_force_eval<1>(vflag,0);
+  if(history_flag == 0) post_force_eval<0>(vflag,cpl_flag);
+  if(history_flag == 1) post_force_eval<1>(vflag,cpl_flag);
 
 }
 
@@ -176,24 +220,67 @@ void FixHeatGranCond::post_force(int vflag){
 void FixHeatGranCond::cpl_evaluate(ComputePairGranLocal *caller)
 {
   if(caller != cpl) error->all(FLERR,"Illegal situation in FixHeatGranCond::cpl_evaluate");
+  if(pair_gran->contact_buffer_valid())
+  {
+    post_force_eval_contact_buffer(0,1);
+    return;
+  }
   if(history_flag == 0) post_force_eval<0>(0,1);
   if(history_flag == 1) post_force_eval<1>(0,1);
 }
 
+/* ----------------------------------------------------------------------
+   heat flux through the contact of i and j at center distance r
+------------------------------------------------------------------------- */
+
+inline void FixHeatGranCond::eval_contact(int i,int j,double radi,double radj,double r,
+                                          int nlocal,int newton_pair,int cpl_flag,int addflag)
+{
+  double hc,contactArea,delta_n,flux,tcoi,tcoj;
+  int *type = atom->type;
+
+  if(area_correction_flag)
+  {
+    double radsum = radi + radj;
+    delta_n = radsum - r;
+    delta_n *= deltan_ratio[type[i]-1][type[j]-1];
+    r = radsum - delta_n;
+  }
+
+  contactArea = - M_PI/4 * ( (r-radi-radj)*(r+radi-radj)*(r-radi+radj)*(r+radi+radj) )/(r*r); //contact area of the two spheres
+
+  tcoi = conductivity[type[i]-1];
+  tcoj = conductivity[type[j]-1];
+  if (tcoi < SMALL || tcoj < SMALL) hc = 0.;
+  else hc = 4.*tcoi*tcoj/(tcoi+tcoj)*sqrt(contactArea);
+
+  flux = (Temp[j]-Temp[i])*hc;
+
+  if(!cpl_flag)
+  {
+    heatFlux[i] += flux_weight*flux;
+    if (newton_pair || j < nlocal) heatFlux[j] -= flux_weight*flux;
+  }
+
+  if(addflag) cpl->add_heat(i,j,flux);
+}
+
 /* ---------------------------------------------------------------------- */
 
 template <int HISTFLAG>
 void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
 {
-  double hc,contactArea,delta_n,flux;
   int i,j,ii,jj,inum,jnum;
   double xtmp,ytmp,ztmp,delx,dely,delz;
-  double radi,radj,radsum,rsq,r,rinv,rsqinv,tcoi,tcoj;
+  double radi,radj,radsum,rsq;
   int *ilist,*jlist,*numneigh,**firstneigh;
   int *touch,**firsttouch;
 
   int newton_pair = force->newton_pair;
 
+  // compute pair/gran/local also gets the fluxes if it records contacts
+  int addflag = cpl && (cpl_flag || cpl->capturing());
+
   if (strcmp(force->pair_style,"hybrid")==0)
     error->warning(FLERR,"Fix heat/gran/conduction implementation may not be valid for pair style hybrid");
   if (strcmp(force->pair_style,"hybrid/overlay")==0)
@@ -208,7 +295,6 @@ void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
   double *radius = atom->radius;
   double *rmass = atom->rmass;
   double **x = atom->x;
-  int *type = atom->type;
   int nlocal = atom->nlocal;
   int *mask = atom->mask;
 
@@ -253,36 +339,54 @@ void FixHeatGranCond::post_force_eval(int vflag,int cpl_flag)
           radsum = radi + radj;
         }
 
-        r = sqrt(rsq);
+        eval_contact(i,j,radi,radj,sqrt(rsq),nlocal,newton_pair,cpl_flag,addflag);
+      }
+    }
+  }
 
-        if(area_correction_flag)
-        {
-          delta_n = radsum - r;
-          delta_n *= deltan_ratio[type[i]-1][type[j]-1];
-          r = radsum - delta_n;
-        }
+  if(newton_pair && !cpl_flag) fix_heatFlux->request_reverse_comm();
+}
 
-        contactArea = - M_PI/4 * ( (r-radi-radj)*(r+radi-radj)*(r-radi+radj)*(r+radi+radj) )/(r*r); //contact area of the two spheres
+/* ----------------------------------------------------------------------
+   same as post_force_eval(), but loops over the touching pairs the pair
+   style recorded in its force pass instead of the neighbor list
+------------------------------------------------------------------------- */
 
-        tcoi = conductivity[type[i]-1];
-        tcoj = conductivity[type[j]-1];
-        if (tcoi < SMALL || tcoj < SMALL) hc = 0.;
-        else hc = 4.*tcoi*tcoj/(tcoi+tcoj)*sqrt(contactArea);
+void FixHeatGranCond::post_force_eval_contact_buffer(int vflag,int cpl_flag)
+{
+  int i,j,n;
 
-        flux = (Temp[j]-Temp[i])*hc;
+  int newton_pair = force->newton_pair;
 
-        if(!cpl_flag)
-        {
-          heatFlux[i] += flux;
-          if (newton_pair || j < nlocal) heatFlux[j] -= flux;
-        }
+  // compute pair/gran/local also gets the fluxes if it records contacts
+  int addflag = cpl && (cpl_flag || cpl->capturing());
 
-        if(cpl_flag && cpl) cpl->add_heat(i,j,flux);
-      }
-    }
+  if (strcmp(force->pair_style,"hybrid")==0)
+    error->warning(FLERR,"Fix heat/gran/conduction implementation may not be valid for pair style hybrid");
+  if (strcmp(force->pair_style,"hybrid/overlay")==0)
+    error->warning(FLERR,"Fix heat/gran/conduction implementation may not be valid for pair style hybrid/overlay");
+
+  int ncontacts = pair_gran->n_contact_buffer();
+  int *ci = pair_gran->contact_buffer_i();
+  int *cj = pair_gran->contact_buffer_j();
+  double *cr = pair_gran->contact_buffer_r();
+
+  double *radius = atom->radius;
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  updatePtrs();
+
+  for (n = 0; n < ncontacts; n++) {
+    i = ci[n];
+    j = cj[n];
+
+    if (!(mask[i] & groupbit) && !(mask[j] & groupbit)) continue;
+
+    eval_contact(i,j,radius[i],radius[j],cr[n],nlocal,newton_pair,cpl_flag,addflag);
   }
 
-  if(newton_pair) fix_heatFlux->do_reverse_comm();
+  if(newton_pair && !cpl_flag) fix_heatFlux->request_reverse_comm();
 }
 
 /* ----------------------------------------------------------------------
@@ -49,6 +49,8 @@ namespace LAMMPS_NS {
 
   private:
     template <int> void post_force_eval(int,int);
+    void post_force_eval_contact_buffer(int,int);
+    inline void eval_contact(int,int,double,double,double,int,int,int,int);
 
     class FixPropertyGlobal* fix_conductivity;
     double *conductivity;
@@ -56,6 +58,11 @@ namespace LAMMPS_NS {
     // for heat transfer area correction
     int area_correction_flag;
     double const* const* deltan_ratio;
+
+    // with super-stepping, evaluate only on integration steps and
+    // weight the flux with the # of steps per cycle
+    int sampling_flag;
+    double flux_weight;
   };
 
 }
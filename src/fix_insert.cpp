@@ -36,6 +36,7 @@
 #include "fix_particledistribution_discrete.h"
 #include "fix_template_sphere.h"
 #include "fix_insert.h"
+#include "hash_grid.h"
 #include "math_extra_liggghts.h"
 #include "mpi_liggghts.h"
 #include "vector_liggghts.h"
@@ -78,6 +79,7 @@ FixInsert::FixInsert(LAMMPS *lmp, int narg, char **arg) :
   init_defaults();
 
   xnear = NULL;
+  xnear_grid = new HashGrid(lmp);
 
   // parse args
   
@@ -258,6 +260,7 @@ FixInsert::FixInsert(LAMMPS *lmp, int narg, char **arg) :
 FixInsert::~FixInsert()
 {
   delete random;
+  delete xnear_grid;
   delete [] recvcounts;
   delete [] displs;
 }
@@ -700,7 +703,9 @@ int FixInsert::count_nnear()
 }
 
 /* ----------------------------------------------------------------------
-   fill xnear with nearby particles
+   fill xnear with nearby particles and set up grid over xnear
+   grid cell size is max sum of radii of a sphere to insert and any
+   sphere in xnear, inserted spheres are added to the grid by the pti
 ------------------------------------------------------------------------- */
 
 int FixInsert::load_xnear(int ninsert_this_local)
@@ -714,7 +719,8 @@ int FixInsert::load_xnear(int ninsert_this_local)
 
   // xnear is for my atoms + atoms to be inserted
   
-  memory->create(xnear,nspheres_near_local + ninsert_this_local*fix_distribution->max_nspheres(), 4, "FixInsert::xnear");
+  int nmax = nspheres_near_local + ninsert_this_local*fix_distribution->max_nspheres();
+  memory->create(xnear,nmax, 4, "FixInsert::xnear");
 
   // load up xnear array with local and ghosts
 
@@ -723,6 +729,7 @@ int FixInsert::load_xnear(int ninsert_this_local)
   int nall = atom->nlocal + atom->nghost;
 
   int ncount = 0;
+  double radmax = maxrad;
   for (int i = 0; i < nall; i++)
   {
     if (is_nearby(i))
@@ -731,10 +738,15 @@ int FixInsert::load_xnear(int ninsert_this_local)
       xnear[ncount][1] = x[i][1];
       xnear[ncount][2] = x[i][2];
       xnear[ncount][3] = radius[i];
+      radmax = MathExtraLiggghts::max(radmax,radius[i]);
       ncount++;
     }
   }
 
+  xnear_grid->reset(nmax,maxrad+radmax);
+  for (int i = 0; i < ncount; i++)
+    xnear_grid->add(xnear,i);
+
   return nspheres_near_local;
 }
 
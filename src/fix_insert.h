@@ -117,6 +117,9 @@ class FixInsert : public Fix {
   int nspheres_near;
   double **xnear;
 
+  // grid over xnear for overlap check
+  class HashGrid *xnear_grid;
+
   // velocity and ang vel distribution
   // currently constant for omega - could also be a distribution
   int    v_randomSetting;
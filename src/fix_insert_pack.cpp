@@ -422,7 +422,7 @@ void FixInsertPack::x_v_omega(int ninsert_this_local,int &ninserted_this_local,
                     v_toInsert[2] = v_insert[2] + v_insertFluct[2] * random->gaussian();
                 }
 
-                nins = pti->check_near_set_x_v_omega(pos,v_toInsert,omega_insert,quat_insert,xnear,nspheres_near);
+                nins = pti->check_near_set_x_v_omega(pos,v_toInsert,omega_insert,quat_insert,xnear,nspheres_near,xnear_grid);
 
             }
 
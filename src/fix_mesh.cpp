@@ -55,6 +55,7 @@ FixMesh::FixMesh(LAMMPS *lmp, int narg, char **arg)
   manipulated_(false),
   verbose_(false),
   autoRemoveDuplicates_(false),
+  rigidFrame_(false),
   precision_(0.)
 {
     if(narg < 5)
@@ -104,6 +105,15 @@ FixMesh::FixMesh(LAMMPS *lmp, int narg, char **arg)
                 error->fix_error(FLERR,this,"expecing 'auto_remove_duplicates' or 'no' for 'heal'");
             iarg_ += 2;
             hasargs = true;
+        } else if(strcmp(arg[iarg_],"rigid_frame") == 0) {
+            if(narg < iarg_+2)
+                error->fix_error(FLERR,this,"not enough arguments for 'rigid_frame'");
+            if(strcmp(arg[iarg_+1],"yes") == 0)
+              rigidFrame_ = true;
+            else if(strcmp(arg[iarg_+1],"no"))
+                error->fix_error(FLERR,this,"expecing 'yes' or 'no' for 'rigid_frame'");
+            iarg_ += 2;
+            hasargs = true;
         } else if (strcmp(arg[iarg_],"precision") == 0) {
             if (narg < iarg_+2) error->fix_error(FLERR,this,"not enough arguments");
             iarg_++;
@@ -121,6 +131,14 @@ FixMesh::FixMesh(LAMMPS *lmp, int narg, char **arg)
     if(modify->have_restart_data(this)) create_mesh_restart();
     else create_mesh(mesh_fname);
 
+    // moving mesh keeps its nodes and accumulates rigid transformation
+    if(rigidFrame_)
+    {
+        if(strcmp(style,"mesh/surface/stress/deform") == 0)
+            error->fix_error(FLERR,this,"'rigid_frame' can not be used for a deforming mesh");
+        mesh_->setRigidFrame();
+    }
+
     // parse further args
 
     hasargs = true;
@@ -445,6 +463,8 @@ void FixMesh::box_extent(double &xlo,double &xhi,double &ylo,double &yhi,double
     int size = mesh()->size();
     int numNodes = mesh()->numNodes();
 
+    mesh()->updateRigidFrame();
+
     for(int i = 0; i < size; i++)
     {
         
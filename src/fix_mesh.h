@@ -105,6 +105,9 @@ namespace LAMMPS_NS
         // flags and params to be passed to the mesh
         bool verbose_,autoRemoveDuplicates_;
 
+        // flag if moving mesh uses rigid frame
+        bool rigidFrame_;
+
         // mesh precision
         double precision_;
   };
@@ -34,7 +34,7 @@
 #include "force.h"
 #include "bounding_box.h"
 #include "input_mesh_tri.h"
-#include "fix_contact_history.h"
+#include "fix_contact_history_mesh.h"
 #include "fix_neighlist_mesh.h"
 #include "multi_node_mesh.h"
 #include "modify.h"
@@ -53,7 +53,8 @@ FixMeshSurface::FixMeshSurface(LAMMPS *lmp, int narg, char **arg)
   stress_flag_(false),
   velFlag_(false),
   angVelFlag_(false),
-  curvature_(0.)
+  curvature_(0.),
+  packedGeometry_(true)
 {
     // check if type has been read
     if(atom_type_mesh_ == -1)
@@ -100,6 +101,14 @@ FixMeshSurface::FixMeshSurface(LAMMPS *lmp, int narg, char **arg)
             error->fix_error(FLERR,this,"0° < curvature < 60° required");
           curvature_ = cos(curvature_*M_PI/180.);
           hasargs = true;
+      } else if (strcmp(arg[iarg_],"packed_geometry") == 0) {
+          if (narg < iarg_+2) error->fix_error(FLERR,this,"not enough arguments for 'packed_geometry'");
+          if(strcmp(arg[iarg_+1],"no") == 0)
+              packedGeometry_ = false;
+          else if(strcmp(arg[iarg_+1],"yes"))
+              error->fix_error(FLERR,this,"expecing 'yes' or 'no' for 'packed_geometry'");
+          iarg_ += 2;
+          hasargs = true;
       } else if(strcmp(style,"mesh/surface") == 0) {
           char *errmsg = new char[strlen(arg[iarg_])+50];
           sprintf(errmsg,"unknown keyword or wrong keyword order: %s", arg[iarg_]);
@@ -125,6 +134,9 @@ void FixMeshSurface::post_create()
     if(curvature_ > 0.)
         triMesh()->setCurvature(curvature_);
 
+    if(!packedGeometry_)
+        triMesh()->setPackedGeometry(false);
+
     if(velFlag_ && angVelFlag_)
         error->fix_error(FLERR,this,"cannot use 'surface_vel' and 'surface_ang_vel' together");
 
@@ -246,7 +258,7 @@ void FixMeshSurface::createContactHistory(int dnum)
 
     modify->add_fix(6,fixarg);
 
-    fix_contact_history_ = static_cast<FixContactHistory*>(modify->find_fix_id(contacthist_name));
+    fix_contact_history_ = static_cast<FixContactHistoryMesh*>(modify->find_fix_id(contacthist_name));
 
     delete []fixarg;
     delete []contacthist_name;
@@ -37,7 +37,7 @@ FixStyle(mesh/surface/planar,FixMeshSurface)
 
 #include "fix_mesh.h"
 #include "tri_mesh.h"
-#include "fix_contact_history.h"
+#include "fix_contact_history_mesh.h"
 #include "fix_neighlist_mesh.h"
 #include "custom_value_tracker.h"
 
@@ -70,7 +70,7 @@ namespace LAMMPS_NS
         inline int atomTypeWall()
         { return atom_type_mesh_;}
 
-        inline class FixContactHistory* contactHistory()
+        inline class FixContactHistoryMesh* contactHistory()
         { return fix_contact_history_;}
 
         inline class FixNeighlistMesh* meshNeighlist()
@@ -84,7 +84,7 @@ namespace LAMMPS_NS
 
       protected:
 
-        class FixContactHistory *fix_contact_history_;
+        class FixContactHistoryMesh *fix_contact_history_;
         class FixNeighlistMesh *fix_mesh_neighlist_;
 
         // flag for stressanalysis
@@ -107,6 +107,9 @@ namespace LAMMPS_NS
 
         // mesh curvature
         double curvature_;
+
+        // flag if per-element geometry is packed for contact
+        bool packedGeometry_;
   };
 
 } /* namespace LAMMPS_NS */
@@ -222,6 +222,19 @@ void FixMeshSurfaceStress::final_integrate()
 
 void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
                                 double *delta,int iTri,double *v_wall)
+{
+    add_particle_contribution_thr(ip,frc,delta,iTri,v_wall,f_total_,torque_total_);
+}
+
+/* ----------------------------------------------------------------------
+   as above, but total force and torque go to caller-provided accumulators
+   used by threaded wall force calc, where each thread owns a set of
+   triangles and reduces its accumulators via add_total_contribution_thr()
+------------------------------------------------------------------------- */
+
+void FixMeshSurfaceStress::add_particle_contribution_thr(int ip,double *frc,
+                                double *delta,int iTri,double *v_wall,
+                                double *f_total_thr,double *torque_total_thr)
 {
     double E,c[3],v_rel[3],cmag,vmag,cos_gamma,sin_gamma,sin_2gamma,tan_gamma;
     double contactPoint[3],surfNorm[3], tmp[3], tmp2[3];
@@ -242,11 +255,11 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
 
         // add contribution to total body force and torque
         vectorAdd3D(x,delta,contactPoint);
-        vectorAdd3D(f_total_,frc,f_total_);
+        vectorAdd3D(f_total_thr,frc,f_total_thr);
         vectorSubtract3D(contactPoint,p_ref_(0),tmp);
         
         vectorCross3D(tmp,frc,tmp2); // tmp2 is torque contrib
-        vectorAdd3D(torque_total_,tmp2,torque_total_);
+        vectorAdd3D(torque_total_thr,tmp2,torque_total_thr);
     }
 
     // add wear if applicable
@@ -264,6 +277,8 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
 
         // get surface normal
         triMesh()->surfaceNorm(iTri,surfNorm);
+        if(triMesh()->isRigidFrame())
+            triMesh()->rigidToWorld(surfNorm);
 
         sin_gamma = MathExtraLiggghts::abs(vectorDot3D(v_rel,surfNorm)) / (vmag);
         
@@ -288,6 +303,14 @@ void FixMeshSurfaceStress::add_particle_contribution(int ip,double *frc,
     }
 }
 
+/* ---------------------------------------------------------------------- */
+
+void FixMeshSurfaceStress::add_total_contribution_thr(double *f_total_thr,double *torque_total_thr)
+{
+    vectorAdd3D(f_total_,f_total_thr,f_total_);
+    vectorAdd3D(torque_total_,torque_total_thr,torque_total_);
+}
+
 /* ----------------------------------------------------------------------
    add external force (such as gravity)
    called by all procs, only proc0 adds
@@ -336,10 +359,15 @@ void FixMeshSurfaceStress::calc_total_force()
         MPI_Sum_Vector(f_total_,3,world);
         MPI_Sum_Vector(torque_total_,3,world);
         
+        // surface norm of mesh in rigid frame needs to be rotated
+        bool rigidFrame = triMesh()->isRigidFrame();
+
         for(int i = 0; i < nTri; i++)
         {
             // get element surface norm and area
             triMesh()->surfaceNorm(i,surfNorm);
+            if(rigidFrame)
+                triMesh()->rigidToWorld(surfNorm);
             invSurfArea = 1./triMesh()->areaElem(i);
 
             // calculate normal force
@@ -59,6 +59,10 @@ namespace LAMMPS_NS
 
         virtual void add_particle_contribution(int ip, double *frc,
                             double *delta, int iTri, double *v_wall);
+        void add_particle_contribution_thr(int ip, double *frc,
+                            double *delta, int iTri, double *v_wall,
+                            double *f_total_thr, double *torque_total_thr);
+        void add_total_contribution_thr(double *f_total_thr, double *torque_total_thr);
 
         void add_global_external_contribution(double *frc);
         void add_global_external_contribution(double *frc,double *trq);
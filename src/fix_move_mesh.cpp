@@ -165,8 +165,14 @@ void FixMoveMesh::initial_integrate(int dummy)
 
     if(move_->isFirst())
     {
-        v = mesh_->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v");
-        v->setAll(0.);
+        // mesh in rigid frame: per-node velocity is set on demand
+        if(mesh_->isRigidFrame())
+            mesh_->zeroRigidVelocity();
+        else
+        {
+            v = mesh_->prop().getElementProperty<MultiVectorContainer<double,3,3> >("v");
+            v->setAll(0.);
+        }
     }
 
     // integration
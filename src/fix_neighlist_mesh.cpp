@@ -34,17 +34,61 @@
 #include "atom.h"
 #include "vector_liggghts.h"
 #include "update.h"
+#include "memory.h"
+#include "domain.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
 #define SMALL_DELTA skin/(70.*M_PI)
+#define DELTA_PAIRS 1024
+
+// bin key and triangle, used to sort entries of the bin->triangle cache
+
+struct BinTriEntry {
+  bigint key;
+  int iTri;
+};
+
+static int bintricompare(const void *a, const void *b)
+{
+  const BinTriEntry *ea = static_cast<const BinTriEntry*>(a);
+  const BinTriEntry *eb = static_cast<const BinTriEntry*>(b);
+  if(ea->key < eb->key) return -1;
+  if(ea->key > eb->key) return 1;
+  return ea->iTri - eb->iTri;
+}
 
 FixNeighlistMesh::FixNeighlistMesh(LAMMPS *lmp, int narg, char **arg)
 : Fix(lmp,narg,arg),
   buildNeighList(false),
-  movingMesh(false)
+  movingMesh(false),
+  cacheBuilt(false),
+  nCacheTri(0),
+  nCacheBins(0),
+  nCacheEntries(0),
+  cacheExtent(0.),
+  cacheBinsize(0.),
+  cacheNx(0),
+  cacheNy(0),
+  cacheCenter(NULL),
+  cacheBinKey(NULL),
+  cacheBinStart(NULL),
+  cacheBinTri(NULL),
+  maxPairs(0),
+  pairTri(NULL),
+  pairAtom(NULL),
+  nBlock(0),
+  maxBlock(0),
+  blockAtom(NULL),
+  blockIn(NULL),
+  blockX(NULL),
+  blockY(NULL),
+  blockZ(NULL),
+  blockR(NULL)
 {
     if(!modify->find_fix_id(arg[3]) || !dynamic_cast<FixMeshSurface*>(modify->find_fix_id(arg[3])))
         error->fix_error(FLERR,this,"illegal caller");
@@ -57,6 +101,18 @@ FixNeighlistMesh::FixNeighlistMesh(LAMMPS *lmp, int narg, char **arg)
 
 FixNeighlistMesh::~FixNeighlistMesh()
 {
+    memory->destroy(cacheCenter);
+    memory->destroy(cacheBinKey);
+    memory->destroy(cacheBinStart);
+    memory->destroy(cacheBinTri);
+    memory->destroy(pairTri);
+    memory->destroy(pairAtom);
+    memory->destroy(blockAtom);
+    memory->destroy(blockIn);
+    memory->destroy(blockX);
+    memory->destroy(blockY);
+    memory->destroy(blockZ);
+    memory->destroy(blockR);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -88,7 +144,9 @@ void FixNeighlistMesh::initializeNeighlist()
 
 void FixNeighlistMesh::setup_pre_force(int foo)
 {
-    
+    // mesh may have been re-parallelized or cutoffs may have changed
+    cacheBuilt = false;
+
     pre_neighbor();
     pre_force(0);
 }
@@ -133,8 +191,11 @@ void FixNeighlistMesh::pre_force(int vflag)
     x = atom->x;
     r = atom->radius;
 
-    if(neighbor->style != 1)
-        error->all(FLERR,"Please use style 'bin' in the 'neighbor' command together with triangular walls");
+    // with style multi, moving meshes scan the bins of each radius level
+    // of the granular neighbor list, see handleTriangle()
+
+    if(neighbor->style == 0)
+        error->all(FLERR,"Please use style 'bin' or 'multi' in the 'neighbor' command together with triangular walls");
 
     double rmax = 0.5*(neighbor->cutneighmax - neighbor->skin);
     if(movingMesh)
@@ -157,10 +218,308 @@ void FixNeighlistMesh::pre_force(int vflag)
 
     int nall = mesh_->sizeLocal() + mesh_->sizeGhost();
 
+    // non-moving mesh: look up candidate triangles for each particle
+    // from the cached bin->triangle lists
+
+    if(!movingMesh)
+    {
+      double extent = r ? distmax : (distmax+skin);
+      if(!binTriCacheValid(extent))
+        buildBinTriCache(extent);
+      buildFromBinTriCache();
+      return;
+    }
+
     for(int iTri = 0; iTri < nall; iTri++)
       handleTriangle(iTri);
 }
 
+/* ----------------------------------------------------------------------
+   cache is valid as long as the triangles and the subdomain have not
+   changed (re-parallelization of the mesh may change the local triangles)
+------------------------------------------------------------------------- */
+
+bool FixNeighlistMesh::binTriCacheValid(double extent)
+{
+    if(!cacheBuilt || extent != cacheExtent)
+      return false;
+
+    for(int dim = 0; dim < 3; dim++)
+      if(domain->sublo[dim] != cacheSublo[dim] || domain->subhi[dim] != cacheSubhi[dim])
+        return false;
+
+    int nall = mesh_->sizeLocal() + mesh_->sizeGhost();
+    if(nall != nCacheTri)
+      return false;
+
+    double c[3];
+    for(int iTri = 0; iTri < nall; iTri++)
+    {
+      mesh_->center(iTri,c);
+      if(c[0] != cacheCenter[iTri][0] || c[1] != cacheCenter[iTri][1] || c[2] != cacheCenter[iTri][2])
+        return false;
+    }
+
+    return true;
+}
+
+/* ----------------------------------------------------------------------
+   sort triangles into bins of size cutneighmax
+   a triangle goes to all bins overlapping its bounding box extended by
+   extent and clipped to the subdomain plus skin, bins farther than extent
+   from the plane of the triangle are skipped
+------------------------------------------------------------------------- */
+
+void FixNeighlistMesh::buildBinTriCache(double extent)
+{
+    int nall = mesh_->sizeLocal() + mesh_->sizeGhost();
+    double node[3],sn[3],delta[3];
+
+    cacheExtent = extent;
+    cacheBinsize = neighbor->cutneighmax;
+    nCacheTri = nall;
+    vectorCopy3D(domain->sublo,cacheSublo);
+    vectorCopy3D(domain->subhi,cacheSubhi);
+
+    // owned particles are inside the subdomain when the list is built
+    double subLo[3],subHi[3];
+    for(int dim = 0; dim < 3; dim++)
+    {
+      subLo[dim] = domain->sublo[dim] - neighbor->skin;
+      subHi[dim] = domain->subhi[dim] + neighbor->skin;
+    }
+
+    // max distance from bin center to a point in the bin
+    double binHalfDiag = 0.5*sqrt(3.)*cacheBinsize;
+
+    memory->destroy(cacheCenter);
+    memory->create(cacheCenter,nall > 0 ? nall : 1,3,"neighlist/mesh:cacheCenter");
+
+    memory->destroy(cacheBinKey);
+    memory->destroy(cacheBinStart);
+    memory->destroy(cacheBinTri);
+    cacheBuilt = true;
+
+    if(nall == 0)
+    {
+      nCacheBins = nCacheEntries = 0;
+      cacheNx = cacheNy = 0;
+      return;
+    }
+
+    // bounding box of all triangles, extended by extent
+    // and clipped to the subdomain plus skin
+
+    BoundingBox bAll;
+    for(int iTri = 0; iTri < nall; iTri++)
+    {
+      mesh_->center(iTri,cacheCenter[iTri]);
+      for(int iNode = 0; iNode < 3; iNode++)
+      {
+        mesh_->node(iTri,iNode,node);
+        bAll.extendToContain(node);
+      }
+    }
+
+    cacheLo[0] = MathExtraLiggghts::max(bAll.xLo - extent,subLo[0]);
+    cacheLo[1] = MathExtraLiggghts::max(bAll.yLo - extent,subLo[1]);
+    cacheLo[2] = MathExtraLiggghts::max(bAll.zLo - extent,subLo[2]);
+    double cacheHi[3];
+    cacheHi[0] = MathExtraLiggghts::min(bAll.xHi + extent,subHi[0]);
+    cacheHi[1] = MathExtraLiggghts::min(bAll.yHi + extent,subHi[1]);
+    cacheHi[2] = MathExtraLiggghts::min(bAll.zHi + extent,subHi[2]);
+    cacheNx = static_cast<bigint>(MathExtraLiggghts::max(cacheHi[0] - cacheLo[0],0.)/cacheBinsize) + 1;
+    cacheNy = static_cast<bigint>(MathExtraLiggghts::max(cacheHi[1] - cacheLo[1],0.)/cacheBinsize) + 1;
+
+    // collect (bin,triangle) entries
+
+    int nEntries = 0, maxEntries = 0;
+    BinTriEntry *entries = NULL;
+
+    for(int iTri = 0; iTri < nall; iTri++)
+    {
+      BoundingBox b;
+      for(int iNode = 0; iNode < 3; iNode++)
+      {
+        mesh_->node(iTri,iNode,node);
+        b.extendToContain(node);
+      }
+
+      double lo[3],hi[3];
+      lo[0] = MathExtraLiggghts::max(b.xLo - extent,cacheLo[0]);
+      lo[1] = MathExtraLiggghts::max(b.yLo - extent,cacheLo[1]);
+      lo[2] = MathExtraLiggghts::max(b.zLo - extent,cacheLo[2]);
+      hi[0] = MathExtraLiggghts::min(b.xHi + extent,cacheHi[0]);
+      hi[1] = MathExtraLiggghts::min(b.yHi + extent,cacheHi[1]);
+      hi[2] = MathExtraLiggghts::min(b.zHi + extent,cacheHi[2]);
+
+      // triangle not near the subdomain
+      if(lo[0] > hi[0] || lo[1] > hi[1] || lo[2] > hi[2])
+        continue;
+
+      int ixMin = static_cast<int>((lo[0] - cacheLo[0])/cacheBinsize);
+      int ixMax = static_cast<int>((hi[0] - cacheLo[0])/cacheBinsize);
+      int iyMin = static_cast<int>((lo[1] - cacheLo[1])/cacheBinsize);
+      int iyMax = static_cast<int>((hi[1] - cacheLo[1])/cacheBinsize);
+      int izMin = static_cast<int>((lo[2] - cacheLo[2])/cacheBinsize);
+      int izMax = static_cast<int>((hi[2] - cacheLo[2])/cacheBinsize);
+
+      mesh_->surfaceNorm(iTri,sn);
+      mesh_->node(iTri,0,node);
+      double planeMax = binHalfDiag + extent;
+
+      for(int iz = izMin; iz <= izMax; iz++)
+        for(int iy = iyMin; iy <= iyMax; iy++)
+          for(int ix = ixMin; ix <= ixMax; ix++)
+          {
+            // distance of bin center to the plane of the triangle
+            delta[0] = cacheLo[0] + (ix+0.5)*cacheBinsize - node[0];
+            delta[1] = cacheLo[1] + (iy+0.5)*cacheBinsize - node[1];
+            delta[2] = cacheLo[2] + (iz+0.5)*cacheBinsize - node[2];
+            if(fabs(vectorDot3D(delta,sn)) > planeMax)
+              continue;
+
+            if(nEntries == maxEntries)
+            {
+              maxEntries += DELTA_PAIRS;
+              entries = static_cast<BinTriEntry*>(memory->srealloc(entries,maxEntries*sizeof(BinTriEntry),"neighlist/mesh:entries"));
+            }
+            entries[nEntries].key = (iz*cacheNy + iy)*cacheNx + ix;
+            entries[nEntries].iTri = iTri;
+            nEntries++;
+          }
+    }
+
+    if(nEntries > 0)
+      qsort(entries,nEntries,sizeof(BinTriEntry),bintricompare);
+
+    // compress to occupied bins
+
+    nCacheBins = 0;
+    for(int i = 0; i < nEntries; i++)
+      if(i == 0 || entries[i].key != entries[i-1].key)
+        nCacheBins++;
+
+    nCacheEntries = nEntries;
+
+    memory->create(cacheBinKey,nCacheBins > 0 ? nCacheBins : 1,"neighlist/mesh:cacheBinKey");
+    memory->create(cacheBinStart,nCacheBins+1,"neighlist/mesh:cacheBinStart");
+    memory->create(cacheBinTri,nEntries > 0 ? nEntries : 1,"neighlist/mesh:cacheBinTri");
+
+    int iBin = -1;
+    for(int i = 0; i < nEntries; i++)
+    {
+      if(i == 0 || entries[i].key != entries[i-1].key)
+      {
+        iBin++;
+        cacheBinKey[iBin] = entries[i].key;
+        cacheBinStart[iBin] = i;
+      }
+      cacheBinTri[i] = entries[i].iTri;
+    }
+    cacheBinStart[nCacheBins] = nEntries;
+
+    memory->sfree(entries);
+}
+
+/* ----------------------------------------------------------------------
+   index of cached bin containing pos, -1 if no triangle is near
+------------------------------------------------------------------------- */
+
+int FixNeighlistMesh::cacheBinLookup(double *pos)
+{
+    if(nCacheBins == 0)
+      return -1;
+
+    double dx = pos[0] - cacheLo[0];
+    double dy = pos[1] - cacheLo[1];
+    double dz = pos[2] - cacheLo[2];
+    if(dx < 0. || dy < 0. || dz < 0.)
+      return -1;
+
+    bigint ix = static_cast<bigint>(dx/cacheBinsize);
+    bigint iy = static_cast<bigint>(dy/cacheBinsize);
+    bigint iz = static_cast<bigint>(dz/cacheBinsize);
+    if(ix >= cacheNx || iy >= cacheNy)
+      return -1;
+
+    bigint key = (iz*cacheNy + iy)*cacheNx + ix;
+
+    // binary search in sorted bin keys
+
+    int lo = 0, hi = nCacheBins-1;
+    while(lo <= hi)
+    {
+      int mid = (lo+hi)/2;
+      if(cacheBinKey[mid] < key) lo = mid+1;
+      else if(cacheBinKey[mid] > key) hi = mid-1;
+      else return mid;
+    }
+    return -1;
+}
+
+/* ----------------------------------------------------------------------
+   loop owned particles, test against triangles cached for their bin
+   result is stored per triangle as in handleTriangle()
+------------------------------------------------------------------------- */
+
+void FixNeighlistMesh::buildFromBinTriCache()
+{
+    int *mask = atom->mask;
+    int nlocal = atom->nlocal;
+    int nall = mesh_->sizeLocal() + mesh_->sizeGhost();
+    int nPairs = 0;
+
+    numContacts.addUninitialized(nall);
+    int *nCont = numContacts.begin();
+    for(int iTri = 0; iTri < nall; iTri++)
+      nCont[iTri] = 0;
+
+    for(int iAtom = 0; iAtom < nlocal; iAtom++)
+    {
+      if(!(mask[iAtom] & groupbit))
+        continue;
+
+      int iBin = cacheBinLookup(x[iAtom]);
+      if(iBin < 0)
+        continue;
+
+      for(int j = cacheBinStart[iBin]; j < cacheBinStart[iBin+1]; j++)
+      {
+        int iTri = cacheBinTri[j];
+        if(!mesh_->resolveTriSphereNeighbuild(iTri,r ? r[iAtom] : 0. ,x[iAtom],r ? skin : (distmax+skin)))
+          continue;
+
+        if(nPairs == maxPairs)
+        {
+          maxPairs += DELTA_PAIRS;
+          memory->grow(pairTri,maxPairs,"neighlist/mesh:pairTri");
+          memory->grow(pairAtom,maxPairs,"neighlist/mesh:pairAtom");
+        }
+        pairTri[nPairs] = iTri;
+        pairAtom[nPairs] = iAtom;
+        nPairs++;
+        nCont[iTri]++;
+      }
+    }
+
+    // scatter pairs to per-triangle lists
+
+    contactList.addUninitialized(nPairs);
+    int *cList = contactList.begin();
+
+    int *offset = NULL;
+    memory->create(offset,nall+1,"neighlist/mesh:offset");
+    offset[0] = 0;
+    for(int iTri = 0; iTri < nall; iTri++)
+      offset[iTri+1] = offset[iTri] + nCont[iTri];
+
+    for(int i = 0; i < nPairs; i++)
+      cList[offset[pairTri[i]]++] = pairAtom[i];
+
+    memory->destroy(offset);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixNeighlistMesh::handleTriangle(int iTri)
@@ -180,8 +539,41 @@ void FixNeighlistMesh::handleTriangle(int iTri)
 
     int numContTmp = 0;
 
+    // radius levels of neighbor style multi: scan the level bins around
+    // the element, extended only by the largest radius of each level
+    if(nlocal && neighbor->nlevels > 0 && neighbor->levelbinned && r)
+    {
+        for(int l = 0; l < neighbor->nlevels; l++)
+        {
+          double delta = neighbor->rmaxlevel[l] + skin + SMALL_DELTA;
+          lo[0] = b.xLo-delta; lo[1] = b.yLo-delta; lo[2] = b.zLo-delta;
+          hi[0] = b.xHi+delta; hi[1] = b.yHi+delta; hi[2] = b.zHi+delta;
+          neighbor->coord2bin_level(lo,l,ixMin,iyMin,izMin);
+          neighbor->coord2bin_level(hi,l,ixMax,iyMax,izMax);
+
+          Neighbor::LevelBins &lb = neighbor->levelbin[l];
+          ixMin = MAX(ixMin,0); ixMax = MIN(ixMax,lb.mbinx-1);
+          iyMin = MAX(iyMin,0); iyMax = MIN(iyMax,lb.mbiny-1);
+          izMin = MAX(izMin,0); izMax = MIN(izMax,lb.mbinz-1);
+
+          for(int iz=izMin;iz<=izMax;iz++)
+            for(int iy=iyMin;iy<=iyMax;iy++)
+              for(int ix=ixMin;ix<=ixMax;ix++)
+              {
+                int iBin = lb.offset + (iz*lb.mbiny + iy)*lb.mbinx + ix;
+                for(int iAtom = neighbor->levelhead[iBin]; iAtom != -1 && iAtom < nlocal; iAtom = neighbor->levelbins[iAtom])
+                {
+                  if(! (mask[iAtom] & groupbit))
+                    continue;
+
+                  addToBlock(iAtom,r[iAtom]);
+                }
+              }
+        }
+        numContTmp = flushBlock(iTri,skin);
+    }
     // only do this if I own particles
-    if(nlocal)
+    else if(nlocal)
     {
         for(int ix=ixMin;ix<=ixMax;ix++)
           for(int iy=iyMin;iy<=iyMax;iy++)
@@ -200,16 +592,13 @@ void FixNeighlistMesh::handleTriangle(int iTri)
                     continue;
                 }
 
-                if(mesh_->resolveTriSphereNeighbuild(iTri,r ? r[iAtom] : 0. ,x[iAtom],r ? skin : (distmax+skin) ))
-                {
-                  
-                  numContTmp++;
-                  contactList.add(iAtom);
-                }
+                addToBlock(iAtom,r ? r[iAtom] : 0.);
+
                 if(bins) iAtom = bins[iAtom];
                 else iAtom = -1;
               }
             }
+        numContTmp = flushBlock(iTri,r ? skin : (distmax+skin));
     }
 
     numContacts.add(numContTmp);
@@ -217,6 +606,50 @@ void FixNeighlistMesh::handleTriangle(int iTri)
     return;
 }
 
+/* ----------------------------------------------------------------------
+   collect candidate particles of a triangle, test them in one batch
+   accepted particles are added to the contact list in order
+------------------------------------------------------------------------- */
+
+void FixNeighlistMesh::addToBlock(int iAtom, double rad)
+{
+    if(nBlock == maxBlock)
+    {
+      maxBlock += DELTA_PAIRS;
+      memory->grow(blockAtom,maxBlock,"neighlist/mesh:blockAtom");
+      memory->grow(blockIn,maxBlock,"neighlist/mesh:blockIn");
+      memory->grow(blockX,maxBlock,"neighlist/mesh:blockX");
+      memory->grow(blockY,maxBlock,"neighlist/mesh:blockY");
+      memory->grow(blockZ,maxBlock,"neighlist/mesh:blockZ");
+      memory->grow(blockR,maxBlock,"neighlist/mesh:blockR");
+    }
+
+    blockAtom[nBlock] = iAtom;
+    blockX[nBlock] = x[iAtom][0];
+    blockY[nBlock] = x[iAtom][1];
+    blockZ[nBlock] = x[iAtom][2];
+    blockR[nBlock] = rad;
+    nBlock++;
+}
+
+int FixNeighlistMesh::flushBlock(int iTri, double treshold)
+{
+    int nAccepted = 0;
+
+    mesh_->resolveTriSphereNeighbuildBatch(iTri,nBlock,blockX,blockY,blockZ,blockR,treshold,blockIn);
+
+    for(int j = 0; j < nBlock; j++)
+    {
+      if(!blockIn[j])
+        continue;
+      nAccepted++;
+      contactList.add(blockAtom[j]);
+    }
+
+    nBlock = 0;
+    return nAccepted;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixNeighlistMesh::getBinBoundariesFromBoundingBox(BoundingBox &b,
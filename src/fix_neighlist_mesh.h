@@ -36,6 +36,7 @@ FixStyle(neighlist/mesh,FixNeighlistMesh)
 
 #include "fix.h"
 #include "container.h"
+#include "lmptype.h"
 
 namespace LAMMPS_NS
 {
@@ -65,6 +66,12 @@ class FixNeighlistMesh : public Fix
     void getBinBoundariesFromBoundingBox(class BoundingBox &b,
         int &ixMin,int &ixMax,int &iyMin,int &iyMax,int &izMin,int &izMax);
 
+    // neigh list build for non-moving mesh via cached bin->triangle lists
+    bool binTriCacheValid(double extent);
+    void buildBinTriCache(double extent);
+    void buildFromBinTriCache();
+    int cacheBinLookup(double *pos);
+
     class FixMeshSurface *caller_;
     class TriMesh *mesh_;
 
@@ -81,6 +88,28 @@ class FixNeighlistMesh : public Fix
     double **x, *r;
 
     bool movingMesh;
+
+    // cached triangle lists of non-moving mesh, bins of size cacheBinsize
+    // only occupied bins are stored, sorted by bin key
+    bool cacheBuilt;
+    int nCacheTri, nCacheBins, nCacheEntries;
+    double cacheExtent, cacheBinsize, cacheLo[3];
+    double cacheSublo[3], cacheSubhi[3];   // subdomain the cache was built for
+    bigint cacheNx, cacheNy;
+    double **cacheCenter;   // triangle centers the cache was built for
+    bigint *cacheBinKey;
+    int *cacheBinStart, *cacheBinTri;
+
+    // particle-triangle pairs found during build
+    int maxPairs;
+    int *pairTri, *pairAtom;
+
+    // block of candidate particles of a triangle for batched test
+    int nBlock, maxBlock;
+    int *blockAtom, *blockIn;
+    double *blockX, *blockY, *blockZ, *blockR;
+    void addToBlock(int iAtom, double rad);
+    int flushBlock(int iTri, double treshold);
 };
 
 } /* namespace LAMMPS_NS */
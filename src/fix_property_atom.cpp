@@ -232,6 +232,24 @@ void FixPropertyAtom::do_reverse_comm()
    timer->stamp(TIME_COMM);
 }
 
+/* ----------------------------------------------------------------------
+   same as do_forward_comm() / do_reverse_comm(), but the comm is
+   batched with all other requests of the current timestep phase
+   use only if the ghost data is not needed before the phase ends
+------------------------------------------------------------------------- */
+
+void FixPropertyAtom::request_forward_comm()
+{
+    if (commGhost) modify->request_forward_comm(this);
+    else error->all(FLERR,"FixPropertyAtom: Faulty implementation - forward_comm invoked, but not registered");
+}
+
+void FixPropertyAtom::request_reverse_comm()
+{
+    if (commGhostRev) modify->request_reverse_comm(this);
+    else error->all(FLERR,"FixPropertyAtom: Faulty implementation - reverse_comm invoked, but not registered");
+}
+
 /* ----------------------------------------------------------------------
    memory usage of local atom-based arrays
 ------------------------------------------------------------------------- */
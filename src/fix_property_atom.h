@@ -48,6 +48,8 @@ class FixPropertyAtom : public Fix {
 
   void do_forward_comm();
   void do_reverse_comm();
+  void request_forward_comm();
+  void request_reverse_comm();
 
   Fix* check_fix(const char *varname,const char *svmstyle,int len1,int len2,const char *caller,bool errflag);
 
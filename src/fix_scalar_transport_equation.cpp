@@ -82,10 +82,34 @@ FixScalarTransportEquation::FixScalarTransportEquation(LAMMPS *lmp, int narg, ch
   {
       capacity_flag = 1;
       capacity_name = new char[strlen(arg[iarg])+1];
-      strcpy(capacity_name,arg[iarg++]);
+      strcpy(capacity_name,arg[iarg]);
+  }
+  iarg++;
+
+  integrate_every_ = 1;
+  flux_sum_name = NULL;
+
+  while(iarg < narg)
+  {
+      if(strcmp(arg[iarg],"integrate_every") == 0)
+      {
+          if(iarg+2 > narg) error->fix_error(FLERR,this,"not enough arguments for keyword 'integrate_every'");
+          integrate_every_ = atoi(arg[iarg+1]);
+          if(integrate_every_ < 1) error->fix_error(FLERR,this,"'integrate_every' > 0 required");
+          iarg += 2;
+      }
+      else error->fix_error(FLERR,this,"unknown keyword");
+  }
+
+  if(integrate_every_ > 1)
+  {
+      flux_sum_name = new char[strlen(flux_name)+4];
+      sprintf(flux_sum_name,"%sSum",flux_name);
   }
 
   fix_quantity = fix_flux = fix_source = NULL; fix_capacity = NULL;
+  fix_flux_sum = NULL;
+  flux_sum = NULL;
   capacity = NULL;
 
   peratom_flag = 1;              
@@ -105,6 +129,7 @@ FixScalarTransportEquation::~FixScalarTransportEquation()
     delete []source_name;
     delete []capacity_name;
     delete []equation_id;
+    delete []flux_sum_name;
 
     if(capacity) delete []capacity;
     
@@ -116,6 +141,7 @@ void FixScalarTransportEquation::pre_delete(bool unfixflag)
     if (fix_quantity) modify->delete_fix(quantity_name);
     if (fix_flux) modify->delete_fix(flux_name);
     if (fix_source) modify->delete_fix(source_name);
+    if (fix_flux_sum) modify->delete_fix(flux_sum_name);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -137,6 +163,7 @@ void FixScalarTransportEquation::updatePtrs()
   quantity = fix_quantity->vector_atom;
   flux = fix_flux->vector_atom;
   source = fix_source->vector_atom;
+  if(fix_flux_sum) flux_sum = fix_flux_sum->vector_atom;
 
   vector_atom = quantity; 
 }
@@ -194,6 +221,21 @@ void FixScalarTransportEquation::post_create()
     fix_source=static_cast<FixPropertyAtom*>(modify->find_fix_property(source_name,"property/atom","scalar",0,0,style));
   }
 
+  if (fix_flux_sum==NULL && integrate_every_ > 1){
+    //register sum of flux over integration cycle as property/atom
+    fixarg[0]=flux_sum_name;
+    fixarg[1]="all";
+    fixarg[2]="property/atom";
+    fixarg[3]=flux_sum_name;
+    fixarg[4]="scalar"; 
+    fixarg[5]="yes";    
+    fixarg[6]="no";    
+    fixarg[7]="no";    
+    fixarg[8]="0.";     
+    modify->add_fix(9,fixarg);
+    fix_flux_sum=static_cast<FixPropertyAtom*>(modify->find_fix_property(flux_sum_name,"property/atom","scalar",0,0,style));
+  }
+
   delete []fixarg;
 
   updatePtrs();
@@ -245,7 +287,9 @@ void FixScalarTransportEquation::initial_integrate(int vflag)
            flux[i]=0.;
   }
 
-  fix_quantity->do_forward_comm();
+  // quantity only changes at the end of an integration cycle
+  if(cycle_start() || update->ntimestep == update->firststep+1)
+      fix_quantity->request_forward_comm();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -254,7 +298,7 @@ void FixScalarTransportEquation::pre_force(int vflag)
 {
     
     if(neighbor->ago == 0)
-        fix_quantity->do_forward_comm();
+        fix_quantity->request_forward_comm();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -270,7 +314,27 @@ void FixScalarTransportEquation::final_integrate()
 
     updatePtrs();
 
-    fix_source->do_forward_comm();
+    // with super-stepping, sum up the flux of each step and integrate
+    // the sum at the end of the cycle, source is applied for all steps
+
+    double *fl = flux;
+    double nsteps = 1.;
+
+    if(integrate_every_ > 1)
+    {
+        for (int i = 0; i < nlocal; i++)
+        {
+           if (mask[i] & groupbit)
+              flux_sum[i] += flux[i];
+        }
+
+        if(!integration_step()) return;
+
+        fl = flux_sum;
+        nsteps = static_cast<double>(integrate_every_);
+    }
+
+    fix_source->request_forward_comm();
 
     if(capacity_flag)
     {
@@ -278,7 +342,7 @@ void FixScalarTransportEquation::final_integrate()
         {
            if (mask[i] & groupbit){
               capacity = fix_capacity->compute_vector(type[i]-1);
-              if(fabs(capacity) > SMALL) quantity[i] += (flux[i] + source[i]) * dt / (rmass[i]*capacity);
+              if(fabs(capacity) > SMALL) quantity[i] += (fl[i] + nsteps*source[i]) * dt / (rmass[i]*capacity);
            }
         }
     }
@@ -287,10 +351,35 @@ void FixScalarTransportEquation::final_integrate()
         for (int i = 0; i < nlocal; i++)
         {
            if (mask[i] & groupbit){
-              quantity[i] += (flux[i] + source[i]) * dt;
+              quantity[i] += (fl[i] + nsteps*source[i]) * dt;
            }
         }
     }
+
+    if(integrate_every_ > 1)
+    {
+        for (int i = 0; i < nlocal; i++)
+           flux_sum[i] = 0.;
+    }
+}
+
+/* ----------------------------------------------------------------------
+   true on the last step of an integration cycle, when quantity is updated
+   true on every step without super-stepping
+------------------------------------------------------------------------- */
+
+bool FixScalarTransportEquation::integration_step()
+{
+    return update->ntimestep % integrate_every_ == 0;
+}
+
+/* ----------------------------------------------------------------------
+   true on the first step of an integration cycle
+------------------------------------------------------------------------- */
+
+bool FixScalarTransportEquation::cycle_start()
+{
+    return (update->ntimestep-1) % integrate_every_ == 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -47,6 +47,11 @@ class FixScalarTransportEquation : public Fix {
   double compute_scalar();
   bool match_equation_id(const char*);
 
+  // thermal super-stepping: quantity is integrated every this many steps
+  inline int integrate_every()
+  { return integrate_every_; }
+  bool integration_step();
+
  private:
   int nlevels_respa;
 
@@ -70,6 +75,13 @@ class FixScalarTransportEquation : public Fix {
   double *flux;       
   double *source;     
 
+  // flux summed over the steps of one integration cycle
+  int integrate_every_;
+  class FixPropertyAtom* fix_flux_sum;
+  char *flux_sum_name;
+  double *flux_sum;
+
+  bool cycle_start();
 };
 
 }
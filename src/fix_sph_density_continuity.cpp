@@ -52,6 +52,8 @@ using namespace FixConst;
 FixSphDensityContinuity::FixSphDensityContinuity(LAMMPS *lmp, int narg, char **arg) :
   FixSph(lmp, narg, arg)
 {
+  eval_kernel = NULL;
+
   int iarg = 0;
 
   if (iarg+3 > narg) error->all(FLERR,"Illegal fix sph/density/continuity command");
@@ -108,6 +110,8 @@ void FixSphDensityContinuity::init()
 {
   FixSph::init();
 
+  select_eval_kernel();
+
   // check if there is an nve/sph fix present
 
   int idx_integ = -1;
@@ -127,13 +131,32 @@ void FixSphDensityContinuity::init()
 void FixSphDensityContinuity::pre_force(int vflag)
 {
   //template function for using per atom or per atomtype smoothing length
-  if (mass_type) pre_force_eval<1>(vflag);
-  else pre_force_eval<0>(vflag);
+  (this->*eval_kernel)(vflag);
+}
+
+/* ----------------------------------------------------------------------
+   pick the pre_force_eval() instantiation for mass_type and kernel
+------------------------------------------------------------------------- */
+
+void FixSphDensityContinuity::select_eval_kernel()
+{
+  eval_kernel = NULL;
+
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) \
+    eval_kernel = mass_type ? &FixSphDensityContinuity::pre_force_eval<1,id> : &FixSphDensityContinuity::pre_force_eval<0,id>;
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+
+  if (!eval_kernel) error->fix_error(FLERR,this,"unknown sph kernel");
 }
 
 /* ---------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG,int KERNEL>
 void FixSphDensityContinuity::pre_force_eval(int vflag)
 {
   int i,j,ii,jj,inum,jnum,itype,jtype;
@@ -224,7 +247,7 @@ void FixSphDensityContinuity::pre_force_eval(int vflag)
       delVDotDelR = rinv * ( delx*(v[i][0]-v[j][0]) + dely*(v[i][1]-v[j][1]) + delz*(v[i][2]-v[j][2]) );
 
       // calculate value for magnitude of grad W
-      gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+      gradWmag = SPH_KERNEL_NS::sph_kernel_der<KERNEL>(s,slCom,slComInv);
 
       // add contribution of neighbor
       // have a half neigh list, so do it for both if necessary
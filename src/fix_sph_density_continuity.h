@@ -47,7 +47,12 @@ class FixSphDensityContinuity : public FixSph {
   void pre_force(int);
 
  private:
-  template <int> void pre_force_eval(int);
+  template <int,int> void pre_force_eval(int);
+
+  // pre_force_eval() instantiation for mass_type and kernel, set in init()
+  typedef void (FixSphDensityContinuity::*FnPtrEval)(int);
+  FnPtrEval eval_kernel;
+  void select_eval_kernel();
   double calcDensityDer(double, double, double);
 
 };
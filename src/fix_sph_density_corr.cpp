@@ -53,6 +53,8 @@ using namespace FixConst;
 FixSphDensityCorr::FixSphDensityCorr(LAMMPS *lmp, int narg, char **arg) :
   FixSph(lmp, narg, arg)
 {
+  eval_kernel = NULL;
+
   int iarg = 0;
   if (narg < iarg+4) error->fix_error(FLERR,this,"Illegal fix sph/density/corr command, not enough arguments");
 
@@ -181,6 +183,8 @@ void FixSphDensityCorr::post_create()
 void FixSphDensityCorr::init()
 {
   FixSph::init();
+
+  select_eval_kernel();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -188,13 +192,32 @@ void FixSphDensityCorr::init()
 void FixSphDensityCorr::post_integrate()
 {
   //template function for using per atom or per atomtype smoothing length
-  if (mass_type) post_integrate_eval<1>();
-  else post_integrate_eval<0>();
+  (this->*eval_kernel)();
+}
+
+/* ----------------------------------------------------------------------
+   pick the post_integrate_eval() instantiation for mass_type and kernel
+------------------------------------------------------------------------- */
+
+void FixSphDensityCorr::select_eval_kernel()
+{
+  eval_kernel = NULL;
+
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) \
+    eval_kernel = mass_type ? &FixSphDensityCorr::post_integrate_eval<1,id> : &FixSphDensityCorr::post_integrate_eval<0,id>;
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+
+  if (!eval_kernel) error->fix_error(FLERR,this,"unknown sph kernel");
 }
 
 /* ---------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG,int KERNEL>
 void FixSphDensityCorr::post_integrate_eval()
 {
   int i,j,ii,jj,inum,jnum,itype,jtype;
@@ -243,7 +266,7 @@ void FixSphDensityCorr::post_integrate_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+        W = SPH_KERNEL_NS::sph_kernel<KERNEL>(0.,sli,sliInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -308,7 +331,7 @@ void FixSphDensityCorr::post_integrate_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
+        W = SPH_KERNEL_NS::sph_kernel<KERNEL>(s,slCom,slComInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -340,7 +363,7 @@ void FixSphDensityCorr::post_integrate_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+        W = SPH_KERNEL_NS::sph_kernel<KERNEL>(0.,sli,sliInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -410,7 +433,7 @@ void FixSphDensityCorr::post_integrate_eval()
 
         // this gets a value for W at self, perform error check
 
-        W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
+        W = SPH_KERNEL_NS::sph_kernel<KERNEL>(s,slCom,slComInv);
         if (W < 0.)
         {
           fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -52,7 +52,12 @@ class FixSphDensityCorr : public FixSph {
   virtual void post_integrate();
 
  private:
-  template <int> void post_integrate_eval();
+  template <int,int> void post_integrate_eval();
+
+  // post_integrate_eval() instantiation for mass_type and kernel, set in init()
+  typedef void (FixSphDensityCorr::*FnPtrEval)();
+  FnPtrEval eval_kernel;
+  void select_eval_kernel();
 
   class FixPropertyAtom* fix_quantity;
   char *quantity_name;
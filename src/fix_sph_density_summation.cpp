@@ -54,6 +54,8 @@ using namespace FixConst;
 FixSPHDensitySum::FixSPHDensitySum(LAMMPS *lmp, int narg, char **arg) :
   FixSph(lmp, narg, arg)
 {
+  eval_kernel = NULL;
+
   int iarg = 0;
 
   if (iarg+3 > narg) error->fix_error(FLERR,this,"Not enough input arguments");
@@ -108,6 +110,8 @@ void FixSPHDensitySum::init()
 {
   FixSph::init();
 
+  select_eval_kernel();
+
   // check if there is an sph/pressure fix present
   // must come before me, because
   // a - it needs the rho for the pressure calculation
@@ -136,13 +140,32 @@ void FixSPHDensitySum::init()
 void FixSPHDensitySum::post_integrate()
 {
   //template function for using per atom or per atomtype smoothing length
-  if (mass_type) post_integrate_eval<1>();
-  else post_integrate_eval<0>();
+  (this->*eval_kernel)();
+}
+
+/* ----------------------------------------------------------------------
+   pick the post_integrate_eval() instantiation for mass_type and kernel
+------------------------------------------------------------------------- */
+
+void FixSPHDensitySum::select_eval_kernel()
+{
+  eval_kernel = NULL;
+
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) \
+    eval_kernel = mass_type ? &FixSPHDensitySum::post_integrate_eval<1,id> : &FixSPHDensitySum::post_integrate_eval<0,id>;
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+
+  if (!eval_kernel) error->fix_error(FLERR,this,"unknown sph kernel");
 }
 
 /* ---------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG,int KERNEL>
 void FixSPHDensitySum::post_integrate_eval()
 {
   int i,j,ii,jj,inum,jnum,itype,jtype;
@@ -178,7 +201,7 @@ void FixSPHDensitySum::post_integrate_eval()
 
     // this gets a value for W at self, perform error check
 
-    W = SPH_KERNEL_NS::sph_kernel(kernel_id,0.,sli,sliInv);
+    W = SPH_KERNEL_NS::sph_kernel<KERNEL>(0.,sli,sliInv);
     if (W < 0.)
     {
       fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -252,7 +275,7 @@ void FixSPHDensitySum::post_integrate_eval()
 
       // this gets a value for W at self, perform error check
 
-      W = SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv);
+      W = SPH_KERNEL_NS::sph_kernel<KERNEL>(s,slCom,slComInv);
       if (W < 0.)
       {
         fprintf(screen,"s = %f, W = %f\n",s,W);
@@ -47,7 +47,12 @@ class FixSPHDensitySum : public FixSph {
   virtual void post_integrate();
 
  private:
-  template <int> void post_integrate_eval();
+  template <int,int> void post_integrate_eval();
+
+  // post_integrate_eval() instantiation for mass_type and kernel, set in init()
+  typedef void (FixSPHDensitySum::*FnPtrEval)();
+  FnPtrEval eval_kernel;
+  void select_eval_kernel();
 
 };
 
@@ -32,7 +32,7 @@
 #include "pair_gran.h"
 #include "fix_rigid.h"
 #include "fix_mesh.h"
-#include "fix_contact_history.h"
+#include "fix_contact_history_mesh.h"
 #include "modify.h"
 #include "respa.h"
 #include "memory.h"
@@ -50,10 +50,16 @@
 #include "mpi_liggghts.h"
 #include "neighbor.h"
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 using namespace LAMMPS_NS;
 using namespace FixConst;
 using namespace LAMMPS_NS::PRIMITIVE_WALL_DEFINITIONS;
 
+#define DELTA_CONTACTS_THR 1024
+
 /* ---------------------------------------------------------------------- */
 
 FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
@@ -96,6 +102,18 @@ FixWallGran::FixWallGran(LAMMPS *lmp, int narg, char **arg) :
 
     meshwall_ = -1;
 
+    nNeighMax_thr_ = nContactsMax_thr_ = nTriMax_thr_ = nThreadsMax_thr_ = 0;
+    neighOffset_thr_ = NULL;
+    neighDeltan_thr_ = NULL;
+    neighDelta_thr_ = neighBary_thr_ = NULL;
+    contactNeigh_thr_ = contactTri_thr_ = NULL;
+    contactOrder_thr_ = threadOffset_thr_ = NULL;
+    contactVwall_thr_ = contactFpw_thr_ = NULL;
+
+    nBlockMax_ = 0;
+    blockCand_ = NULL;
+    blockX_ = blockY_ = blockZ_ = blockR_ = NULL;
+
     // parse args
     //style = new char[strlen(arg[2])+2];
     //strcpy(style,arg[2]);
@@ -305,6 +323,22 @@ FixWallGran::~FixWallGran()
 {
     if(primitiveWall_ != 0) delete primitiveWall_;
     if(FixMesh_list_) delete []FixMesh_list_;
+
+    memory->destroy(neighOffset_thr_);
+    memory->destroy(neighDeltan_thr_);
+    memory->destroy(neighDelta_thr_);
+    memory->destroy(neighBary_thr_);
+    memory->destroy(contactNeigh_thr_);
+    memory->destroy(contactTri_thr_);
+    memory->destroy(contactOrder_thr_);
+    memory->destroy(threadOffset_thr_);
+    memory->destroy(contactVwall_thr_);
+    memory->destroy(contactFpw_thr_);
+    memory->destroy(blockCand_);
+    memory->destroy(blockX_);
+    memory->destroy(blockY_);
+    memory->destroy(blockZ_);
+    memory->destroy(blockR_);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -428,7 +462,9 @@ void FixWallGran::post_force(int vflag)
     computeflag_ = 1;
     shearupdate_ = 1;
     if (update->setupflag) shearupdate_ = 0;
-    addflag_ = 0;
+
+    // hand contacts to compute wall/gran/local if it is due on this step
+    addflag_ = (cwl_ && cwl_->begin_capture()) ? 1 : 0;
 
     post_force_wall(vflag);
 }
@@ -508,7 +544,7 @@ void FixWallGran::post_force_mesh(int vflag)
     {
       TriMesh *mesh = FixMesh_list_[iMesh]->triMesh();
       nTriAll = mesh->sizeLocal() + mesh->sizeGhost();
-      FixContactHistory *fix_contact = FixMesh_list_[iMesh]->contactHistory();
+      FixContactHistoryMesh *fix_contact = FixMesh_list_[iMesh]->contactHistory();
 
       // mark all contacts for delettion at this point
       
@@ -524,21 +560,71 @@ void FixWallGran::post_force_mesh(int vflag)
 
       atom_type_wall_ = FixMesh_list_[iMesh]->atomTypeWall();
 
+#if defined(_OPENMP)
+      // threaded version, compute wall/gran/local is not thread-safe
+      if(comm->nthreads > 1 && !(cwl_ && addflag_))
+      {
+        post_force_mesh_thr(iMesh,mesh,fix_contact,neighborList,numNeigh,nTriAll,vMeshC ? vMeshC->begin() : 0);
+        if(fix_contact) fix_contact->cleanUpContacts();
+        continue;
+      }
+#endif
+
+      // moving mesh in rigid frame
+      // contact is resolved in the frame of the mesh
+      if(mesh->isRigidFrame())
+      {
+        double xMesh[3],contactPoint[3];
+
+        // loop owned and ghost triangles
+        for(int iTri = 0; iTri < nTriAll; iTri++)
+        {
+          // sort out particles that can not touch the triangle in one batch
+          pack_mesh_block(mesh,iTri,neighborList,numNeigh[iTri],0,true);
+
+          for(int iCont = 0; iCont < numNeigh[iTri]; iCont++,neighborList++)
+          {
+            int iPart = *neighborList;
+
+            // do not need to handle ghost particles
+            if(iPart >= nlocal || !blockCand_[iCont]) continue;
+
+            int idTri = mesh->id(iTri);
+
+            mesh->rigidToMeshFrame(x_[iPart],xMesh);
+            deltan = mesh->resolveTriSphereContact(iTri,radius_ ? radius_[iPart]:r0_,xMesh,delta);
+
+            if(deltan <= 0.)
+            {
+              if(fix_contact && ! fix_contact->handleContact(iPart,idTri,c_history)) continue;
+
+              mesh->rigidToWorld(delta);
+              vectorAdd3D(x_[iPart],delta,contactPoint);
+              mesh->rigidVelocity(contactPoint,v_wall);
+
+              post_force_eval_contact(iPart,deltan,delta,v_wall,c_history,iMesh,FixMesh_list_[iMesh],mesh,iTri);
+            }
+          }
+        }
+      }
       // moving mesh
-      if(vMeshC)
+      else if(vMeshC)
       {
         vMesh = vMeshC->begin();
 
         // loop owned and ghost triangles
         for(int iTri = 0; iTri < nTriAll; iTri++)
         {
+          // sort out particles that can not touch the triangle in one batch
+          pack_mesh_block(mesh,iTri,neighborList,numNeigh[iTri],0,false);
+
           for(int iCont = 0; iCont < numNeigh[iTri]; iCont++,neighborList++)
           {
             
             int iPart = *neighborList;
 
             // do not need to handle ghost particles
-            if(iPart >= nlocal) continue;
+            if(iPart >= nlocal || !blockCand_[iCont]) continue;
 
             int idTri = mesh->id(iTri);
 
@@ -568,13 +654,15 @@ void FixWallGran::post_force_mesh(int vflag)
         // loop owned and ghost particles
         for(int iTri = 0; iTri < nTriAll; iTri++)
         {
-          
+          // sort out particles that can not touch the triangle in one batch
+          pack_mesh_block(mesh,iTri,neighborList,numNeigh[iTri],0,false);
+
           for(int iCont = 0; iCont < numNeigh[iTri]; iCont++,neighborList++)
           {
             int iPart = *neighborList;
 
             // do not need to handle ghost particles
-            if(iPart >= nlocal) continue;
+            if(iPart >= nlocal || !blockCand_[iCont]) continue;
 
             int idTri = mesh->id(iTri);
             deltan = mesh->resolveTriSphereContact(iTri,radius_ ? radius_[iPart]:r0_,x_[iPart],delta);
@@ -600,6 +688,300 @@ void FixWallGran::post_force_mesh(int vflag)
 
 }
 
+/* ----------------------------------------------------------------------
+   pack particles in the neighbor list of a triangle to block position
+   offset and mark those that can not touch the triangle
+   for mesh in rigid frame, positions are packed in the frame of the mesh
+------------------------------------------------------------------------- */
+
+void FixWallGran::grow_mesh_block(int n)
+{
+    if(n <= nBlockMax_) return;
+
+    nBlockMax_ = n;
+    memory->destroy(blockCand_);
+    memory->destroy(blockX_);
+    memory->destroy(blockY_);
+    memory->destroy(blockZ_);
+    memory->destroy(blockR_);
+    memory->create(blockCand_,nBlockMax_,"wall/gran:blockCand_");
+    memory->create(blockX_,nBlockMax_,"wall/gran:blockX_");
+    memory->create(blockY_,nBlockMax_,"wall/gran:blockY_");
+    memory->create(blockZ_,nBlockMax_,"wall/gran:blockZ_");
+    memory->create(blockR_,nBlockMax_,"wall/gran:blockR_");
+}
+
+void FixWallGran::pack_mesh_block(TriMesh *mesh, int iTri, int *neighs, int n, int offset, bool rigidFrame)
+{
+    double xMesh[3];
+
+    grow_mesh_block(offset+n);
+
+    for(int k = 0; k < n; k++)
+    {
+        const int iPart = neighs[k];
+        double *pos = x_[iPart];
+        if(rigidFrame)
+        {
+            mesh->rigidToMeshFrame(x_[iPart],xMesh);
+            pos = xMesh;
+        }
+        blockX_[offset+k] = pos[0];
+        blockY_[offset+k] = pos[1];
+        blockZ_[offset+k] = pos[2];
+        blockR_[offset+k] = radius_ ? radius_[iPart] : r0_;
+    }
+
+    mesh->resolveTriSphereContactBatch(iTri,n,&blockX_[offset],&blockY_[offset],&blockZ_[offset],
+                                       &blockR_[offset],&blockCand_[offset]);
+}
+
+#if defined(_OPENMP)
+
+/* ----------------------------------------------------------------------
+   post_force for mesh wall, OpenMP version
+
+   1) contact detection, threads partition the triangles
+   2) contact history lookup, serial in the same order as post_force_mesh()
+      since the coplanar contact logic depends on the order
+   3) force evaluation, threads partition the particles so that forces,
+      torques and per-contact data are written without conflicts and the
+      contacts of a particle are evaluated in the same order as in serial
+   4) stress and wear, threads partition the triangles (contacts are
+      sorted by triangle), total force and torque are reduced at the end
+   5) heat flux, serial
+------------------------------------------------------------------------- */
+
+void FixWallGran::post_force_mesh_thr(int iMesh, TriMesh *mesh, FixContactHistoryMesh *fix_contact,
+                                      int *neighborList, int *numNeigh, int nTriAll, double ***vMesh)
+{
+    FixMeshSurface *fix_mesh = FixMesh_list_[iMesh];
+    const int nlocal = atom->nlocal;
+    const int nthreads = comm->nthreads;
+
+    // moving mesh in rigid frame, contact is resolved in the frame of the mesh
+    const bool rigidFrame = mesh->isRigidFrame();
+
+    // offset of each triangle in the neighbor list
+
+    if(nTriAll+1 > nTriMax_thr_)
+    {
+        nTriMax_thr_ = nTriAll+1;
+        memory->destroy(neighOffset_thr_);
+        memory->create(neighOffset_thr_,nTriMax_thr_,"wall/gran:neighOffset_thr_");
+    }
+
+    int nNeighAll = 0;
+    for(int iTri = 0; iTri < nTriAll; iTri++)
+    {
+        neighOffset_thr_[iTri] = nNeighAll;
+        nNeighAll += numNeigh[iTri];
+    }
+    neighOffset_thr_[nTriAll] = nNeighAll;
+
+    grow_mesh_block(nNeighAll);
+
+    if(nNeighAll > nNeighMax_thr_)
+    {
+        nNeighMax_thr_ = nNeighAll;
+        memory->destroy(neighDeltan_thr_);
+        memory->destroy(neighDelta_thr_);
+        memory->destroy(neighBary_thr_);
+        memory->create(neighDeltan_thr_,nNeighMax_thr_,"wall/gran:neighDeltan_thr_");
+        memory->create(neighDelta_thr_,nNeighMax_thr_,3,"wall/gran:neighDelta_thr_");
+        memory->create(neighBary_thr_,nNeighMax_thr_,3,"wall/gran:neighBary_thr_");
+    }
+
+    // 1) contact detection
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,16)
+    for(int iTri = 0; iTri < nTriAll; iTri++)
+    {
+        // sort out particles that can not touch the triangle in one batch
+        const int offset = neighOffset_thr_[iTri];
+        pack_mesh_block(mesh,iTri,&neighborList[offset],numNeigh[iTri],offset,rigidFrame);
+
+        for(int j = neighOffset_thr_[iTri]; j < neighOffset_thr_[iTri+1]; j++)
+        {
+            const int iPart = neighborList[j];
+
+            // do not need to handle ghost particles
+            if(iPart >= nlocal || !blockCand_[j])
+            {
+                neighDeltan_thr_[j] = 1.;
+                continue;
+            }
+
+            const double rad = radius_ ? radius_[iPart] : r0_;
+            if(rigidFrame)
+            {
+                double xMesh[3];
+                mesh->rigidToMeshFrame(x_[iPart],xMesh);
+                neighDeltan_thr_[j] = mesh->resolveTriSphereContact(iTri,rad,xMesh,neighDelta_thr_[j]);
+                mesh->rigidToWorld(neighDelta_thr_[j]);
+            }
+            else if(vMesh)
+                neighDeltan_thr_[j] = mesh->resolveTriSphereContactBary(iTri,rad,x_[iPart],neighDelta_thr_[j],neighBary_thr_[j]);
+            else
+                neighDeltan_thr_[j] = mesh->resolveTriSphereContact(iTri,rad,x_[iPart],neighDelta_thr_[j]);
+        }
+    }
+
+    // 2) contact history, builds list of contacts to evaluate
+
+    int nContacts = 0;
+    for(int iTri = 0; iTri < nTriAll; iTri++)
+    {
+        for(int j = neighOffset_thr_[iTri]; j < neighOffset_thr_[iTri+1]; j++)
+        {
+            if(neighDeltan_thr_[j] > 0.) continue;
+
+            double *c_history = 0;
+            if(fix_contact && ! fix_contact->handleContact(neighborList[j],mesh->id(iTri),c_history)) continue;
+
+            if(nContacts == nContactsMax_thr_)
+            {
+                nContactsMax_thr_ += DELTA_CONTACTS_THR;
+                memory->grow(contactNeigh_thr_,nContactsMax_thr_,"wall/gran:contactNeigh_thr_");
+                memory->grow(contactTri_thr_,nContactsMax_thr_,"wall/gran:contactTri_thr_");
+                memory->grow(contactOrder_thr_,nContactsMax_thr_,"wall/gran:contactOrder_thr_");
+                memory->grow(contactVwall_thr_,nContactsMax_thr_,3,"wall/gran:contactVwall_thr_");
+                memory->grow(contactFpw_thr_,nContactsMax_thr_,3,"wall/gran:contactFpw_thr_");
+            }
+
+            contactNeigh_thr_[nContacts] = j;
+            contactTri_thr_[nContacts] = iTri;
+            nContacts++;
+        }
+    }
+
+    // a particle is owned by thread (iPart % nthreads)
+    // counting sort of the contacts by owning thread, stable so that the
+    // contacts of a particle keep their serial order
+
+    if(nthreads+1 > nThreadsMax_thr_)
+    {
+        nThreadsMax_thr_ = nthreads+1;
+        memory->destroy(threadOffset_thr_);
+        memory->create(threadOffset_thr_,nThreadsMax_thr_,"wall/gran:threadOffset_thr_");
+    }
+
+    for(int t = 0; t <= nthreads; t++)
+        threadOffset_thr_[t] = 0;
+    for(int iCont = 0; iCont < nContacts; iCont++)
+        threadOffset_thr_[neighborList[contactNeigh_thr_[iCont]] % nthreads + 1]++;
+    for(int t = 0; t < nthreads; t++)
+        threadOffset_thr_[t+1] += threadOffset_thr_[t];
+
+    // fill, threadOffset_thr_[t] is advanced to the end of slice t
+    // and then shifted back
+
+    for(int iCont = 0; iCont < nContacts; iCont++)
+        contactOrder_thr_[threadOffset_thr_[neighborList[contactNeigh_thr_[iCont]] % nthreads]++] = iCont;
+    for(int t = nthreads; t > 0; t--)
+        threadOffset_thr_[t] = threadOffset_thr_[t-1];
+    threadOffset_thr_[0] = 0;
+
+    const bool stress = stress_flag_ && fix_mesh->trackStress();
+
+    // 3) force evaluation, each thread evaluates the contacts of its particles
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+        const int tid = omp_get_thread_num();
+        double force_old[3];
+
+        for(int k = threadOffset_thr_[tid]; k < threadOffset_thr_[tid+1]; k++)
+        {
+            const int iCont = contactOrder_thr_[k];
+            const int j = contactNeigh_thr_[iCont];
+            const int iPart = neighborList[j];
+
+            const int iTri = contactTri_thr_[iCont];
+            const double deltan = neighDeltan_thr_[j];
+            double *delta = neighDelta_thr_[j];
+            double *v_wall = contactVwall_thr_[iCont];
+            double *c_history = fix_contact ? fix_contact->contactHistory(iPart,mesh->id(iTri)) : 0;
+
+            if(rigidFrame)
+            {
+                double contactPoint[3];
+                vectorAdd3D(x_[iPart],delta,contactPoint);
+                mesh->rigidVelocity(contactPoint,v_wall);
+            }
+            else if(vMesh)
+            {
+                const double *bary = neighBary_thr_[j];
+                for(int i = 0; i < 3; i++)
+                    v_wall[i] = (bary[0]*vMesh[iTri][0][i] + bary[1]*vMesh[iTri][1][i] + bary[2]*vMesh[iTri][2][i]);
+            }
+            else
+                vectorZeroize3D(v_wall);
+
+            const double delr = (radius_ ? radius_[iPart] : r0_) + deltan;
+            const double mass = rmass_ ? rmass_[iPart] : atom->mass[atom->type[iPart]];
+
+            if(store_force_ || stress)
+                vectorCopy3D(f_[iPart],force_old);
+
+            // deltan > 0 in compute_force
+            // but negative in distance algorithm
+            compute_force(iPart,-deltan,delr*delr,mass,-delta[0],-delta[1],-delta[2],v_wall,c_history,1.);
+
+            if(store_force_ || stress)
+            {
+                vectorSubtract3D(f_[iPart],force_old,contactFpw_thr_[iCont]);
+                if(store_force_)
+                    vectorCopy3D(contactFpw_thr_[iCont],wallforce_[iPart]);
+            }
+        }
+    }
+
+    // 4) stress and wear
+    // a thread owns a contiguous range of contacts not splitting a triangle
+
+    if(stress)
+    {
+        FixMeshSurfaceStress *fix_stress = static_cast<FixMeshSurfaceStress*>(fix_mesh);
+
+        #pragma omp parallel num_threads(nthreads)
+        {
+            const int tid = omp_get_thread_num();
+            int ifrom = static_cast<int>((static_cast<long>(nContacts)*tid)/nthreads);
+            int ito = static_cast<int>((static_cast<long>(nContacts)*(tid+1))/nthreads);
+            while(ifrom > 0 && ifrom < nContacts && contactTri_thr_[ifrom] == contactTri_thr_[ifrom-1]) ifrom++;
+            while(ito > 0 && ito < nContacts && contactTri_thr_[ito] == contactTri_thr_[ito-1]) ito++;
+
+            double f_total_thr[3],torque_total_thr[3];
+            vectorZeroize3D(f_total_thr);
+            vectorZeroize3D(torque_total_thr);
+
+            for(int iCont = ifrom; iCont < ito; iCont++)
+            {
+                const int j = contactNeigh_thr_[iCont];
+                fix_stress->add_particle_contribution_thr(neighborList[j],contactFpw_thr_[iCont],
+                    neighDelta_thr_[j],contactTri_thr_[iCont],contactVwall_thr_[iCont],f_total_thr,torque_total_thr);
+            }
+
+            #pragma omp critical
+            fix_stress->add_total_contribution_thr(f_total_thr,torque_total_thr);
+        }
+    }
+
+    // 5) heat flux
+
+    if(heattransfer_flag_)
+    {
+        for(int iCont = 0; iCont < nContacts; iCont++)
+        {
+            const int j = contactNeigh_thr_[iCont];
+            addHeatFlux(mesh,neighborList[j],neighDeltan_thr_[j],1.);
+        }
+    }
+}
+
+#endif
+
 /* ----------------------------------------------------------------------
    post_force for primitive wall
 ------------------------------------------------------------------------- */
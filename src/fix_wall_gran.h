@@ -157,8 +157,29 @@ class FixWallGran : public Fix {
   // max neigh cutoff - as in Neighbor
   double cutneighmax_;
 
+  // scratch for OpenMP mesh wall, per neighbor list entry and per contact
+  int nNeighMax_thr_, nContactsMax_thr_, nTriMax_thr_, nThreadsMax_thr_;
+  int *neighOffset_thr_;
+  double *neighDeltan_thr_, **neighDelta_thr_, **neighBary_thr_;
+  int *contactNeigh_thr_, *contactTri_thr_;
+  // contacts sorted by owning thread, contacts of thread t are
+  // contactOrder_thr_[threadOffset_thr_[t] ... threadOffset_thr_[t+1]-1]
+  int *contactOrder_thr_, *threadOffset_thr_;
+  double **contactVwall_thr_, **contactFpw_thr_;
+
+  // particles in the neighbor list of a triangle, packed for batched contact test
+  int nBlockMax_;
+  int *blockCand_;
+  double *blockX_, *blockY_, *blockZ_, *blockR_;
+  void grow_mesh_block(int n);
+  void pack_mesh_block(class TriMesh *mesh, int iTri, int *neighs, int n, int offset, bool rigidFrame);
+
   void post_force_wall(int vflag);
   void post_force_mesh(int);
+#if defined(_OPENMP)
+  void post_force_mesh_thr(int iMesh, class TriMesh *mesh, class FixContactHistoryMesh *fix_contact,
+                           int *neighborList, int *numNeigh, int nTriAll, double ***vMesh);
+#endif
   void post_force_primitive(int);
 
   inline void post_force_eval_contact(int iPart, double deltan, double *delta, double *v_wall,
@@ -0,0 +1,132 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#include "hash_grid.h"
+#include "memory.h"
+#include "error.h"
+#include "vector_liggghts.h"
+
+using namespace LAMMPS_NS;
+
+#define MIN_BUCKETS 64
+
+/* ---------------------------------------------------------------------- */
+
+HashGrid::HashGrid(LAMMPS *lmp) : Pointers(lmp),
+  cellsizeinv_(0.),
+  radmax_(0.),
+  nbucket_(0),
+  mask_(0),
+  nmax_(0),
+  head_(NULL),
+  next_(NULL)
+{
+}
+
+/* ---------------------------------------------------------------------- */
+
+HashGrid::~HashGrid()
+{
+    memory->destroy(head_);
+    memory->destroy(next_);
+}
+
+/* ----------------------------------------------------------------------
+   clear grid, make room for nmax spheres, set cell size
+   use about 2 buckets per sphere to keep the chains short
+------------------------------------------------------------------------- */
+
+void HashGrid::reset(int nmax, double cellsize)
+{
+    if(cellsize <= 0.)
+        error->one(FLERR,"HashGrid: cell size > 0 required");
+
+    cellsizeinv_ = 1./cellsize;
+    radmax_ = 0.;
+
+    int nbucket = MIN_BUCKETS;
+    while(nbucket < 2*nmax) nbucket *= 2;
+
+    if(nbucket > nbucket_)
+    {
+        nbucket_ = nbucket;
+        mask_ = nbucket_ - 1;
+        memory->destroy(head_);
+        memory->create(head_,nbucket_,"HashGrid:head_");
+    }
+
+    if(nmax > nmax_)
+    {
+        nmax_ = nmax;
+        memory->destroy(next_);
+        memory->create(next_,nmax_,"HashGrid:next_");
+    }
+
+    for(int i = 0; i < nbucket_; i++)
+        head_[i] = -1;
+}
+
+/* ----------------------------------------------------------------------
+   add sphere i of xnear to the grid
+------------------------------------------------------------------------- */
+
+void HashGrid::add(double **xnear, int i)
+{
+    if(i >= nmax_)
+        error->one(FLERR,"HashGrid: too many spheres");
+
+    int ibucket = hash(cell(xnear[i][0]),cell(xnear[i][1]),cell(xnear[i][2]));
+    next_[i] = head_[ibucket];
+    head_[ibucket] = i;
+
+    if(xnear[i][3] > radmax_) radmax_ = xnear[i][3];
+}
+
+/* ----------------------------------------------------------------------
+   check sphere at x with radius r against spheres in the cells around
+   same criterion as a check against all spheres in xnear
+------------------------------------------------------------------------- */
+
+bool HashGrid::overlap(double *x, double r, double **xnear)
+{
+    double del[3], rsq, radsum;
+
+    int ix = cell(x[0]), iy = cell(x[1]), iz = cell(x[2]);
+
+    // # of cells to check in each direction, 1 if cell size is large enough
+    int nc = static_cast<int>(ceil((r+radmax_)*cellsizeinv_));
+
+    for(int jx = ix-nc; jx <= ix+nc; jx++)
+      for(int jy = iy-nc; jy <= iy+nc; jy++)
+        for(int jz = iz-nc; jz <= iz+nc; jz++)
+        {
+            for(int j = head_[hash(jx,jy,jz)]; j >= 0; j = next_[j])
+            {
+                vectorSubtract3D(x,xnear[j],del);
+                rsq = vectorMag3DSquared(del);
+                radsum = r + xnear[j][3];
+
+                if (rsq <= radsum*radsum) return true;
+            }
+        }
+
+    return false;
+}
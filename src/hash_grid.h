@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------
+   LIGGGHTS - LAMMPS Improved for General Granular and Granular Heat
+   Transfer Simulations
+
+   LIGGGHTS is part of the CFDEMproject
+   www.liggghts.com | www.cfdem.com
+
+   Christoph Kloss, christoph.kloss@cfdem.com
+   Copyright 2009-2012 JKU Linz
+   Copyright 2012-     DCS Computing GmbH, Linz
+
+   LIGGGHTS is based on LAMMPS
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_HASH_GRID_H
+#define LMP_HASH_GRID_H
+
+#include "math.h"
+#include "pointers.h"
+
+namespace LAMMPS_NS
+{
+
+/* ----------------------------------------------------------------------
+   uniform grid for overlap checks of spheres stored as x,y,z,radius
+   in an array such as FixInsert::xnear
+   cells are hashed so the grid need not know the extent of the spheres
+   if the cell size is >= max sum of radii of two spheres, only the
+   27 cells around a sphere have to be checked
+------------------------------------------------------------------------- */
+
+class HashGrid : protected Pointers
+{
+  public:
+
+    HashGrid(LAMMPS *lmp);
+    ~HashGrid();
+
+    // clear grid, make room for nmax spheres, set cell size
+    void reset(int nmax, double cellsize);
+
+    // add sphere i of xnear to the grid
+    void add(double **xnear, int i);
+
+    // true if sphere at x with radius r overlaps a sphere in the grid
+    bool overlap(double *x, double r, double **xnear);
+
+  private:
+
+    inline int cell(double x)
+    { return static_cast<int>(floor(x*cellsizeinv_)); }
+
+    inline int hash(int ix, int iy, int iz)
+    {
+        unsigned int h = (static_cast<unsigned int>(ix)*73856093u) ^
+                         (static_cast<unsigned int>(iy)*19349663u) ^
+                         (static_cast<unsigned int>(iz)*83492791u);
+        return static_cast<int>(h & mask_);
+    }
+
+    double cellsizeinv_;
+
+    // max radius of spheres in the grid
+    double radmax_;
+
+    // nbucket_ is a power of 2, mask_ = nbucket_ - 1
+    int nbucket_, mask_;
+    int nmax_;
+
+    // linked list of spheres per bucket
+    int *head_;
+    int *next_;
+};
+
+}
+
+#endif
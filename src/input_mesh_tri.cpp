@@ -31,6 +31,7 @@
 #include "error.h"
 #include "domain.h"
 #include "math.h"
+#include "stdint.h"
 #include "vector_liggghts.h"
 #include "input_mesh_tri.h"
 #include "tri_mesh.h"
@@ -40,6 +41,9 @@ using namespace LAMMPS_NS;
 #define MAXLINE 2048
 #define DELTA 4
 
+// number of STL facets read and broadcast at once
+#define STL_BLOCK 65536
+
 InputMeshTri::InputMeshTri(LAMMPS *lmp, int argc, char **argv) : Input(lmp, argc, argv),
 verbose_(false)
 {}
@@ -71,7 +75,7 @@ void InputMeshTri::meshtrifile(const char *filename, class TriMesh *mesh,bool ve
 
   if (me == 0)
   {
-    nonlammps_file = fopen(filename,"r");
+    nonlammps_file = fopen(filename,is_stl ? "rb" : "r");
     if (nonlammps_file == NULL) {
       char str[128];
       sprintf(str,"Cannot open mesh file %s",filename);
@@ -258,11 +262,140 @@ void InputMeshTri::meshtrifile_vtk(class TriMesh *mesh)
 
 /* ----------------------------------------------------------------------
    process STL file
+   proc 0 reads all facets (binary or ASCII) into one array,
+   facets are then broadcast in blocks of STL_BLOCK facets
 ------------------------------------------------------------------------- */
 
 void InputMeshTri::meshtrifile_stl(class TriMesh *mesh)
 {
-  int n;
+  double *facets = NULL;
+  int *lines = NULL;
+  int nfacets = 0;
+
+  if (me == 0)
+  {
+    if(stl_is_binary())
+    {
+      if (verbose_) fprintf(screen,"Binary STL file detected\n");
+      meshtrifile_stl_binary(facets,lines,nfacets);
+    }
+    else meshtrifile_stl_ascii(facets,lines,nfacets);
+  }
+
+  MPI_Bcast(&nfacets,1,MPI_INT,0,world);
+
+  if (me != 0)
+  {
+    int nblock = MIN(nfacets,STL_BLOCK);
+    memory->create(facets,9*nblock+1,"input_mesh:facets");
+    memory->create(lines,nblock+1,"input_mesh:lines");
+  }
+
+  double *f;
+  int *l;
+
+  for (int first = 0; first < nfacets; first += STL_BLOCK)
+  {
+    int n = MIN(STL_BLOCK,nfacets-first);
+
+    // proc 0 sends from its full array, others receive into the block
+
+    f = (me == 0) ? &facets[9*first] : facets;
+    l = (me == 0) ? &lines[first] : lines;
+
+    MPI_Bcast(f,9*n,MPI_DOUBLE,0,world);
+    MPI_Bcast(l,n,MPI_INT,0,world);
+
+    for (int i = 0; i < n; i++)
+      addTriangle(mesh,&f[9*i],&f[9*i+3],&f[9*i+6],l[i]);
+  }
+
+  memory->destroy(facets);
+  memory->destroy(lines);
+}
+
+/* ----------------------------------------------------------------------
+   a binary STL file has an 80 byte header, the number of facets
+   and 50 bytes per facet, so the file size identifies it
+   (ASCII files can not match since they start with "solid ...")
+   only called by proc 0
+------------------------------------------------------------------------- */
+
+bool InputMeshTri::stl_is_binary()
+{
+  char header[84];
+  uint32_t nfacets;
+  long size;
+
+  bool binary = false;
+
+  if (fread(header,1,84,nonlammps_file) == 84)
+  {
+    memcpy(&nfacets,&header[80],4);
+    fseek(nonlammps_file,0,SEEK_END);
+    size = ftell(nonlammps_file);
+    binary = (size == 84 + 50*static_cast<long>(nfacets));
+  }
+
+  rewind(nonlammps_file);
+  return binary;
+}
+
+/* ----------------------------------------------------------------------
+   read binary STL file, only called by proc 0
+   per facet: normal (3 float), 3 vertices (3x3 float), 2 byte attribute
+   line number is the facet number (starting with 1)
+------------------------------------------------------------------------- */
+
+void InputMeshTri::meshtrifile_stl_binary(double *&facets,int *&lines,int &nfacets)
+{
+  char header[84];
+  uint32_t nfacets_file;
+  float values[12];
+
+  if (fread(header,1,84,nonlammps_file) != 84)
+    error->one(FLERR,"Corrupt binary STL file: could not read header");
+  memcpy(&nfacets_file,&header[80],4);
+
+  if (nfacets_file > static_cast<uint32_t>(MAXSMALLINT))
+    error->one(FLERR,"Binary STL file: too many facets");
+  nfacets = static_cast<int>(nfacets_file);
+
+  memory->create(facets,9*nfacets+1,"input_mesh:facets");
+  memory->create(lines,nfacets+1,"input_mesh:lines");
+
+  // read in blocks of facets
+
+  int nblock = MIN(nfacets,STL_BLOCK);
+  char *buf = (char*) memory->smalloc(50*nblock+1,"input_mesh:buf");
+
+  for (int first = 0; first < nfacets; first += STL_BLOCK)
+  {
+    int n = MIN(STL_BLOCK,nfacets-first);
+    if (fread(buf,50,n,nonlammps_file) != static_cast<size_t>(n))
+      error->one(FLERR,"Corrupt binary STL file: unexpected end of file");
+
+    for (int i = 0; i < n; i++)
+    {
+      // do not import facet normal (is calculated later)
+      memcpy(values,&buf[50*i],48);
+      double *f = &facets[9*(first+i)];
+      for (int j = 0; j < 9; j++)
+        f[j] = static_cast<double>(values[3+j]);
+      lines[first+i] = first+i+1;
+    }
+  }
+
+  memory->sfree(buf);
+}
+
+/* ----------------------------------------------------------------------
+   read ASCII STL file, only called by proc 0
+   lines are tokenized in place, no broadcast per line
+------------------------------------------------------------------------- */
+
+void InputMeshTri::meshtrifile_stl_ascii(double *&facets,int *&lines,int &nfacets)
+{
   int iVertex = 0;
   double vertices[3][3];
   bool insideSolidObject = false;
@@ -270,150 +403,127 @@ void InputMeshTri::meshtrifile_stl(class TriMesh *mesh)
   bool insideOuterLoop = false;
 
   int nLines = 0, nLinesTri = 0;
+  int maxfacets = 0;
+  char *word,*end;
 
-  while (1)
-  {
-    // read one line from input script
-    // if line ends in continuation char '&', concatenate next line(s)
-    // n = str length of line
-    if (me == 0) {
-      if (fgets(line,MAXLINE,nonlammps_file) == NULL) n = 0;
-      else n = strlen(line) + 1;
-      while (n >= 3 && line[n-3] == '&') {
-            if (fgets(&line[n-3],MAXLINE-n+3,nonlammps_file) == NULL) n = 0;
-            else n = strlen(line) + 1;
-      }
-    }
-
-    // bcast the line
-    // if n = 0, end-of-file
-    // error if label_active is set, since label wasn't encountered
-    // if original input file, code is done
-    // else go back to previous input file
-    MPI_Bcast(&n,1,MPI_INT,0,world);
-    if (n == 0) {
-      break;
-    }
-
-    MPI_Bcast(line,n,MPI_CHAR,0,world);
+  nfacets = 0;
 
+  while (fgets(line,MAXLINE,nonlammps_file))
+  {
     // lines start with 1 (not 0)
     nLines++;
 
-    // if n = MAXLINE, line is too long
-    if (n == MAXLINE) {
+    // if line fills buffer, line is too long
+    if (strlen(line) == MAXLINE-1 && line[MAXLINE-2] != '\n') {
       char str[MAXLINE+32];
       sprintf(str,"Input line too long: %s",line);
-      error->all(FLERR,str);
+      error->one(FLERR,str);
     }
 
-    // parse one line from the stl file
-    parse_nonlammps();
+    word = strtok(line," \t\n\r\f");
 
     // skip empty lines
-    if(narg==0){
-         if (me == 0 && verbose_)
-            fprintf(screen,"Note: Skipping empty line in STL file\n");
+    if (word == NULL) {
+      if (verbose_)
+        fprintf(screen,"Note: Skipping empty line in STL file\n");
       continue;
     }
 
     // detect begin and end of a solid object, facet and vertices
-    if (strcmp(arg[0],"solid") == 0)
+    if (strcmp(word,"solid") == 0)
     {
       if (insideSolidObject)
-        error->all(FLERR,"Corrupt or unknown STL file: New solid object begins without closing prior solid object.");
+        error->one(FLERR,"Corrupt or unknown STL file: New solid object begins without closing prior solid object.");
       insideSolidObject=true;
-      if (me == 0 && verbose_){
-         fprintf(screen,"Solid body detected in STL file\n");
-       }
+      if (verbose_)
+        fprintf(screen,"Solid body detected in STL file\n");
     }
-    else if (strcmp(arg[0],"endsolid") == 0)
+    else if (strcmp(word,"endsolid") == 0)
     {
        if (!insideSolidObject)
-         error->all(FLERR,"Corrupt or unknown STL file: End of solid object found, but no begin.");
+         error->one(FLERR,"Corrupt or unknown STL file: End of solid object found, but no begin.");
        insideSolidObject=false;
-       if (me == 0 && verbose_) {
+       if (verbose_)
          fprintf(screen,"End of solid body detected in STL file.\n");
-       }
     }
 
     // detect begin and end of a facet within a solids object
-    else if (strcmp(arg[0],"facet") == 0)
+    else if (strcmp(word,"facet") == 0)
     {
       if (insideFacet)
-        error->all(FLERR,"Corrupt or unknown STL file: New facet begins without closing prior facet.");
+        error->one(FLERR,"Corrupt or unknown STL file: New facet begins without closing prior facet.");
       if (!insideSolidObject)
-        error->all(FLERR,"Corrupt or unknown STL file: New facet begins outside solid object.");
+        error->one(FLERR,"Corrupt or unknown STL file: New facet begins outside solid object.");
       insideFacet = true;
 
       nLinesTri = nLines;
 
       // check for keyword normal belonging to facet
-      if (strcmp(arg[1],"normal") != 0)
-        error->all(FLERR,"Corrupt or unknown STL file: Facet normal not defined.");
+      word = strtok(NULL," \t\n\r\f");
+      if (word == NULL || strcmp(word,"normal") != 0)
+        error->one(FLERR,"Corrupt or unknown STL file: Facet normal not defined.");
 
       // do not import facet normal (is calculated later)
     }
-    else if (strcmp(arg[0],"endfacet") == 0)
+    else if (strcmp(word,"endfacet") == 0)
     {
        if (!insideFacet)
-         error->all(FLERR,"Corrupt or unknown STL file: End of facet found, but no begin.");
+         error->one(FLERR,"Corrupt or unknown STL file: End of facet found, but no begin.");
        insideFacet = false;
        if (iVertex != 3)
-         error->all(FLERR,"Corrupt or unknown STL file: Number of vertices not equal to three (no triangle).");
-
-      // add triangle to mesh
-      //printVec3D(screen,"vertex",vertices[0]);
-      //printVec3D(screen,"vertex",vertices[1]);
-      //printVec3D(screen,"vertex",vertices[2]);
-      addTriangle(mesh,vertices[0],vertices[1],vertices[2],nLinesTri);
-
-       if (me == 0) {
-         //fprintf(screen,"  End of facet detected in in solid body.\n");
-       }
+         error->one(FLERR,"Corrupt or unknown STL file: Number of vertices not equal to three (no triangle).");
+
+      // store triangle, added to the mesh after the broadcast
+      if (nfacets == maxfacets)
+      {
+        maxfacets += STL_BLOCK;
+        memory->grow(facets,9*maxfacets,"input_mesh:facets");
+        memory->grow(lines,maxfacets,"input_mesh:lines");
+      }
+      double *f = &facets[9*nfacets];
+      for (int k = 0; k < 3; k++)
+        vectorCopy3D(vertices[k],&f[3*k]);
+      lines[nfacets++] = nLinesTri;
     }
 
     //detect begin and end of an outer loop within a facet
-    else if (strcmp(arg[0],"outer") == 0)
+    else if (strcmp(word,"outer") == 0)
     {
       if (insideOuterLoop)
-        error->all(FLERR,"Corrupt or unknown STL file: New outer loop begins without closing prior outer loop.");
+        error->one(FLERR,"Corrupt or unknown STL file: New outer loop begins without closing prior outer loop.");
       if (!insideFacet)
-        error->all(FLERR,"Corrupt or unknown STL file: New outer loop begins outside facet.");
+        error->one(FLERR,"Corrupt or unknown STL file: New outer loop begins outside facet.");
       insideOuterLoop = true;
       iVertex = 0;
-
-      if (me == 0){
-         //fprintf(screen,"    Outer loop detected in facet.\n");
-       }
     }
-    else if (strcmp(arg[0],"endloop") == 0)
+    else if (strcmp(word,"endloop") == 0)
     {
        if (!insideOuterLoop)
-         error->all(FLERR,"Corrupt or unknown STL file: End of outer loop found, but no begin.");
+         error->one(FLERR,"Corrupt or unknown STL file: End of outer loop found, but no begin.");
        insideOuterLoop=false;
-       if (me == 0) {
-         //fprintf(screen,"    End of outer loop detected in facet.\n");
-       }
     }
 
-    else if (strcmp(arg[0],"vertex") == 0)
+    else if (strcmp(word,"vertex") == 0)
     {
        if (!insideOuterLoop)
-         error->all(FLERR,"Corrupt or unknown STL file: Vertex found outside a loop.");
+         error->one(FLERR,"Corrupt or unknown STL file: Vertex found outside a loop.");
 
-       if (me == 0) {
-         //fprintf(screen,"      Vertex found.\n");
-       }
+      if (iVertex == 3)
+         error->one(FLERR,"Corrupt or unknown STL file: Can not have more than 3 vertices "
+                          "in a facet (only triangular meshes supported).");
 
       // read the vertex
       for (int j=0;j<3;j++)
-        vertices[iVertex][j]=atof(arg[1+j]);
+      {
+        word = strtok(NULL," \t\n\r\f");
+        if (word == NULL)
+          error->one(FLERR,"Corrupt or unknown STL file: Vertex needs 3 coordinates.");
+        vertices[iVertex][j] = strtod(word,&end);
+        if (end == word || *end != '\0')
+          error->one(FLERR,"Corrupt or unknown STL file: Vertex coordinate is not a number.");
+      }
 
       iVertex++;
-      if (iVertex > 3)
-         error->all(FLERR,"Corrupt or unknown STL file: Can not have more than 3 vertices "
-                          "in a facet (only triangular meshes supported).");
     }
   }
 }
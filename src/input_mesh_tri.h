@@ -42,6 +42,9 @@ class InputMeshTri : protected Input
 
     void meshtrifile_vtk(class TriMesh *);
     void meshtrifile_stl(class TriMesh *);
+    bool stl_is_binary();
+    void meshtrifile_stl_binary(double *&facets,int *&lines,int &nfacets);
+    void meshtrifile_stl_ascii(double *&facets,int *&lines,int &nfacets);
     inline void addTriangle(class TriMesh *mesh,
          double *a, double *b, double *c,int lineNumber);
 
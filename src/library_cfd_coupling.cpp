@@ -52,7 +52,37 @@ int liggghts_get_maxtag(void *ptr)
   return lmp->atom->tag_max();
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   length of per-atom arrays on this proc
+   tag_max for coupling model 'mpi', # of particles in the sub-domain
+   of the calling program for 'mpi/sparse'
+------------------------------------------------------------------------- */
+
+int liggghts_get_n_external(void *ptr)
+{
+    FixCfdCoupling* fcfd = (FixCfdCoupling*)locate_coupling_fix(ptr);
+    return fcfd->get_dc()->n_external();
+}
+
+/* ----------------------------------------------------------------------
+   tags of the particles in per-atom arrays, NULL if indexed by tag-1
+------------------------------------------------------------------------- */
+
+int* liggghts_get_external_tags(void *ptr)
+{
+    FixCfdCoupling* fcfd = (FixCfdCoupling*)locate_coupling_fix(ptr);
+    return fcfd->get_dc()->external_tags();
+}
+
+/* ----------------------------------------------------------------------
+   sub-domain of the calling program on this proc, called by all procs
+------------------------------------------------------------------------- */
+
+void liggghts_set_external_domain(double *lo,double *hi,void *ptr)
+{
+    FixCfdCoupling* fcfd = (FixCfdCoupling*)locate_coupling_fix(ptr);
+    fcfd->get_dc()->set_external_domain(lo,hi);
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -33,6 +33,9 @@
 #endif
 
 int liggghts_get_maxtag(void *ptr);
+int liggghts_get_n_external(void *ptr);
+int* liggghts_get_external_tags(void *ptr);
+void liggghts_set_external_domain(double *lo,double *hi,void *ptr);
 
 void* locate_coupling_fix(void *ptr);
 void data_liggghts_to_of(char *name,char *type,void *ptr,void *&data,char *datatype);
@@ -37,6 +37,59 @@
 
 using namespace LAMMPS_NS;
 
+/* ----------------------------------------------------------------------
+   add mesh velocity, either to the nodes or to the velocity field
+   of a mesh moving in rigid frame
+------------------------------------------------------------------------- */
+
+void MeshMover::add_velocity(double *vel)
+{
+    if(mesh_->isRigidFrame())
+    {
+        mesh_->addRigidVelocity(vel);
+        return;
+    }
+
+    int size = mesh_->size();
+    int numNodes = mesh_->numNodes();
+    double ***v_node = get_v();
+
+    for (int i = 0; i < size; i++)
+        for(int j = 0; j < numNodes; j++)
+            vectorAdd3D(v_node[i][j],vel,v_node[i][j]);
+}
+
+/* ----------------------------------------------------------------------
+   add mesh velocity w x rPA for rotation around axis through p
+------------------------------------------------------------------------- */
+
+void MeshMover::add_angular_velocity(double *omegaVec, double *p)
+{
+    if(mesh_->isRigidFrame())
+    {
+        mesh_->addRigidAngularVelocity(omegaVec,p);
+        return;
+    }
+
+    double node[3],vRot[3],rPA[3];
+
+    int size = mesh_->size();
+    int numNodes = mesh_->numNodes();
+    double ***v_node = get_v();
+    double ***nodes = get_nodes();
+
+    for(int i = 0; i < size; i++)
+    {
+      for(int iNode = 0; iNode < numNodes; iNode++)
+      {
+          vectorCopy3D(nodes[i][iNode],node);
+          vectorSubtract3D(node,p,rPA);
+          vectorCross3D(omegaVec,rPA,vRot);
+          vectorAdd3D(v_node[i][iNode],vRot,v_node[i][iNode]);
+      }
+    }
+}
+
 /* ----------------------------------------------------------------------
    MeshMoverLinear
 ------------------------------------------------------------------------- */
@@ -68,10 +121,6 @@ void MeshMoverLinear::initial_integrate(double dT,double dt)
 {
     double dX[3],dx[3];
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-
     // calculate total and incremental displacement
     vectorScalarMult3D(vel_,dT,dX);
     vectorScalarMult3D(vel_,dt,dx);
@@ -80,9 +129,7 @@ void MeshMoverLinear::initial_integrate(double dT,double dt)
     mesh_->move(dX,dx);
 
     // set mesh velocity
-    for (int i = 0; i < size; i++)
-        for(int j = 0; j < numNodes; j++)
-            vectorAdd3D(v_node[i][j],vel_,v_node[i][j]);
+    add_velocity(vel_);
 }
 
 /* ----------------------------------------------------------------------
@@ -171,10 +218,6 @@ void MeshMoverLinearVariable::initial_integrate(double dT,double dt)
 {
     double dx[3];
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-
     modify->clearstep_compute();
 
     // evaluate variable
@@ -193,9 +236,7 @@ void MeshMoverLinearVariable::initial_integrate(double dT,double dt)
     mesh_->move(dX_,dx);
 
     // set mesh velocity
-    for (int i = 0; i < size; i++)
-        for(int j = 0; j < numNodes; j++)
-            vectorAdd3D(v_node[i][j],vel_,v_node[i][j]);
+    add_velocity(vel_);
 }
 
 /* ----------------------------------------------------------------------
@@ -232,10 +273,6 @@ void MeshMoverWiggle::initial_integrate(double dT,double dt)
     double sine = sin(omega_ * dT);
     double cosine = cos(omega_ * dT);
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-
     // calculate velocity, same for all nodes
     vectorScalarMult3D(amplitude_,omega_*cosine,vNode);
 
@@ -247,9 +284,7 @@ void MeshMoverWiggle::initial_integrate(double dT,double dt)
     mesh_->move(dX,dx);
 
     // set mesh velocity
-    for (int i = 0; i < size; i++)
-        for(int j = 0; j < numNodes; j++)
-            vectorAdd3D(v_node[i][j],vNode,v_node[i][j]);
+    add_velocity(vNode);
 }
 
 /* ----------------------------------------------------------------------
@@ -293,33 +328,19 @@ MeshMoverRotate::~MeshMoverRotate()
 
 void MeshMoverRotate::initial_integrate(double dT,double dt)
 {
-    double xOld[3],node[3],vRot[3],omegaVec[3],rPA[3];
+    double omegaVec[3];
     double reference_point[3];
     double totalPhi = omega_*dT;
     double incrementalPhi = omega_*dt;
 
     get_reference_point(reference_point);
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-    double ***nodes = get_nodes();
-
     // rotate the mesh
     mesh_->rotate(totalPhi,incrementalPhi,axis_,reference_point);
 
     // set mesh velocity, w x rPA
     vectorScalarMult3D(axis_,omega_,omegaVec);
-    for(int i = 0; i < size; i++)
-    {
-      for(int iNode = 0; iNode < numNodes; iNode++)
-      {
-          vectorCopy3D(nodes[i][iNode],node);
-          vectorSubtract3D(node,reference_point,rPA);
-          vectorCross3D(omegaVec,rPA,vRot);
-          vectorAdd3D(v_node[i][iNode],vRot,v_node[i][iNode]);
-      }
-    }
+    add_angular_velocity(omegaVec,reference_point);
 }
 
 /* ----------------------------------------------------------------------
@@ -400,15 +421,10 @@ void MeshMoverRotateVariable::setup()
 
 void MeshMoverRotateVariable::initial_integrate(double dT,double dt)
 {
-    double xOld[3],node[3],vRot[3],omegaVec[3],rPA[3];
+    double omegaVec[3];
     double reference_point[3];
     double incrementalPhi;
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-    double ***nodes = get_nodes();
-
     modify->clearstep_compute();
 
     // re-evaluation of omega (global,private)
@@ -426,16 +442,7 @@ void MeshMoverRotateVariable::initial_integrate(double dT,double dt)
 
     // set mesh velocity, w x rPA
     vectorScalarMult3D(axis_,omega_,omegaVec);
-    for(int i = 0; i < size; i++)
-    {
-      for(int iNode = 0; iNode < numNodes; iNode++)
-      {
-          vectorCopy3D(nodes[i][iNode],node);
-          vectorSubtract3D(node,reference_point,rPA);
-          vectorCross3D(omegaVec,rPA,vRot);
-          vectorAdd3D(v_node[i][iNode],vRot,v_node[i][iNode]);
-      }
-    }
+    add_angular_velocity(omegaVec,reference_point);
 }
 
 /* ----------------------------------------------------------------------
@@ -478,18 +485,13 @@ MeshMoverRiggle::~MeshMoverRiggle()
 
 void MeshMoverRiggle::initial_integrate(double dT,double dt)
 {
-    double xOld[3],node[3],vRot[3],omegaVec[3],rPA[3];
+    double omegaVec[3];
 
     double sine = amplitude_*sin(omega_ * dT);
     double cosine = amplitude_*cos(omega_ * dT);
 
     double vel_prefactor = cosine*omega_;
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-    double ***nodes = get_nodes();
-
     // calculate total and incremental angle
     double totalPhi = sine;
     double incrementalPhi = cosine*omega_*dt;
@@ -499,16 +501,7 @@ void MeshMoverRiggle::initial_integrate(double dT,double dt)
 
     // set mesh velocity, vel_prefactor * w/|w| x rPA
     vectorScalarMult3D(axis_,vel_prefactor,omegaVec);
-    for(int i = 0; i < size; i++)
-    {
-      for(int iNode = 0; iNode < numNodes; iNode++)
-      {
-          vectorCopy3D(nodes[i][iNode],node);
-          vectorSubtract3D(node,point_,rPA);
-          vectorCross3D(omegaVec,rPA,vRot);
-          vectorAdd3D(v_node[i][iNode],vRot,v_node[i][iNode]);
-      }
-    }
+    add_angular_velocity(omegaVec,point_);
 }
 
 /* ----------------------------------------------------------------------
@@ -551,9 +544,6 @@ MeshMoverVibLin::~MeshMoverVibLin()
 void MeshMoverVibLin::initial_integrate(double dT,double dt)
 {
     double dX[3],dx[3],vNode[3];
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
 
     double arg = 0;
     double vA = 0;
@@ -574,9 +564,7 @@ void MeshMoverVibLin::initial_integrate(double dT,double dt)
     mesh_->move(dX,dx);
 
     // set mesh velocity
-    for (int i = 0; i < size; i++)
-        for(int j = 0; j < numNodes; j++)
-            vectorAdd3D(v_node[i][j],vNode,v_node[i][j]);
+    add_velocity(vNode);
 
 }
 
@@ -624,7 +612,7 @@ MeshMoverVibRot::~MeshMoverVibRot()
 
 void MeshMoverVibRot::initial_integrate(double dT,double dt)
 {
-    double xOld[3],node[3],omegaVec[3],rPA[3],vRot[3];
+    double omegaVec[3];
 
     double arg = 0;
     double vR = 0;
@@ -635,11 +623,6 @@ void MeshMoverVibRot::initial_integrate(double dT,double dt)
         vR= vR-ampl[j]*(j+1)*omega_*sin(omega_*(j+1)*dT+phi[j]);
         }
 
-    int size = mesh_->size();
-    int numNodes = mesh_->numNodes();
-    double ***v_node = get_v();
-    double ***nodes = get_nodes();
-
     double totalPhi = arg;
     double incrementalPhi = vR*dt;
 
@@ -649,15 +632,6 @@ void MeshMoverVibRot::initial_integrate(double dT,double dt)
     // set mesh velocity, vel_prefactor * w/|w| x rPA
     vectorScalarMult3D(axis_,vR,omegaVec);
 
-    for(int i = 0; i < size; i++)
-    {
-      for(int iNode = 0; iNode < numNodes; iNode++)
-      {
-          vectorCopy3D(nodes[i][iNode],node);
-          vectorSubtract3D(node,p_,rPA);
-          vectorCross3D(omegaVec,rPA,vRot);
-          vectorAdd3D(v_node[i][iNode],vRot,v_node[i][iNode]);
-      }
-    }
+    add_angular_velocity(omegaVec,p_);
 }
 
@@ -73,6 +73,10 @@ namespace LAMMPS_NS
         double ***get_nodes()
         { return mesh_->nodePtr(); }
 
+        // add mesh velocity for translation or rotation
+        void add_velocity(double *vel);
+        void add_angular_velocity(double *omegaVec, double *p);
+
         double ***get_v()
         {
             double ***ptr = NULL;
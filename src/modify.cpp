@@ -35,6 +35,7 @@
 #include "domain.h"
 #include "memory.h"
 #include "error.h"
+#include "timer.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -59,6 +60,7 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
 
   fix = NULL;
   fmask = NULL;
+  fix_time = NULL;
   list_initial_integrate = list_post_integrate = NULL;
   list_pre_exchange = list_pre_neighbor = NULL;
   list_pre_force = list_post_force = NULL;
@@ -85,6 +87,10 @@ Modify::Modify(LAMMPS *lmp) : Pointers(lmp)
 
   ncompute = maxcompute = 0;
   compute = NULL;
+
+  comm_batch_active = 0;
+  nforward_request = nreverse_request = maxcomm_request = 0;
+  forward_request = reverse_request = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -97,6 +103,7 @@ Modify::~Modify()
   while (nfix) delete_fix(fix[0]->id);
   memory->sfree(fix);
   memory->destroy(fmask);
+  memory->destroy(fix_time);
 
   // delete all computes
 
@@ -126,6 +133,9 @@ Modify::~Modify()
   delete [] end_of_step_every;
   delete [] list_timeflag;
 
+  memory->sfree(forward_request);
+  memory->sfree(reverse_request);
+
   restart_deallocate();
 }
 
@@ -141,6 +151,11 @@ void Modify::init()
 
   restart_deallocate();
 
+  // reset per-fix timing, it covers a single run like the Timer
+
+  for (i = 0; i < nfix; i++)
+    for (j = 0; j < FIXTIME_N; j++) fix_time[i][j] = 0.0;
+
   // create lists of fixes to call at each stage of run
 
   list_init(INITIAL_INTEGRATE,n_initial_integrate,list_initial_integrate);
@@ -300,8 +315,13 @@ void Modify::setup_pre_force(int vflag)
 
 void Modify::initial_integrate(int vflag)
 {
-  for (int i = 0; i < n_initial_integrate; i++)
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_initial_integrate; i++) {
     fix[list_initial_integrate[i]]->initial_integrate(vflag);
+    t = fix_time_stamp(list_initial_integrate[i],FIXTIME_INITIAL_INTEGRATE,t);
+  }
+  flush_comm_requests();
 }
 
 /* ----------------------------------------------------------------------
@@ -310,8 +330,13 @@ void Modify::initial_integrate(int vflag)
 
 void Modify::post_integrate()
 {
-  for (int i = 0; i < n_post_integrate; i++)
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_post_integrate; i++) {
     fix[list_post_integrate[i]]->post_integrate();
+    t = fix_time_stamp(list_post_integrate[i],FIXTIME_POST_INTEGRATE,t);
+  }
+  flush_comm_requests();
 }
 
 /* ----------------------------------------------------------------------
@@ -320,10 +345,10 @@ void Modify::post_integrate()
 
 void Modify::pre_exchange()
 {
-  for (int i = 0; i < n_pre_exchange; i++)
-  {
-    
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_pre_exchange; i++) {
     fix[list_pre_exchange[i]]->pre_exchange();
+    t = fix_time_stamp(list_pre_exchange[i],FIXTIME_PRE_EXCHANGE,t);
   }
 }
 
@@ -333,10 +358,10 @@ void Modify::pre_exchange()
 
 void Modify::pre_neighbor()
 {
-  for (int i = 0; i < n_pre_neighbor; i++)
-  {
-    
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_pre_neighbor; i++) {
     fix[list_pre_neighbor[i]]->pre_neighbor();
+    t = fix_time_stamp(list_pre_neighbor[i],FIXTIME_PRE_NEIGHBOR,t);
   }
 }
 
@@ -346,11 +371,13 @@ void Modify::pre_neighbor()
 
 void Modify::pre_force(int vflag)
 {
-  for (int i = 0; i < n_pre_force; i++)
-  {
-    
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_pre_force; i++) {
     fix[list_pre_force[i]]->pre_force(vflag);
+    t = fix_time_stamp(list_pre_force[i],FIXTIME_PRE_FORCE,t);
   }
+  flush_comm_requests();
 }
 
 /* ----------------------------------------------------------------------
@@ -359,8 +386,13 @@ void Modify::pre_force(int vflag)
 
 void Modify::post_force(int vflag)
 {
-  for (int i = 0; i < n_post_force; i++)
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_post_force; i++) {
     fix[list_post_force[i]]->post_force(vflag);
+    t = fix_time_stamp(list_post_force[i],FIXTIME_POST_FORCE,t);
+  }
+  flush_comm_requests();
 }
 
 /* ----------------------------------------------------------------------
@@ -382,8 +414,13 @@ bool Modify::iterate_implicitly()
 
 void Modify::final_integrate()
 {
-  for (int i = 0; i < n_final_integrate; i++)
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
+  for (int i = 0; i < n_final_integrate; i++) {
     fix[list_final_integrate[i]]->final_integrate();
+    t = fix_time_stamp(list_final_integrate[i],FIXTIME_FINAL_INTEGRATE,t);
+  }
+  flush_comm_requests();
 }
 
 /* ----------------------------------------------------------------------
@@ -393,9 +430,130 @@ void Modify::final_integrate()
 
 void Modify::end_of_step()
 {
+  comm_batch_active = 1;
+  double t = MPI_Wtime();
   for (int i = 0; i < n_end_of_step; i++)
-    if (update->ntimestep % end_of_step_every[i] == 0)
+    if (update->ntimestep % end_of_step_every[i] == 0) {
       fix[list_end_of_step[i]]->end_of_step();
+      t = fix_time_stamp(list_end_of_step[i],FIXTIME_END_OF_STEP,t);
+    }
+  flush_comm_requests();
+}
+
+/* ----------------------------------------------------------------------
+   charge wall time since t to phase of fix ifix
+   return new time stamp, so one MPI_Wtime() call per fix call suffices
+------------------------------------------------------------------------- */
+
+double Modify::fix_time_stamp(int ifix, int phase, double t)
+{
+  double now = MPI_Wtime();
+  fix_time[ifix][phase] += now - t;
+  return now;
+}
+
+/* ----------------------------------------------------------------------
+   per-fix timing reduced across procs
+   ave,min,max are nfix x (FIXTIME_N+1) row-major, last column is total
+   of all phases, i.e. min/max of total is taken over procs, not phases
+   collective call, must be called by all procs
+------------------------------------------------------------------------- */
+
+void Modify::fix_time_stats(double *ave, double *min, double *max)
+{
+  int ncol = FIXTIME_N+1;
+  int n = nfix*ncol;
+  if (n == 0) return;
+
+  double *local = new double[n];
+  for (int i = 0; i < nfix; i++) {
+    double total = 0.0;
+    for (int j = 0; j < FIXTIME_N; j++) {
+      local[i*ncol+j] = fix_time[i][j];
+      total += fix_time[i][j];
+    }
+    local[i*ncol+FIXTIME_N] = total;
+  }
+
+  MPI_Allreduce(local,ave,n,MPI_DOUBLE,MPI_SUM,world);
+  MPI_Allreduce(local,min,n,MPI_DOUBLE,MPI_MIN,world);
+  MPI_Allreduce(local,max,n,MPI_DOUBLE,MPI_MAX,world);
+  delete [] local;
+
+  int nprocs = comm->nprocs;
+  for (int i = 0; i < n; i++) ave[i] /= nprocs;
+}
+
+/* ----------------------------------------------------------------------
+   ghost comm requested by a fix during a timestep phase
+   requests are collected until the end of the phase and then done
+   for all fixes at once, so the data must not be needed in the same phase
+   outside of a phase, the comm is done right away
+------------------------------------------------------------------------- */
+
+void Modify::request_forward_comm(Fix *f)
+{
+  if (!comm_batch_active) {
+    comm->forward_comm_fix(f);
+    return;
+  }
+
+  for (int i = 0; i < nforward_request; i++)
+    if (forward_request[i] == f) return;
+
+  if (nforward_request == maxcomm_request) grow_comm_requests();
+  forward_request[nforward_request++] = f;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::request_reverse_comm(Fix *f)
+{
+  if (!comm_batch_active) {
+    comm->reverse_comm_fix(f);
+    return;
+  }
+
+  for (int i = 0; i < nreverse_request; i++)
+    if (reverse_request[i] == f) return;
+
+  if (nreverse_request == maxcomm_request) grow_comm_requests();
+  reverse_request[nreverse_request++] = f;
+}
+
+/* ----------------------------------------------------------------------
+   end of a timestep phase: do all requested ghost comm
+   one message per swap for all fixes
+------------------------------------------------------------------------- */
+
+void Modify::flush_comm_requests()
+{
+  comm_batch_active = 0;
+
+  if (!nforward_request && !nreverse_request) return;
+
+  timer->stamp();
+
+  if (nreverse_request)
+    comm->reverse_comm_fix_batch(nreverse_request,reverse_request);
+  if (nforward_request)
+    comm->forward_comm_fix_batch(nforward_request,forward_request);
+  nforward_request = nreverse_request = 0;
+
+  timer->stamp(TIME_COMM);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Modify::grow_comm_requests()
+{
+  maxcomm_request += DELTA;
+  forward_request = (Fix **)
+    memory->srealloc(forward_request,maxcomm_request*sizeof(Fix *),
+                     "modify:forward_request");
+  reverse_request = (Fix **)
+    memory->srealloc(reverse_request,maxcomm_request*sizeof(Fix *),
+                     "modify:reverse_request");
 }
 
 /* ----------------------------------------------------------------------
@@ -673,6 +831,7 @@ void Modify::add_fix(int narg, char **arg, char *suffix)
       maxfix += DELTA;
       fix = (Fix **) memory->srealloc(fix,maxfix*sizeof(Fix *),"modify:fix");
       memory->grow(fmask,maxfix,"modify:fmask");
+      memory->grow(fix_time,maxfix,FIXTIME_N,"modify:fix_time");
     }
   }
 
@@ -710,9 +869,10 @@ void Modify::add_fix(int narg, char **arg, char *suffix)
     else {fprintf(screen,"adding %s\n",arg[2]);error->all(FLERR,"Invalid fix style");}
   }
 
-  // set fix mask values and increment nfix (if new)
+  // set fix mask values, clear its timing and increment nfix (if new)
 
   fmask[ifix] = fix[ifix]->setmask();
+  for (int j = 0; j < FIXTIME_N; j++) fix_time[ifix][j] = 0.0;
   if (newflag) nfix++;
 
   // check if Fix is in restart_global list
@@ -789,6 +949,8 @@ void Modify::delete_fix(const char *id, bool unfixflag)
 
   for (int i = ifix+1; i < nfix; i++) fix[i-1] = fix[i];
   for (int i = ifix+1; i < nfix; i++) fmask[i-1] = fmask[i];
+  for (int i = ifix+1; i < nfix; i++)
+    for (int j = 0; j < FIXTIME_N; j++) fix_time[i-1][j] = fix_time[i][j];
   nfix--;
 }
 
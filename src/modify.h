@@ -31,6 +31,10 @@ namespace LAMMPS_NS {
 
 class Modify : protected Pointers {
  public:
+  enum{FIXTIME_INITIAL_INTEGRATE,FIXTIME_POST_INTEGRATE,FIXTIME_PRE_EXCHANGE,
+       FIXTIME_PRE_NEIGHBOR,FIXTIME_PRE_FORCE,FIXTIME_POST_FORCE,
+       FIXTIME_FINAL_INTEGRATE,FIXTIME_END_OF_STEP,FIXTIME_N};
+
   int nfix,maxfix;
   int n_initial_integrate,n_post_integrate,n_pre_exchange,n_pre_neighbor;
   int n_pre_force,n_post_force;
@@ -48,6 +52,8 @@ class Modify : protected Pointers {
 
   class Fix **fix;           // list of fixes
   int *fmask;                // bit mask for when each fix is applied
+  double **fix_time;         // wall time of each fix per timestep phase
+                             // accumulated since last init()
 
   int ncompute,maxcompute;   // list of computes
   class Compute **compute;
@@ -72,6 +78,11 @@ class Modify : protected Pointers {
   virtual double thermo_energy();
   virtual void post_run();
 
+  void fix_time_stats(double *, double *, double *);
+
+  void request_forward_comm(class Fix *);     // batched ghost comm of a Fix
+  void request_reverse_comm(class Fix *);     // until the phase ends
+
   void setup_pre_force_respa(int, int);
   void initial_integrate_respa(int, int, int);
   void post_integrate_respa(int, int);
@@ -160,10 +171,20 @@ class Modify : protected Pointers {
 
   int index_permanent;        // fix/compute index returned to library call
 
+  int comm_batch_active;      // 1 while a timestep phase collects comm requests
+  int nforward_request,nreverse_request,maxcomm_request;
+  class Fix **forward_request;        // fixes requesting forward ghost comm
+  class Fix **reverse_request;        // fixes requesting reverse ghost comm
+
   void list_init(int, int &, int *&);
   void list_init_end_of_step(int, int &, int *&);
   void list_init_thermo_energy(int, int &, int *&);
   void list_init_compute();
+
+  void flush_comm_requests();
+  void grow_comm_requests();
+
+  double fix_time_stamp(int, int, double);
 };
 
 }
@@ -87,6 +87,43 @@ namespace LAMMPS_NS
         bool decideRebuild();
         void storeNodePosRebuild();
 
+        // rigid frame for moving mesh
+        // nodes are not moved every step, but only when they are needed
+        //   by parallel operations, neighbor list build, dump etc.
+        // in between, the mesh stays in the frame of its last update
+        //   and moves are accumulated in a rigid transformation
+        void setRigidFrame();
+        virtual void updateRigidFrame();
+        void zeroRigidVelocity();
+        void addRigidVelocity(double *vel);
+        void addRigidAngularVelocity(double *omega, double *p);
+
+        inline bool isRigidFrame()
+        { return rigidFrame_ && nMove_ > 0; }
+
+        // transform position x to frame of the mesh
+        inline void rigidToMeshFrame(double *x, double *xMesh)
+        {
+            double tmp[3];
+            vectorSubtract3D(x,relD_,tmp);
+            MathExtra::transpose_matvec(relR_,tmp,xMesh);
+        }
+
+        // rotate vector from frame of the mesh to world frame
+        inline void rigidToWorld(double *vec)
+        {
+            double tmp[3];
+            vectorCopy3D(vec,tmp);
+            MathExtra::matvec(relR_,tmp,vec);
+        }
+
+        // velocity of the mesh at position x
+        inline void rigidVelocity(double *x, double *v)
+        {
+            MathExtra::matvec(rigidL_,x,v);
+            vectorAdd3D(v,rigidV0_,v);
+        }
+
         // inline access
 
         inline bool isMoving()
@@ -195,6 +232,10 @@ namespace LAMMPS_NS
         
         virtual bool resetToOrig();
 
+        // rigid frame - relative transformation from node_ to current pos
+        void rigidRelative(double *qRel, double *dRel);
+        bool rigidFrameCurrent();
+
       private:
 
         // mesh precision
@@ -214,6 +255,27 @@ namespace LAMMPS_NS
         // only relevant for moving mesh
         int stepLastReset_;
 
+        // rigid frame - transformations x' = R(q) x + d from original
+        // node pos to current pos (now), pos of node_ (mesh) and
+        // pos at last neigh build (re)
+        bool rigidFrame_;
+        double qNow_[4],dNow_[3];
+        double qMesh_[4],dMesh_[3];
+        double qRe_[4],dRe_[3];
+
+        // relative transformation from node_ to current pos
+        double relR_[3][3],relD_[3];
+
+        // bounding sphere of owned nodes at last neigh build
+        double reCenter_[3],reRadius_;
+
+        // mesh velocity field v(x) = v0 + L x
+        double rigidV0_[3],rigidL_[3][3];
+
+        void resetRigidTransform(double *q, double *d);
+        void composeRigid(double *q, double *d);
+        void calcRigidRelative();
+
         // extends a given bbox to include element number nElem
         void extendToElem(BoundingBox &box, int const nElem);
         void extendToElem(int const nElem);
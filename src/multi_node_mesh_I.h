@@ -44,8 +44,16 @@
     nTranslate_(0),
     nRotate_(0),
     random_(new RanPark(lmp,179424799)), // big prime #
-    mesh_id_(0)
+    mesh_id_(0),
+    rigidFrame_(false)
   {
+      resetRigidTransform(qNow_,dNow_);
+      resetRigidTransform(qMesh_,dMesh_);
+      resetRigidTransform(qRe_,dRe_);
+      calcRigidRelative();
+      vectorZeroize3D(reCenter_);
+      reRadius_ = 0.;
+      zeroRigidVelocity();
   }
 
   /* ----------------------------------------------------------------------
@@ -171,6 +179,20 @@
       if(node_orig_ && setupFlag)
         storeNodePosOrig(ilo,ihi);
 
+      // nodes have not been moved step by step, so update bbox here
+      // on setup, current pos becomes original pos of all transformations
+      if(isRigidFrame())
+      {
+        updateGlobalBoundingBox();
+        if(setupFlag)
+        {
+            resetRigidTransform(qNow_,dNow_);
+            resetRigidTransform(qMesh_,dMesh_);
+            resetRigidTransform(qRe_,dRe_);
+            calcRigidRelative();
+        }
+      }
+
       // nothing more to do here, necessary initialitation done in addElement()
   }
 
@@ -301,6 +323,12 @@
       if(isFirst)
       {
           int nall = sizeLocal()+sizeGhost();
+
+          resetRigidTransform(qNow_,dNow_);
+          resetRigidTransform(qMesh_,dMesh_);
+          resetRigidTransform(qRe_,dRe_);
+          calcRigidRelative();
+          zeroRigidVelocity();
           
           double **tmp;
           this->memory->template create<double>(tmp,NUM_NODES,3,"MultiNodeMesh:tmp");
@@ -326,6 +354,13 @@
   template<int NUM_NODES>
   void MultiNodeMesh<NUM_NODES>::unregisterMove(bool _scale, bool _translate, bool _rotate)
   {
+      // last mover leaves the mesh at its current pos, at rest
+      if(nMove_ == 1 && isRigidFrame())
+      {
+          zeroRigidVelocity();
+          updateRigidFrame();
+      }
+
       nMove_ --;
       if(_scale) nScale_--;
       if(_translate) nTranslate_--;
@@ -376,6 +411,14 @@
     {
         int nall = sizeLocal() + sizeGhost();
         stepLastReset_ = ntimestep;
+
+        // rigid frame: do not touch nodes, just reset transformation
+        if(isRigidFrame())
+        {
+            resetRigidTransform(qNow_,dNow_);
+            return true;
+        }
+
         for(int i = 0; i < nall; i++)
             for(int j = 0; j < NUM_NODES; j++)
                 vectorCopy3D(node_orig(i)[j],node_(i)[j]);
@@ -397,6 +440,14 @@
 
     resetToOrig();
 
+    if(isRigidFrame())
+    {
+        double q[4],d[3];
+        resetRigidTransform(q,d);
+        composeRigid(q,vecTotal);
+        return;
+    }
+
     int n = sizeLocal() + sizeGhost();
 
     for(int i = 0; i < n; i++)
@@ -490,6 +541,16 @@
 
     resetToOrig();
 
+    // rotation around origin: x' = R (x - origin) + origin
+    if(isRigidFrame())
+    {
+        double d[3];
+        MathExtraLiggghts::vec_quat_rotate(origin,totalQ,d);
+        vectorSubtract3D(origin,d,d);
+        composeRigid(totalQ,d);
+        return;
+    }
+
     int n = sizeLocal() + sizeGhost();
 
     bool trans = vectorMag3DSquared(origin) > 0.;
@@ -674,6 +735,158 @@
       box.extendToContain(node_(nElem)[i]);
   }
 
+  /* ----------------------------------------------------------------------
+   rigid frame for moving mesh
+   movements are accumulated in transformation x' = R(qNow_) x + dNow_
+   from the original node pos, nodes are updated only on demand
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::setRigidFrame()
+  {
+      rigidFrame_ = true;
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::resetRigidTransform(double *q, double *d)
+  {
+      q[0] = 1.;
+      q[1] = q[2] = q[3] = 0.;
+      vectorZeroize3D(d);
+  }
+
+  /* ----------------------------------------------------------------------
+   apply x' = R(q) x + d on top of current transformation
+   velocity field moves along with the mesh
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::composeRigid(double *q, double *d)
+  {
+      double qNew[4],dRot[3],R[3][3],L[3][3],Ld[3];
+
+      MathExtra::quatquat(q,qNow_,qNew);
+      MathExtra::qnormalize(qNew);
+      vectorCopy4D(qNew,qNow_);
+
+      MathExtraLiggghts::vec_quat_rotate(dNow_,q,dRot);
+      vectorAdd3D(dRot,d,dNow_);
+
+      // v(x') = v(x) = v0 + L R^T (x' - d)
+      MathExtra::quat_to_mat(q,R);
+      MathExtra::times3_transpose(rigidL_,R,L);
+      MathExtra::matvec(L,d,Ld);
+      vectorSubtract3D(rigidV0_,Ld,rigidV0_);
+      for(int i = 0; i < 3; i++)
+        vectorCopy3D(L[i],rigidL_[i]);
+
+      calcRigidRelative();
+  }
+
+  /* ----------------------------------------------------------------------
+   transformation from frame of node_ to current pos
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::rigidRelative(double *qRel, double *dRel)
+  {
+      double qMeshC[4],dRot[3];
+
+      MathExtra::qconjugate(qMesh_,qMeshC);
+      MathExtra::quatquat(qNow_,qMeshC,qRel);
+      MathExtra::qnormalize(qRel);
+
+      MathExtraLiggghts::vec_quat_rotate(dMesh_,qRel,dRot);
+      vectorSubtract3D(dNow_,dRot,dRel);
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::calcRigidRelative()
+  {
+      double qRel[4];
+
+      rigidRelative(qRel,relD_);
+      MathExtra::quat_to_mat(qRel,relR_);
+  }
+
+  template<int NUM_NODES>
+  bool MultiNodeMesh<NUM_NODES>::rigidFrameCurrent()
+  {
+      for(int i = 0; i < 4; i++)
+        if(qMesh_[i] != qNow_[i]) return false;
+      for(int i = 0; i < 3; i++)
+        if(dMesh_[i] != dNow_[i]) return false;
+      return true;
+  }
+
+  /* ----------------------------------------------------------------------
+   bring nodes of owned and ghost elements to current pos
+   local operation, bbox is updated on re-build
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::updateRigidFrame()
+  {
+    if(!isRigidFrame() || rigidFrameCurrent()) return;
+
+    double R[3][3];
+    MathExtra::quat_to_mat(qNow_,R);
+
+    int n = sizeLocal() + sizeGhost();
+
+    for(int i = 0; i < n; i++)
+    {
+        vectorZeroize3D(center_(i));
+
+        for(int j = 0; j < NUM_NODES; j++)
+        {
+            MathExtra::matvec(R,node_orig(i)[j],node_(i)[j]);
+            vectorAdd3D(node_(i)[j],dNow_,node_(i)[j]);
+            vectorAdd3D(node_(i)[j],center_(i),center_(i));
+        }
+        vectorScalarDiv3D(center_(i),static_cast<double>(NUM_NODES));
+    }
+
+    vectorCopy4D(qNow_,qMesh_);
+    vectorCopy3D(dNow_,dMesh_);
+    calcRigidRelative();
+  }
+
+  /* ----------------------------------------------------------------------
+   mesh velocity v(x) = v0 + L x, set by mesh movers
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::zeroRigidVelocity()
+  {
+      vectorZeroize3D(rigidV0_);
+      for(int i = 0; i < 3; i++)
+        vectorZeroize3D(rigidL_[i]);
+  }
+
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::addRigidVelocity(double *vel)
+  {
+      vectorAdd3D(rigidV0_,vel,rigidV0_);
+  }
+
+  // v(x) = omega x (x - p)
+  template<int NUM_NODES>
+  void MultiNodeMesh<NUM_NODES>::addRigidAngularVelocity(double *omega, double *p)
+  {
+      double omegaP[3];
+
+      rigidL_[0][1] -= omega[2];
+      rigidL_[0][2] += omega[1];
+      rigidL_[1][0] += omega[2];
+      rigidL_[1][2] -= omega[0];
+      rigidL_[2][0] -= omega[1];
+      rigidL_[2][1] += omega[0];
+
+      vectorCross3D(omega,p,omegaP);
+      vectorSubtract3D(rigidV0_,omegaP,rigidV0_);
+  }
+
   /* ----------------------------------------------------------------------
    decide if any node has moved far enough to trigger re-build
   ------------------------------------------------------------------------- */
@@ -690,6 +903,36 @@
     int nlocal = sizeLocal();
     double triggersq = 0.25*this->neighbor->skin*this->neighbor->skin;
 
+    // rigid frame: bound displacement of the bounding sphere of the
+    // owned nodes at last re-build by displacement of its center
+    // plus max displacement due to rotation 2 sin(phi/2) r
+    if(isRigidFrame())
+    {
+      if(nlocal > 0)
+      {
+        double qReC[4],qD[4],RD[3][3],dRot[3],cNew[3],deltaC[3];
+
+        MathExtra::qconjugate(qRe_,qReC);
+        MathExtra::quatquat(qNow_,qReC,qD);
+        MathExtra::qnormalize(qD);
+        MathExtra::quat_to_mat(qD,RD);
+
+        // T_d = T_now T_re^-1: x' = RD (x - dRe) + dNow
+        vectorSubtract3D(reCenter_,dRe_,dRot);
+        MathExtra::matvec(RD,dRot,cNew);
+        vectorAdd3D(cNew,dNow_,cNew);
+        vectorSubtract3D(cNew,reCenter_,deltaC);
+
+        double sinHalf = sqrt(MathExtraLiggghts::max(0.,1.-qD[0]*qD[0]));
+        double dist = vectorMag3D(deltaC) + 2.*sinHalf*reRadius_;
+        if(dist*dist > triggersq)
+          flag = 1;
+      }
+
+      MPI_Max_Scalar(flag,this->world);
+      return flag ? true : false;
+    }
+
     if(nlocal != nodesLastRe_.size())
         this->error->one(FLERR,"Internal error in MultiNodeMesh::decide_rebuild()");
 
@@ -728,6 +971,32 @@
     int nlocal = sizeLocal();
     double ***node = node_.begin();
 
+    // rigid frame: store transformation and bounding sphere of owned nodes
+    if(isRigidFrame())
+    {
+        updateRigidFrame();
+
+        vectorCopy4D(qNow_,qRe_);
+        vectorCopy3D(dNow_,dRe_);
+
+        vectorZeroize3D(reCenter_);
+        reRadius_ = 0.;
+        if(nlocal == 0) return;
+
+        for(int i = 0; i < nlocal; i++)
+            vectorAdd3D(center_(i),reCenter_,reCenter_);
+        vectorScalarDiv3D(reCenter_,static_cast<double>(nlocal));
+
+        double vec[3];
+        for(int i = 0; i < nlocal; i++)
+            for(int j = 0; j < NUM_NODES; j++)
+            {
+                vectorSubtract3D(node[i][j],reCenter_,vec);
+                reRadius_ = MathExtraLiggghts::max(reRadius_,vectorMag3D(vec));
+            }
+        return;
+    }
+
     nodesLastRe_.empty();
     for(int i = 0; i < nlocal; i++)
         nodesLastRe_.add(node[i]);
@@ -130,7 +130,7 @@ namespace LAMMPS_NS
 
         // lo-level parallelization
         int pushExchange(int dim);
-        void popExchange(int nrecv,int dim,double *buf);
+        int popExchange(int nrecv,int dim,double *buf,int from);
 
         int sizeRestartMesh();
         int sizeRestartElement();
@@ -590,6 +590,9 @@
       
       if(setupFlag) this->reset_stepLastReset();
 
+      // bring moving mesh in rigid frame to current pos
+      this->updateRigidFrame();
+
       // perform operations that should be done before setting up parallellism and exchanging elements
       preSetup();
 
@@ -698,7 +701,7 @@
       if(!doParallellization_) return;
 
       int nrecv, nsend = 0;
-      int nrecv1,nrecv2;
+      int nrecv1,nrecv2,ntransit;
       double *buf;
       MPI_Request request;
       MPI_Status status;
@@ -721,55 +724,73 @@
         for( int j = 0; j < 2; j++)
             procneigh[i][j] = this->comm->procneigh[i][j];
 
-      for (int dim = 0; dim < 3; dim++)
-      {
-          // push data to buffer
-          
-          nsend = pushExchange(dim);
+      // elements normally move at most one proc per dim
+      // repeat if elements have to travel further, e.g. after load-balancing
 
-          // send/recv in both directions
-          // if 1 proc in dimension, no send/recv, set recv buf to send buf
-          // if 2 procs in dimension, single send/recv
-          // if more than 2 procs in dimension, send/recv to both neighbors
+      do
+      {
+          ntransit = 0;
 
-          if (procgrid[dim] == 1)
-          {
-            nrecv = nsend;
-            buf = buf_send_;
-          }
-          else
+          for (int dim = 0; dim < 3; dim++)
           {
-            MPI_Sendrecv(&nsend,1,MPI_INT,procneigh[dim][0],0,&nrecv1,1,MPI_INT,procneigh[dim][1],0,world,&status);
-            nrecv = nrecv1;
+              // push data to buffer
+          
+              nsend = pushExchange(dim);
 
-            if (this->comm->procgrid[dim] > 2)
-            {
-                MPI_Sendrecv(&nsend,1,MPI_INT,procneigh[dim][1],0,&nrecv2,1,MPI_INT,procneigh[dim][0],0,world,&status);
-                nrecv += nrecv2;
-            }
+              // send/recv in both directions
+              // if 1 proc in dimension, no send/recv, set recv buf to send buf
+              // if 2 procs in dimension, single send/recv
+              // if more than 2 procs in dimension, send/recv to both neighbors
 
-            if (nrecv > maxrecv_) grow_recv(nrecv);
+              if (procgrid[dim] == 1)
+              {
+                nrecv = nsend;
+                buf = buf_send_;
+              }
+              else
+              {
+                MPI_Sendrecv(&nsend,1,MPI_INT,procneigh[dim][0],0,&nrecv1,1,MPI_INT,procneigh[dim][1],0,world,&status);
+                nrecv = nrecv1;
+
+                if (this->comm->procgrid[dim] > 2)
+                {
+                    MPI_Sendrecv(&nsend,1,MPI_INT,procneigh[dim][1],0,&nrecv2,1,MPI_INT,procneigh[dim][0],0,world,&status);
+                    nrecv += nrecv2;
+                }
 
-            MPI_Irecv(buf_recv_,nrecv1,MPI_DOUBLE,procneigh[dim][1],0,world,&request);
-            MPI_Send(buf_send_,nsend,MPI_DOUBLE,procneigh[dim][0],0,world);
-            MPI_Wait(&request,&status);
+                if (nrecv > maxrecv_) grow_recv(nrecv);
 
-            if (procgrid[dim] > 2)
-            {
-                MPI_Irecv(&buf_recv_[nrecv1],nrecv2,MPI_DOUBLE,procneigh[dim][0],0,world,&request);
-                MPI_Send(buf_send_,nsend,MPI_DOUBLE,procneigh[dim][1],0,world);
+                MPI_Irecv(buf_recv_,nrecv1,MPI_DOUBLE,procneigh[dim][1],0,world,&request);
+                MPI_Send(buf_send_,nsend,MPI_DOUBLE,procneigh[dim][0],0,world);
                 MPI_Wait(&request,&status);
-            }
 
-            buf = buf_recv_;
-          }
+                if (procgrid[dim] > 2)
+                {
+                    MPI_Irecv(&buf_recv_[nrecv1],nrecv2,MPI_DOUBLE,procneigh[dim][0],0,world,&request);
+                    MPI_Send(buf_send_,nsend,MPI_DOUBLE,procneigh[dim][1],0,world);
+                    MPI_Wait(&request,&status);
+                }
+
+                buf = buf_recv_;
+              }
 
-          // check incoming elements to see if they are in my box
-          // if so, add on this proc
+              // check incoming elements to see if they are in my box
+              // if so, add on this proc
+              // 1st part of buffer is from upper neighbor, 2nd from lower one
 
-          popExchange(nrecv,dim, buf);
+              if (procgrid[dim] > 2)
+              {
+                  ntransit += popExchange(nrecv1,dim,buf,1);
+                  ntransit += popExchange(nrecv-nrecv1,dim,&buf[nrecv1],0);
+              }
+              else
+                  popExchange(nrecv,dim,buf,-1);
           
+          }
+
+          MPI_Max_Scalar(ntransit,world);
       }
+      while(ntransit > 0);
 
       // re-calculate nGlobal as some element might have been lost
      MPI_Sum_Scalar(nLocal_,nGlobal_,world);
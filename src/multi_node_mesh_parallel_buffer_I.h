@@ -59,12 +59,32 @@
       return nsend;
   }
 
+  /* ----------------------------------------------------------------------
+   add elements received for exchange() that are in my slab in dim
+   from = 1 if sent by upper neighbor, 0 if by lower neighbor, -1 if unknown
+   also keep elements that have to travel further in the direction they
+   were sent, e.g. after sub-domain boundaries were moved by load-balancing
+   with more than 2 procs in dim, an element is taken only from the
+   neighbor it travels away from and never across the periodic wrap,
+   since it is sent to both neighbors and would arrive twice otherwise
+   return # of elements kept for further travel
+  ------------------------------------------------------------------------- */
+
   template<int NUM_NODES>
-  void MultiNodeMeshParallel<NUM_NODES>::popExchange(int nrecv,int dim,double *buf)
+  int MultiNodeMeshParallel<NUM_NODES>::popExchange(int nrecv,int dim,double *buf,int from)
   {
       double center_elem[3];
       double checklo,checkhi;
-      int m = 0, nrecv_this;
+      int m = 0, nrecv_this, ntransit = 0;
+
+      // elements only travel between neighbors in the grid
+      // not across the periodic boundary
+      int myloc = this->comm->myloc[dim];
+      bool haslower = myloc > 0;
+      bool hasupper = myloc < this->comm->procgrid[dim]-1;
+
+      if((from == 1 && !hasupper) || (from == 0 && !haslower))
+        return 0;
 
       // scale translate rotate not needed here
       bool dummy = false;
@@ -89,9 +109,18 @@
             nLocal_++;
             
           }
+          else if((from == 1 && haslower && center_elem[dim] < checklo) ||
+                  (from == 0 && hasupper && center_elem[dim] >= checkhi))
+          {
+            popElemFromBuffer(&(buf[m+1]),OPERATION_COMM_EXCHANGE,dummy,dummy,dummy);
+            nLocal_++;
+            ntransit++;
+          }
           
           m += nrecv_this;
       }
+
+      return ntransit;
   }
 
   /* ----------------------------------------------------------------------
@@ -104,6 +133,9 @@
   {
       int size_this;
 
+      // write current pos of moving mesh in rigid frame
+      this->updateRigidFrame();
+
       // # elements
       int nlocal = this->sizeLocal();
       int nglobal = sizeGlobal();
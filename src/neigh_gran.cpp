@@ -25,6 +25,7 @@
 #include "neigh_list.h"
 #include "atom.h"
 #include "group.h"
+#include "domain.h"
 #include "fix_contact_history.h" 
 #include "error.h"
 
@@ -636,3 +637,405 @@ void Neighbor::granular_bin_newton_tri(NeighList *list)
 
   list->inum = inum;
 }
+
+/* ----------------------------------------------------------------------
+   granular particles
+   multi-level binned neighbor list construction with partial Newton's 3rd law
+   shear history must be accounted for when a neighbor pair is added
+   particles are binned by radius level, each level in bins sized by its
+     largest particles, so small particles do not search large bins
+   own/own pair of same level stored once if i < j
+   own/own pair of different levels stored once by the lower-level atom
+   pair stored by me if j is ghost (also stored by proc owning j)
+------------------------------------------------------------------------- */
+
+void Neighbor::granular_multi_no_newton(NeighList *list)
+{
+  int i,j,k,m,n,nn,li,lj,ibin,ns,d;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  double radi,radsum,cutsq,cutlevel;
+  int *neighptr,*touchptr,*s;
+  double *shearptr;
+
+  NeighList *listgranhistory;
+  int *npartner,**partner;
+  double ***contacthistory;
+  int **firsttouch;
+  double **firstshear;
+  int **pages_touch;
+  double **pages_shear;
+  int dnum;
+
+  // bin local & ghost atoms by radius level
+
+  bin_atoms_level();
+
+  // loop over each atom, storing neighbors
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int *tag = atom->tag;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  int *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int **pages = list->pages;
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  double *sublo = domain->sublo;
+  double *subhi = domain->subhi;
+
+  FixContactHistory *fix_history = list->fix_history;
+  if (fix_history) {
+    npartner = fix_history->npartner;
+    partner = fix_history->partner;
+    contacthistory = fix_history->contacthistory;
+    listgranhistory = list->listgranhistory;
+    firsttouch = listgranhistory->firstneigh;
+    firstshear = listgranhistory->firstdouble;
+    pages_touch = listgranhistory->pages;
+    pages_shear = listgranhistory->dpages;
+    dnum = listgranhistory->dnum;
+  }
+
+  int inum = 0;
+  int npage = 0;
+  int npnt = 0;
+
+  for (i = 0; i < nlocal; i++) {
+
+    if (pgsize - npnt < oneatom) {
+      npnt = 0;
+      npage++;
+      if (npage == list->maxpage) {
+        pages = list->add_pages();
+        if (fix_history) {
+          pages_touch = listgranhistory->add_pages();
+          pages_shear = listgranhistory->dpages;
+        }
+      }
+    }
+
+    n = 0;
+    neighptr = &pages[npage][npnt];
+    if (fix_history) {
+      nn = 0;
+      touchptr = &pages_touch[npage][npnt];
+      shearptr = &pages_shear[npage][dnum*npnt];
+    }
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    radi = radius[i];
+    li = atomlevel[i];
+
+    // loop over atoms of all levels in stencil of level pair li,lj
+    // same level: only store pair if i < j
+    // lower level: only ghosts, own/own pairs are stored by the other atom
+    //   ghosts can only be in range if i is close to the subdomain boundary
+
+    for (lj = 0; lj < nlevels; lj++) {
+      if (lj < li && !triclinic) {
+        cutlevel = radi + rmaxlevel[lj] + skin;
+        if (xtmp-sublo[0] > cutlevel && subhi[0]-xtmp > cutlevel &&
+            ytmp-sublo[1] > cutlevel && subhi[1]-ytmp > cutlevel &&
+            (dimension == 2 ||
+             (ztmp-sublo[2] > cutlevel && subhi[2]-ztmp > cutlevel)))
+          continue;
+      }
+
+      ibin = levelbin[lj].offset + coord2bin_level(x[i],lj);
+      s = stencil_multigran[li][lj];
+      ns = nstencil_multigran[li][lj];
+
+      for (k = 0; k < ns; k++) {
+        for (j = levelhead[ibin+s[k]]; j >= 0; j = levelbins[j]) {
+          if (lj == li) {
+            if (j <= i) continue;
+          } else if (lj < li && j < nlocal) continue;
+          if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+          radsum = radi + radius[j];
+          cutsq = (radsum+skin) * (radsum+skin);
+
+          if (rsq <= cutsq) {
+            neighptr[n] = j;
+
+            if (fix_history) {
+              if (rsq < radsum*radsum) {
+                for (m = 0; m < npartner[i]; m++)
+                  if (partner[i][m] == tag[j]) break;
+                if (m < npartner[i]) {
+                  touchptr[n] = 1;
+                  for (d = 0; d < dnum; d++)
+                    shearptr[nn++] = contacthistory[i][m][d];
+                } else {
+                  touchptr[n] = 0;
+                  for (d = 0; d < dnum; d++)
+                    shearptr[nn++] = 0.0;
+                }
+              } else {
+                touchptr[n] = 0;
+                for (d = 0; d < dnum; d++)
+                  shearptr[nn++] = 0.0;
+              }
+            }
+
+            n++;
+          }
+        }
+      }
+    }
+
+    ilist[inum++] = i;
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    if (fix_history) {
+      firsttouch[i] = touchptr;
+      firstshear[i] = shearptr;
+    }
+    npnt += n;
+    if (n > oneatom)
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = inum;
+}
+
+/* ----------------------------------------------------------------------
+   granular particles
+   multi-level binned neighbor list construction with full Newton's 3rd law
+   no shear history is allowed for this option
+   each owned atom i checks its own level in Newton stencil
+     and all higher levels in full stencils
+   every pair stored exactly once by some processor
+------------------------------------------------------------------------- */
+
+void Neighbor::granular_multi_newton(NeighList *list)
+{
+  int i,j,k,n,li,lj,ibin,ns;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  double radi,radsum,cutsq;
+  int *neighptr,*s;
+
+  // bin local & ghost atoms by radius level
+
+  bin_atoms_level();
+
+  // loop over each atom, storing neighbors
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  int *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int **pages = list->pages;
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  int inum = 0;
+  int npage = 0;
+  int npnt = 0;
+
+  for (i = 0; i < nlocal; i++) {
+
+    if (pgsize - npnt < oneatom) {
+      npnt = 0;
+      npage++;
+      if (npage == list->maxpage) pages = list->add_pages();
+    }
+
+    n = 0;
+    neighptr = &pages[npage][npnt];
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    radi = radius[i];
+    li = atomlevel[i];
+
+    // loop over rest of atoms in i's level bin, ghosts are at end of list
+    // if j is owned atom, store it, since j is beyond i in linked list
+    // if j is ghost, only store if j coords are "above and to the right" of i
+
+    for (j = levelbins[i]; j >= 0; j = levelbins[j]) {
+      if (j >= nlocal) {
+        if (x[j][2] < ztmp) continue;
+        if (x[j][2] == ztmp) {
+          if (x[j][1] < ytmp) continue;
+          if (x[j][1] == ytmp && x[j][0] < xtmp) continue;
+        }
+      }
+
+      if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      radsum = radi + radius[j];
+      cutsq = (radsum+skin) * (radsum+skin);
+
+      if (rsq <= cutsq) neighptr[n++] = j;
+    }
+
+    // loop over other bins of own level and all bins of higher levels
+    // in stencil of level pair li,lj, store every pair
+    // pairs with lower levels are stored by the other atom
+
+    for (lj = li; lj < nlevels; lj++) {
+      ibin = levelbin[lj].offset + coord2bin_level(x[i],lj);
+      s = stencil_multigran[li][lj];
+      ns = nstencil_multigran[li][lj];
+
+      for (k = 0; k < ns; k++) {
+        for (j = levelhead[ibin+s[k]]; j >= 0; j = levelbins[j]) {
+          if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+          radsum = radi + radius[j];
+          cutsq = (radsum+skin) * (radsum+skin);
+
+          if (rsq <= cutsq) neighptr[n++] = j;
+        }
+      }
+    }
+
+    ilist[inum++] = i;
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    npnt += n;
+    if (n > oneatom)
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = inum;
+}
+
+/* ----------------------------------------------------------------------
+   granular particles
+   multi-level binned neighbor list construction with Newton's 3rd law
+     for triclinic
+   no shear history is allowed for this option
+   each owned atom i checks its own level in triclinic stencil
+     and all higher levels in full stencils
+   every pair stored exactly once by some processor
+------------------------------------------------------------------------- */
+
+void Neighbor::granular_multi_newton_tri(NeighList *list)
+{
+  int i,j,k,n,li,lj,ibin,ns;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq;
+  double radi,radsum,cutsq;
+  int *neighptr,*s;
+
+  // bin local & ghost atoms by radius level
+
+  bin_atoms_level();
+
+  // loop over each atom, storing neighbors
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  int *molecule = atom->molecule;
+  int nlocal = atom->nlocal;
+  if (includegroup) nlocal = atom->nfirst;
+
+  int *ilist = list->ilist;
+  int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  int **pages = list->pages;
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  int inum = 0;
+  int npage = 0;
+  int npnt = 0;
+
+  for (i = 0; i < nlocal; i++) {
+
+    if (pgsize - npnt < oneatom) {
+      npnt = 0;
+      npage++;
+      if (npage == list->maxpage) pages = list->add_pages();
+    }
+
+    n = 0;
+    neighptr = &pages[npage][npnt];
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    radi = radius[i];
+    li = atomlevel[i];
+
+    // loop over all atoms of own and higher levels in stencil of li,lj
+    // pairs of same level for atoms j "below" i are excluded
+    // below = lower z or (equal z and lower y) or (equal zy and lower x)
+    //         (equal zyx and j <= i)
+    // pairs with lower levels are stored by the other atom
+
+    for (lj = li; lj < nlevels; lj++) {
+      ibin = levelbin[lj].offset + coord2bin_level(x[i],lj);
+      s = stencil_multigran[li][lj];
+      ns = nstencil_multigran[li][lj];
+
+      for (k = 0; k < ns; k++) {
+        for (j = levelhead[ibin+s[k]]; j >= 0; j = levelbins[j]) {
+          if (lj == li) {
+            if (x[j][2] < ztmp) continue;
+            if (x[j][2] == ztmp) {
+              if (x[j][1] < ytmp) continue;
+              if (x[j][1] == ytmp) {
+                if (x[j][0] < xtmp) continue;
+                if (x[j][0] == xtmp && j <= i) continue;
+              }
+            }
+          }
+
+          if (exclude && exclusion(i,j,type[i],type[j],mask,molecule)) continue;
+
+          delx = xtmp - x[j][0];
+          dely = ytmp - x[j][1];
+          delz = ztmp - x[j][2];
+          rsq = delx*delx + dely*dely + delz*delz;
+          radsum = radi + radius[j];
+          cutsq = (radsum+skin) * (radsum+skin);
+
+          if (rsq <= cutsq) neighptr[n++] = j;
+        }
+      }
+    }
+
+    ilist[inum++] = i;
+    firstneigh[i] = neighptr;
+    numneigh[i] = n;
+    npnt += n;
+    if (n > oneatom)
+      error->one(FLERR,"Neighbor list overflow, boost neigh_modify one");
+  }
+
+  list->inum = inum;
+}
@@ -40,6 +40,11 @@ using namespace LAMMPS_NS;
      create one stencil for each atom type
      stencil is same bin bounds as newton on/off, triclinic, half/full
      cutoff is not cutneighmaxsq, but max cutoff for that atom type
+   for granular multi:
+     create one stencil for each pair of radius levels li,lj
+     stencil is in bins of level lj, cutoff is rmax(li) + rmax(lj) + skin
+     with newton on, only stencils with li <= lj are non-empty
+     2d and 3d are handled by the same routine
 ------------------------------------------------------------------------- */
 
 /* ---------------------------------------------------------------------- */
@@ -490,3 +495,137 @@ void Neighbor::stencil_full_multi_3d(NeighList *list,
     nstencil_multi[itype] = n;
   }
 }
+
+/* ---------------------------------------------------------------------- */
+
+void Neighbor::stencil_gran_multi_no_newton(NeighList *list,
+                                            int sx, int sy, int sz)
+{
+  int i,j,k,n,li,lj;
+  int lsx,lsy,lsz;
+  double cut,cutsq;
+  int *s;
+  LevelBins *lb;
+
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  for (li = 0; li < nlevels; li++) {
+    list->rmin_multigran[li] = li ? rmaxlevel[li-1] : 0.;
+    list->rmax_multigran[li] = rmaxlevel[li];
+    for (lj = 0; lj < nlevels; lj++) {
+      lb = &levelbin[lj];
+      cut = rmaxlevel[li] + rmaxlevel[lj] + skin;
+      cutsq = cut*cut;
+      stencil_level_extent(cut,lj,lsx,lsy,lsz);
+      s = stencil_multigran[li][lj];
+      n = 0;
+      for (k = -lsz; k <= lsz; k++)
+        for (j = -lsy; j <= lsy; j++)
+          for (i = -lsx; i <= lsx; i++)
+            if (bin_distance_level(i,j,k,lj) < cutsq)
+              s[n++] = k*lb->mbiny*lb->mbinx + j*lb->mbinx + i;
+      nstencil_multigran[li][lj] = n;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Neighbor::stencil_gran_multi_newton(NeighList *list,
+                                         int sx, int sy, int sz)
+{
+  int i,j,k,n,li,lj;
+  int lsx,lsy,lsz;
+  double cut,cutsq;
+  int *s;
+  LevelBins *lb;
+
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  for (li = 0; li < nlevels; li++) {
+    list->rmin_multigran[li] = li ? rmaxlevel[li-1] : 0.;
+    list->rmax_multigran[li] = rmaxlevel[li];
+    for (lj = 0; lj < nlevels; lj++) {
+      n = 0;
+      if (lj < li) {
+        nstencil_multigran[li][lj] = n;
+        continue;
+      }
+      lb = &levelbin[lj];
+      cut = rmaxlevel[li] + rmaxlevel[lj] + skin;
+      cutsq = cut*cut;
+      stencil_level_extent(cut,lj,lsx,lsy,lsz);
+      s = stencil_multigran[li][lj];
+      if (lj == li) {
+        for (k = 0; k <= lsz; k++)
+          for (j = -lsy; j <= lsy; j++)
+            for (i = -lsx; i <= lsx; i++)
+              if (k > 0 || j > 0 || (j == 0 && i > 0))
+                if (bin_distance_level(i,j,k,lj) < cutsq)
+                  s[n++] = k*lb->mbiny*lb->mbinx + j*lb->mbinx + i;
+      } else {
+        for (k = -lsz; k <= lsz; k++)
+          for (j = -lsy; j <= lsy; j++)
+            for (i = -lsx; i <= lsx; i++)
+              if (bin_distance_level(i,j,k,lj) < cutsq)
+                s[n++] = k*lb->mbiny*lb->mbinx + j*lb->mbinx + i;
+      }
+      nstencil_multigran[li][lj] = n;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Neighbor::stencil_gran_multi_newton_tri(NeighList *list,
+                                             int sx, int sy, int sz)
+{
+  int i,j,k,n,li,lj;
+  int lsx,lsy,lsz;
+  double cut,cutsq;
+  int *s;
+  LevelBins *lb;
+
+  int **nstencil_multigran = list->nstencil_multigran;
+  int ***stencil_multigran = list->stencil_multigran;
+
+  for (li = 0; li < nlevels; li++) {
+    list->rmin_multigran[li] = li ? rmaxlevel[li-1] : 0.;
+    list->rmax_multigran[li] = rmaxlevel[li];
+    for (lj = 0; lj < nlevels; lj++) {
+      n = 0;
+      if (lj < li) {
+        nstencil_multigran[li][lj] = n;
+        continue;
+      }
+      lb = &levelbin[lj];
+      cut = rmaxlevel[li] + rmaxlevel[lj] + skin;
+      cutsq = cut*cut;
+      stencil_level_extent(cut,lj,lsx,lsy,lsz);
+      s = stencil_multigran[li][lj];
+      if (lj == li) {
+        if (dimension == 2) {
+          for (j = 0; j <= lsy; j++)
+            for (i = -lsx; i <= lsx; i++)
+              if (bin_distance_level(i,j,0,lj) < cutsq)
+                s[n++] = j*lb->mbinx + i;
+        } else {
+          for (k = 0; k <= lsz; k++)
+            for (j = -lsy; j <= lsy; j++)
+              for (i = -lsx; i <= lsx; i++)
+                if (bin_distance_level(i,j,k,lj) < cutsq)
+                  s[n++] = k*lb->mbiny*lb->mbinx + j*lb->mbinx + i;
+        }
+      } else {
+        for (k = -lsz; k <= lsz; k++)
+          for (j = -lsy; j <= lsy; j++)
+            for (i = -lsx; i <= lsx; i++)
+              if (bin_distance_level(i,j,k,lj) < cutsq)
+                s[n++] = k*lb->mbiny*lb->mbinx + j*lb->mbinx + i;
+      }
+      nstencil_multigran[li][lj] = n;
+    }
+  }
+}
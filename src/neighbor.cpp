@@ -59,6 +59,7 @@ using namespace LAMMPS_NS;
 #define SMALL 1.0e-6
 #define BIG 1.0e20
 #define CUT2BIN_RATIO 100
+#define MAXLEVEL 16
 
 enum{NSQ,BIN,MULTI};     // also in neigh_list.cpp
 
@@ -99,6 +100,15 @@ Neighbor::Neighbor(LAMMPS *lmp) : Pointers(lmp)
   maxbin = 0;
   bins = NULL;
 
+  nlevels = 0;
+  rmaxlevel = NULL;
+  levelbin = NULL;
+  maxlevelhead = 0;
+  levelhead = NULL;
+  maxlevelatom = 0;
+  atomlevel = levelbins = NULL;
+  levelbinned = 0;
+
   // pair exclusion list info
 
   includegroup = 0;
@@ -162,6 +172,12 @@ Neighbor::~Neighbor()
   memory->destroy(binhead);
   memory->destroy(bins);
 
+  delete [] rmaxlevel;
+  delete [] levelbin;
+  memory->destroy(levelhead);
+  memory->destroy(atomlevel);
+  memory->destroy(levelbins);
+
   memory->destroy(ex1_type);
   memory->destroy(ex2_type);
   memory->destroy(ex_type);
@@ -273,10 +289,39 @@ void Neighbor::init()
   }
   cutneighmaxsq = cutneighmax * cutneighmax;
 
+  // radius levels for granular lists with style multi
+  // factor 2 in radius between levels, top level up to largest particle
+
+  nlevels = 0;
+  levelbinned = 0;
+  delete [] rmaxlevel;
+  delete [] levelbin;
+  rmaxlevel = NULL;
+  levelbin = NULL;
+
   if(atom->radius_flag) {
     double maxrd,minrd;
     modify->max_min_rad(maxrd,minrd);
     cutneighmin = MIN(cutneighmin,2*minrd+skin);
+
+    if (style == MULTI) {
+      if (minrd > maxrd) minrd = maxrd;
+      rminlevel = minrd;
+      nlevels = 1;
+      double rlevel = 2.*minrd;
+      while (rlevel > 0. && rlevel <= maxrd && nlevels < MAXLEVEL) {
+        nlevels++;
+        rlevel *= 2.;
+      }
+      rmaxlevel = new double[nlevels];
+      levelbin = new LevelBins[nlevels];
+      rlevel = 2.*minrd;
+      for (i = 0; i < nlevels; i++) {
+        rmaxlevel[i] = MIN(rlevel,maxrd);
+        rlevel *= 2.;
+      }
+      rmaxlevel[nlevels-1] = maxrd;
+    }
   }
 
   // check other classes that can induce reneighboring in decide()
@@ -906,12 +951,10 @@ void Neighbor::choose_build(int index, NeighRequest *rq)
         if (newton_pair == 0) pb = &Neighbor::granular_bin_no_newton;
         else if (triclinic == 0) pb = &Neighbor::granular_bin_newton;
         else if (triclinic == 1) pb = &Neighbor::granular_bin_newton_tri;
-      } else if (style == MULTI) { 
-        if (0) {}
-        else if (1 == triclinic) error->all(FLERR,"Neighbor multi not yet enabled for granular with triclinic");
-        else if (1 == newton_pair) error->all(FLERR,"Neighbor multi not yet enabled for granular with newton on");
-        else if (0 == newton_pair) pb = &Neighbor::granular_multi_no_newton;
-        else error->all(FLERR,"Neighbor multi not yet enabled for granular");
+      } else if (style == MULTI) {
+        if (newton_pair == 0) pb = &Neighbor::granular_multi_no_newton;
+        else if (triclinic == 0) pb = &Neighbor::granular_multi_newton;
+        else if (triclinic == 1) pb = &Neighbor::granular_multi_newton_tri;
       }
 
     } else if (rq->respaouter) {
@@ -1075,18 +1118,14 @@ void Neighbor::choose_stencil(int index, NeighRequest *rq)
       }
 
     } else if (style == MULTI) {
-      
-      if(rq->gran) {
-          if(rq->newton == 1 || (rq->newton == 0 && newton_pair == 1))
-            error->all(FLERR,"Neigh multi with gran requires newton off");
-          if(triclinic == 1)
-            error->all(FLERR,"Neigh multi with gran requires triclinic off");
-          if(dimension == 2)
-            error->all(FLERR,"Neigh multi with gran requires dimension 3");
-          sc = &Neighbor::stencil_gran_multi_3d_no_newton;
-      }
-
-      else if (rq->newton == 0) {  
+      if (rq->gran) {
+        if (newton_pair == 0)
+          sc = &Neighbor::stencil_gran_multi_no_newton;
+        else if (triclinic == 0)
+          sc = &Neighbor::stencil_gran_multi_newton;
+        else if (triclinic == 1)
+          sc = &Neighbor::stencil_gran_multi_newton_tri;
+      } else if (rq->newton == 0) {
         if (newton_pair == 0) {
           if (dimension == 2)
             sc = &Neighbor::stencil_half_multi_2d_no_newton;
@@ -1587,6 +1626,10 @@ void Neighbor::setup_bins()
   if (dimension == 2) sz = 0;
   smax = (2*sx+1) * (2*sy+1) * (2*sz+1);
 
+  // bins of radius levels, stencils must also fit each pair of levels
+
+  if (nlevels) smax = MAX(smax,setup_level_bins(bbox,bsubboxlo,bsubboxhi));
+
   // create stencils for pairwise neighbor lists
   // only done for lists with stencilflag and buildflag set
 
@@ -1596,6 +1639,115 @@ void Neighbor::setup_bins()
   }
 }
 
+/* ----------------------------------------------------------------------
+   setup bins of each radius level, same as setup_bins() for main bins
+   all levels cover the same bounding box of my subdomain and ghosts
+   binsize = 1/2 of neighbor cutoff between largest particles of level
+   return max size of a stencil between two levels
+------------------------------------------------------------------------- */
+
+int Neighbor::setup_level_bins(double *bbox, double *bsubboxlo,
+                               double *bsubboxhi)
+{
+  int l,m,mbinxhi,mbinyhi,mbinzhi;
+  double coord,binsize_optimal,binsizeinv;
+  LevelBins *lb;
+
+  int nbins = 0;
+  for (l = 0; l < nlevels; l++) {
+    lb = &levelbin[l];
+    binsize_optimal = rmaxlevel[l] + 0.5*skin;
+    if (binsize_optimal == 0.0) binsize_optimal = bbox[0];
+    binsizeinv = 1.0/binsize_optimal;
+
+    if (bbox[0]*binsizeinv > MAXSMALLINT || bbox[1]*binsizeinv > MAXSMALLINT ||
+        bbox[2]*binsizeinv > MAXSMALLINT)
+      error->all(FLERR,"Domain too large for neighbor bins");
+
+    lb->nbinx = static_cast<int> (bbox[0]*binsizeinv);
+    lb->nbiny = static_cast<int> (bbox[1]*binsizeinv);
+    if (dimension == 3) lb->nbinz = static_cast<int> (bbox[2]*binsizeinv);
+    else lb->nbinz = 1;
+
+    if (lb->nbinx == 0) lb->nbinx = 1;
+    if (lb->nbiny == 0) lb->nbiny = 1;
+    if (lb->nbinz == 0) lb->nbinz = 1;
+
+    lb->binsizex = bbox[0]/lb->nbinx;
+    lb->binsizey = bbox[1]/lb->nbiny;
+    lb->binsizez = bbox[2]/lb->nbinz;
+
+    lb->bininvx = 1.0 / lb->binsizex;
+    lb->bininvy = 1.0 / lb->binsizey;
+    lb->bininvz = 1.0 / lb->binsizez;
+
+    if (binsize_optimal*lb->bininvx > CUT2BIN_RATIO ||
+        binsize_optimal*lb->bininvy > CUT2BIN_RATIO ||
+        binsize_optimal*lb->bininvz > CUT2BIN_RATIO)
+      error->all(FLERR,"Cannot use neighbor bins - box size << cutoff");
+
+    coord = bsubboxlo[0] - SMALL*bbox[0];
+    lb->mbinxlo = static_cast<int> ((coord-bboxlo[0])*lb->bininvx);
+    if (coord < bboxlo[0]) lb->mbinxlo = lb->mbinxlo - 1;
+    coord = bsubboxhi[0] + SMALL*bbox[0];
+    mbinxhi = static_cast<int> ((coord-bboxlo[0])*lb->bininvx);
+
+    coord = bsubboxlo[1] - SMALL*bbox[1];
+    lb->mbinylo = static_cast<int> ((coord-bboxlo[1])*lb->bininvy);
+    if (coord < bboxlo[1]) lb->mbinylo = lb->mbinylo - 1;
+    coord = bsubboxhi[1] + SMALL*bbox[1];
+    mbinyhi = static_cast<int> ((coord-bboxlo[1])*lb->bininvy);
+
+    if (dimension == 3) {
+      coord = bsubboxlo[2] - SMALL*bbox[2];
+      lb->mbinzlo = static_cast<int> ((coord-bboxlo[2])*lb->bininvz);
+      if (coord < bboxlo[2]) lb->mbinzlo = lb->mbinzlo - 1;
+      coord = bsubboxhi[2] + SMALL*bbox[2];
+      mbinzhi = static_cast<int> ((coord-bboxlo[2])*lb->bininvz);
+    }
+
+    lb->mbinxlo = lb->mbinxlo - 1;
+    mbinxhi = mbinxhi + 1;
+    lb->mbinx = mbinxhi - lb->mbinxlo + 1;
+
+    lb->mbinylo = lb->mbinylo - 1;
+    mbinyhi = mbinyhi + 1;
+    lb->mbiny = mbinyhi - lb->mbinylo + 1;
+
+    if (dimension == 3) {
+      lb->mbinzlo = lb->mbinzlo - 1;
+      mbinzhi = mbinzhi + 1;
+    } else lb->mbinzlo = mbinzhi = 0;
+    lb->mbinz = mbinzhi - lb->mbinzlo + 1;
+
+    bigint bbin = ((bigint) lb->mbinx)*lb->mbiny*lb->mbinz;
+    if (bbin + nbins > MAXSMALLINT) error->one(FLERR,"Too many neighbor bins");
+    lb->mbins = bbin;
+    lb->offset = nbins;
+    nbins += lb->mbins;
+  }
+
+  if (nbins > maxlevelhead) {
+    maxlevelhead = nbins;
+    memory->destroy(levelhead);
+    memory->create(levelhead,maxlevelhead,"neigh:levelhead");
+  }
+
+  // stencil of level pair l,m lives in bins of level m
+
+  int lsx,lsy,lsz;
+  double cut;
+  int lsmax = 0;
+  for (l = 0; l < nlevels; l++)
+    for (m = 0; m < nlevels; m++) {
+      cut = rmaxlevel[l] + rmaxlevel[m] + skin;
+      stencil_level_extent(cut,m,lsx,lsy,lsz);
+      lsmax = MAX(lsmax,(2*lsx+1) * (2*lsy+1) * (2*lsz+1));
+    }
+
+  return lsmax;
+}
+
 /* ----------------------------------------------------------------------
    compute closest distance between central bin (0,0,0) and bin (i,j,k)
 ------------------------------------------------------------------------- */
@@ -1619,6 +1771,31 @@ double Neighbor::bin_distance(int i, int j, int k)
   return (delx*delx + dely*dely + delz*delz);
 }
 
+/* ----------------------------------------------------------------------
+   compute closest distance between central bin (0,0,0) and bin (i,j,k)
+   in bins of radius level l
+------------------------------------------------------------------------- */
+
+double Neighbor::bin_distance_level(int i, int j, int k, int l)
+{
+  double delx,dely,delz;
+  LevelBins *lb = &levelbin[l];
+
+  if (i > 0) delx = (i-1)*lb->binsizex;
+  else if (i == 0) delx = 0.0;
+  else delx = (i+1)*lb->binsizex;
+
+  if (j > 0) dely = (j-1)*lb->binsizey;
+  else if (j == 0) dely = 0.0;
+  else dely = (j+1)*lb->binsizey;
+
+  if (k > 0) delz = (k-1)*lb->binsizez;
+  else if (k == 0) delz = 0.0;
+  else delz = (k+1)*lb->binsizez;
+
+  return (delx*delx + dely*dely + delz*delz);
+}
+
 /* ----------------------------------------------------------------------
    compute largest distance between central bin (0,0,0) and bin (i,j,k)
 ------------------------------------------------------------------------- */
@@ -1807,6 +1984,167 @@ void Neighbor::bin_atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   bin bounds of a stencil with cutoff cut in bins of radius level l
+------------------------------------------------------------------------- */
+
+void Neighbor::stencil_level_extent(double cut, int l,
+                                    int &lsx, int &lsy, int &lsz)
+{
+  LevelBins *lb = &levelbin[l];
+
+  lsx = static_cast<int> (cut*lb->bininvx);
+  if (lsx*lb->binsizex < cut) lsx++;
+  lsy = static_cast<int> (cut*lb->bininvy);
+  if (lsy*lb->binsizey < cut) lsy++;
+  lsz = static_cast<int> (cut*lb->bininvz);
+  if (lsz*lb->binsizez < cut) lsz++;
+  if (dimension == 2) lsz = 0;
+}
+
+/* ----------------------------------------------------------------------
+   bin owned and ghost atoms into bins of their radius level
+   same ordering as bin_atoms(), ghosts are at end of each linked list
+   main bins are filled as well, since fixes may use them
+------------------------------------------------------------------------- */
+
+void Neighbor::bin_atoms_level()
+{
+  int i,l,ibin;
+
+  bin_atoms();
+
+  double **x = atom->x;
+  double *radius = atom->radius;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  if (atom->nmax > maxlevelatom) {
+    maxlevelatom = atom->nmax;
+    memory->destroy(atomlevel);
+    memory->destroy(levelbins);
+    memory->create(atomlevel,maxlevelatom,"neigh:atomlevel");
+    memory->create(levelbins,maxlevelatom,"neigh:levelbins");
+  }
+
+  int nbins = levelbin[nlevels-1].offset + levelbin[nlevels-1].mbins;
+  for (i = 0; i < nbins; i++) levelhead[i] = -1;
+
+  if (includegroup) {
+    int bitmask = group->bitmask[includegroup];
+    for (i = nall-1; i >= nlocal; i--) {
+      if (mask[i] & bitmask) {
+        l = atomlevel[i] = radius2level(radius[i]);
+        ibin = levelbin[l].offset + coord2bin_level(x[i],l);
+        levelbins[i] = levelhead[ibin];
+        levelhead[ibin] = i;
+      }
+    }
+    for (i = atom->nfirst-1; i >= 0; i--) {
+      l = atomlevel[i] = radius2level(radius[i]);
+      ibin = levelbin[l].offset + coord2bin_level(x[i],l);
+      levelbins[i] = levelhead[ibin];
+      levelhead[ibin] = i;
+    }
+
+  } else {
+    for (i = nall-1; i >= 0; i--) {
+      l = atomlevel[i] = radius2level(radius[i]);
+      ibin = levelbin[l].offset + coord2bin_level(x[i],l);
+      levelbins[i] = levelhead[ibin];
+      levelhead[ibin] = i;
+    }
+  }
+
+  levelbinned = 1;
+}
+
+/* ----------------------------------------------------------------------
+   # of radius levels used by granular multi lists, 0 if none
+------------------------------------------------------------------------- */
+
+int Neighbor::multi_levels()
+{
+  return nlevels;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Neighbor::multi_levels(double &maxrad, double &minrad, int &n)
+{
+  n = nlevels;
+  if (nlevels == 0) {
+    maxrad = minrad = 0.;
+    return;
+  }
+  minrad = rminlevel;
+  maxrad = rmaxlevel[nlevels-1];
+}
+
+/* ----------------------------------------------------------------------
+   radius level of a particle
+   particles outside of the radius range go to lowest or highest level
+------------------------------------------------------------------------- */
+
+int Neighbor::radius2level(double radius)
+{
+  int l = 0;
+  double rlevel = 2.*rminlevel;
+  while (radius >= rlevel && l < nlevels-1) {
+    l++;
+    rlevel *= 2.;
+  }
+  return l;
+}
+
+/* ----------------------------------------------------------------------
+   convert atom coords into local bin # of radius level l
+   same as coord2bin() for the bins of the level
+------------------------------------------------------------------------- */
+
+int Neighbor::coord2bin_level(double *x, int l)
+{
+  int ix,iy,iz;
+  return coord2bin_level(x,l,ix,iy,iz);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int Neighbor::coord2bin_level(double *x, int l, int &ix, int &iy, int &iz)
+{
+  LevelBins *lb = &levelbin[l];
+
+  if (x[0] >= bboxhi[0])
+    ix = static_cast<int> ((x[0]-bboxhi[0])*lb->bininvx) + lb->nbinx;
+  else if (x[0] >= bboxlo[0]) {
+    ix = static_cast<int> ((x[0]-bboxlo[0])*lb->bininvx);
+    ix = MIN(ix,lb->nbinx-1);
+  } else
+    ix = static_cast<int> ((x[0]-bboxlo[0])*lb->bininvx) - 1;
+
+  if (x[1] >= bboxhi[1])
+    iy = static_cast<int> ((x[1]-bboxhi[1])*lb->bininvy) + lb->nbiny;
+  else if (x[1] >= bboxlo[1]) {
+    iy = static_cast<int> ((x[1]-bboxlo[1])*lb->bininvy);
+    iy = MIN(iy,lb->nbiny-1);
+  } else
+    iy = static_cast<int> ((x[1]-bboxlo[1])*lb->bininvy) - 1;
+
+  if (x[2] >= bboxhi[2])
+    iz = static_cast<int> ((x[2]-bboxhi[2])*lb->bininvz) + lb->nbinz;
+  else if (x[2] >= bboxlo[2]) {
+    iz = static_cast<int> ((x[2]-bboxlo[2])*lb->bininvz);
+    iz = MIN(iz,lb->nbinz-1);
+  } else
+    iz = static_cast<int> ((x[2]-bboxlo[2])*lb->bininvz) - 1;
+
+  ix -= lb->mbinxlo;
+  iy -= lb->mbinylo;
+  iz -= lb->mbinzlo;
+  return (iz*lb->mbiny + iy)*lb->mbinx + ix;
+}
+
 /* ----------------------------------------------------------------------
    convert atom coords into local bin #
    for orthogonal, only ghost atoms will have coord >= bboxhi or coord < bboxlo
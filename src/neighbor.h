@@ -32,6 +32,7 @@ class Neighbor : protected Pointers {
   friend class Cuda;
   
   friend class FixNeighlistMesh;
+  friend class PrimitiveWall;
   friend class OneLevelGrid;
   
   friend class FixHeatGranRad;
@@ -95,8 +96,8 @@ class Neighbor : protected Pointers {
   int neigh_once(){return build_once;} 
   int n_neighs(); 
 
-  void multi_levels(double &, double &, int &);
-  int multi_levels();
+  void multi_levels(double &, double &, int &);  // radius levels of
+  int multi_levels();                            // granular multi lists
 
  protected:
   int me,nprocs;
@@ -139,6 +140,31 @@ class Neighbor : protected Pointers {
   int binsizeflag;                 // user-chosen bin size
   double binsize_user;
 
+  // radius levels for granular lists with neighbor style multi
+  // level l holds particles with rminlevel*2^l <= radius < rminlevel*2^(l+1)
+  // each level has its own bins, sized by the largest particles of the level
+
+  struct LevelBins {
+    int nbinx,nbiny,nbinz;           // # of global bins
+    int mbinx,mbiny,mbinz;           // # of local bins and offset
+    int mbinxlo,mbinylo,mbinzlo;
+    int mbins;
+    double binsizex,binsizey,binsizez;
+    double bininvx,bininvy,bininvz;
+    int offset;                      // 1st bin of level in levelhead
+  };
+
+  int nlevels;                     // # of radius levels, 0 if not used
+  double rminlevel;                // smallest radius of level 0
+  double *rmaxlevel;               // largest radius in each level
+  LevelBins *levelbin;             // bins of each level
+  int *levelhead;                  // ptr to 1st atom in each bin, all levels
+  int maxlevelhead;                // size of levelhead array
+  int *atomlevel;                  // level of each atom
+  int *levelbins;                  // ptr to next atom in same level bin
+  int maxlevelatom;                // size of atomlevel, levelbins arrays
+  int levelbinned;                 // 1 if level bins were filled this run
+
   double binsizex,binsizey,binsizez;  // actual bin sizes and inverse sizes
   double bininvx,bininvy,bininvz;
 
@@ -184,6 +210,13 @@ class Neighbor : protected Pointers {
   int *slist;                  // lists to grow stencil arrays every reneigh
 
   void bin_atoms();                     // bin all atoms
+  void bin_atoms_level();               // bin all atoms in their level
+  int setup_level_bins(double *, double *, double *);
+  int radius2level(double);
+  int coord2bin_level(double *, int);
+  int coord2bin_level(double *, int, int &, int &, int &);
+  double bin_distance_level(int, int, int, int);
+  void stencil_level_extent(double, int, int &, int &, int &);
   double bin_distance(int, int, int);   // distance between binx
   double bin_largest_distance(int, int, int); 
   int coord2bin(double *);              // mapping atom coord to a bin
@@ -234,8 +267,9 @@ class Neighbor : protected Pointers {
   void granular_bin_no_newton(class NeighList *);
   void granular_bin_newton(class NeighList *);
   void granular_bin_newton_tri(class NeighList *);
-
-  void granular_multi_no_newton(class NeighList *); 
+  void granular_multi_no_newton(class NeighList *);
+  void granular_multi_newton(class NeighList *);
+  void granular_multi_newton_tri(class NeighList *);
 
   void respa_nsq_no_newton(class NeighList *);
   void respa_nsq_newton(class NeighList *);
@@ -273,7 +307,9 @@ class Neighbor : protected Pointers {
   void stencil_full_multi_2d(class NeighList *, int, int, int);
   void stencil_full_multi_3d(class NeighList *, int, int, int);
 
-  void stencil_gran_multi_3d_no_newton(NeighList *,int, int, int); 
+  void stencil_gran_multi_no_newton(class NeighList *, int, int, int);
+  void stencil_gran_multi_newton(class NeighList *, int, int, int);
+  void stencil_gran_multi_newton_tri(class NeighList *, int, int, int);
 
   // topology build functions
 
@@ -502,22 +502,33 @@ void Output::create_restart(int narg, char **arg)
 
   restart = new WriteRestart(lmp);
 
-  if (narg != 2 && narg != 3) error->all(FLERR,"Illegal restart command");
+  // trailing fileper/nfile keywords are passed on to WriteRestart
+
+  int nfiles = 1;
+  while (nfiles < narg && strcmp(arg[nfiles],"fileper") &&
+         strcmp(arg[nfiles],"nfile")) nfiles++;
+  nfiles--;
+  if (nfiles != 1 && nfiles != 2) error->all(FLERR,"Illegal restart command");
+  if (nfiles+1 < narg) restart->multiproc_options(narg-nfiles-1,&arg[nfiles+1]);
 
   int n = strlen(arg[1]) + 3;
   restart1 = new char[n];
   strcpy(restart1,arg[1]);
 
-  if (narg == 2) {
+  if (nfiles == 1) {
     restart_toggle = 0;
     restart2 = NULL;
     if (strchr(restart1,'*') == NULL) strcat(restart1,".*");
-  } else if (narg == 3) {
+  } else {
     restart_toggle = 1;
     n = strlen(arg[2]) + 1;
     restart2 = new char[n];
     strcpy(restart2,arg[2]);
-  } else error->all(FLERR,"Illegal restart command");
+  }
+
+  if ((strchr(restart1,'%') == NULL ||
+       (restart2 && strchr(restart2,'%') == NULL)) && nfiles+1 < narg)
+    error->all(FLERR,"Restart file name must contain % to use fileper or nfile");
 }
 
 /* ----------------------------------------------------------------------
@@ -56,6 +56,8 @@
 
 using namespace LAMMPS_NS;
 
+#define DELTA_CONTACTBUFFER 10000
+
 /* ---------------------------------------------------------------------- */
 
 PairGran::PairGran(LAMMPS *lmp) : Pair(lmp)
@@ -86,7 +88,17 @@ PairGran::PairGran(LAMMPS *lmp) : Pair(lmp)
 
   computeflag = 0;
 
+  coeffcacheflag = 0;
+
   needs_neighlist = true;
+
+  contactbufferflag = 0;
+  contactbuffer_enable = false;
+  fillcontactbuffer = 0;
+  ncontactbuffer = maxcontactbuffer = 0;
+  cbuf_i = cbuf_j = NULL;
+  cbuf_r = NULL;
+  contactbuffer_step = -1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -122,6 +134,10 @@ PairGran::~PairGran()
 
   if(fix_dnum) delete []fix_dnum;
   if(dnum_index) delete []dnum_index;
+
+  memory->destroy(cbuf_i);
+  memory->destroy(cbuf_j);
+  memory->destroy(cbuf_r);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -433,6 +449,8 @@ void PairGran::init_style()
   MPI_Allreduce(&onerad_frozen[1],&maxrad_frozen[1],atom->ntypes,MPI_DOUBLE,MPI_MAX,world);
 
   init_granular();
+
+  if(coeffcacheflag) init_coeff_cache();
 }
 
 /* ----------------------------------------------------------------------
@@ -513,7 +531,34 @@ void PairGran::compute(int eflag, int vflag)
    shearupdate = 1;
    if (update->setupflag) shearupdate = 0;
 
-   compute_force(eflag,vflag,0);
+   fillcontactbuffer = contactbufferflag && contactbuffer_enable;
+   if(fillcontactbuffer) ncontactbuffer = 0;
+
+   // hand contacts to compute pair/gran/local if it is due on this step
+   int addflag = (cpl && cpl->begin_capture()) ? 1 : 0;
+
+   compute_force(eflag,vflag,addflag);
+
+   if(fillcontactbuffer) contactbuffer_step = update->ntimestep;
+   fillcontactbuffer = 0;
+}
+
+/* ----------------------------------------------------------------------
+   contact buffer holds the pairs found touching in the force pass
+   of the current time-step
+------------------------------------------------------------------------- */
+
+bool PairGran::contact_buffer_valid()
+{
+   return contactbuffer_step == update->ntimestep;
+}
+
+void PairGran::grow_contact_buffer()
+{
+   maxcontactbuffer += DELTA_CONTACTBUFFER;
+   memory->grow(cbuf_i,maxcontactbuffer,"pair_gran:cbuf_i");
+   memory->grow(cbuf_j,maxcontactbuffer,"pair_gran:cbuf_j");
+   memory->grow(cbuf_r,maxcontactbuffer,"pair_gran:cbuf_r");
 }
 
 /* ----------------------------------------------------------------------
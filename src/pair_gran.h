@@ -51,6 +51,7 @@ class PairGran : public Pair {
   virtual void coeff(int, char **);
   virtual void init_style();
   virtual void init_granular() {} 
+  virtual void init_coeff_cache() {}
   virtual void init_list(int, class NeighList *);
   virtual double init_one(int, int);
   int pack_comm(int n, int *list,double *buf, int pbc_flag, int *pbc);
@@ -79,6 +80,22 @@ class PairGran : public Pair {
 
   class MechParamGran *mpg;
 
+  // per-step buffer of touching pairs, filled during the force pass
+  // lets per-contact physics (e.g. heat conduction) skip a second
+  // traversal of the neighbor list
+
+  void request_contact_buffer()
+  { contactbufferflag = 1; }
+  bool contact_buffer_valid();
+  int n_contact_buffer()
+  { return ncontactbuffer; }
+  int *contact_buffer_i()
+  { return cbuf_i; }
+  int *contact_buffer_j()
+  { return cbuf_j; }
+  double *contact_buffer_r()
+  { return cbuf_r; }
+
   int fix_extra_dnum_index(class Fix *fix);
 
   void *extract(const char *str, int &dim);
@@ -127,11 +144,33 @@ class PairGran : public Pair {
 
   int computeflag;
 
+  // cached coefficient mode, tables are built in init_coeff_cache()
+  int coeffcacheflag;
+
   double *onerad_dynamic,*onerad_frozen;
   double *maxrad_dynamic,*maxrad_frozen;
 
   bool needs_neighlist;
 
+  // contact buffer, only filled by styles that set contactbuffer_enable
+  int contactbufferflag;
+  bool contactbuffer_enable;
+  int fillcontactbuffer;
+  int ncontactbuffer,maxcontactbuffer;
+  int *cbuf_i,*cbuf_j;
+  double *cbuf_r;
+  bigint contactbuffer_step;
+  void grow_contact_buffer();
+
+  inline void add_contact_buffer(int i,int j,double r)
+  {
+    if(ncontactbuffer == maxcontactbuffer) grow_contact_buffer();
+    cbuf_i[ncontactbuffer] = i;
+    cbuf_j[ncontactbuffer] = j;
+    cbuf_r[ncontactbuffer] = r;
+    ncontactbuffer++;
+  }
+
   void allocate();
 
  private:
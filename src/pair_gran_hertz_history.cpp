@@ -34,6 +34,7 @@
 #include "error.h"
 #include "modify.h"
 #include "mech_param_gran.h"
+#include "memory.h"
 
 using namespace LAMMPS_NS;
 
@@ -62,6 +63,18 @@ inline void PairGranHertzHistory::deriveContactModelParams(int &ip, int &jp,doub
 
     double sqrtval = sqrt(reff*deltan);
 
+    if(coeffcacheflag)
+    {
+        double sqrtmeff = sqrt(sqrtval*meff);
+        kn=knPrefactor[itype][jtype]*sqrtval;
+        kt=ktPrefactor[itype][jtype]*sqrtval;
+        gamman=gammanPrefactor[itype][jtype]*sqrtmeff;
+        gammat=gammatPrefactor[itype][jtype]*sqrtmeff;
+        xmu=coeffFrict[itype][jtype];
+        if(rollingflag)rmu=coeffRollFrict[itype][jtype];
+        return;
+    }
+
     double Sn=2.*Yeff[itype][jtype]*sqrtval;
     double St=8.*Geff[itype][jtype]*sqrtval;
 
@@ -85,3 +98,33 @@ inline void PairGranHertzHistory::deriveContactModelParams(int &ip, int &jp,doub
 
     return;
 }
+
+/* ----------------------------------------------------------------------
+   build per-type pair tables for cached coefficient mode
+   unit conversion of kn, kt is included in the prefactors
+------------------------------------------------------------------------- */
+
+void PairGranHertzHistory::init_coeff_cache()
+{
+  int max_type = mpg->max_type();
+
+  memory->destroy(knPrefactor);
+  memory->destroy(ktPrefactor);
+  memory->destroy(gammanPrefactor);
+  memory->destroy(gammatPrefactor);
+  memory->create(knPrefactor,max_type+1,max_type+1,"knPrefactor");
+  memory->create(ktPrefactor,max_type+1,max_type+1,"ktPrefactor");
+  memory->create(gammanPrefactor,max_type+1,max_type+1,"gammanPrefactor");
+  memory->create(gammatPrefactor,max_type+1,max_type+1,"gammatPrefactor");
+
+  for(int i=1;i< max_type+1; i++)
+  {
+      for(int j=1;j<max_type+1;j++)
+      {
+          knPrefactor[i][j] = 4./3.*Yeff[i][j]/force->nktv2p;
+          ktPrefactor[i][j] = 8.*Geff[i][j]/force->nktv2p;
+          gammanPrefactor[i][j] = -2.*sqrtFiveOverSix*betaeff[i][j]*sqrt(2.*Yeff[i][j]);
+          gammatPrefactor[i][j] = dampflag ? -2.*sqrtFiveOverSix*betaeff[i][j]*sqrt(8.*Geff[i][j]) : 0.;
+      }
+  }
+}
@@ -56,6 +56,9 @@ void PairGranHertzHistorySimple::settings(int narg, char **arg)
 {
     PairGranHookeHistory::settings(narg,arg);
 
+    if(coeffcacheflag)
+        error->all(FLERR,"Illegal pair_style gran command, 'coefficient_cache' is not supported by the stiffness based pair styles");
+
     // set defaults
     damp_massflag = 1;
 
@@ -113,6 +113,8 @@ void PairGranHooke::compute_force(int eflag, int vflag,int addflag)
         rinv = 1.0/r;
         rsqinv = 1.0/rsq;
 
+        if (fillcontactbuffer) add_contact_buffer(i,j,r);
+
         // relative translational velocity
 
         vr1 = v[i][0] - v[j][0];
@@ -51,8 +51,7 @@
 
 using namespace LAMMPS_NS;
 
-#define MIN(a,b) ((a) < (b) ? (a) : (b))
-#define MAX(a,b) ((a) > (b) ? (a) : (b))
+#define N_CLASS_BITS 10 // # of mantissa bits of a size class, 2^N_CLASS_BITS classes per octave
 
 /* ---------------------------------------------------------------------- */
 
@@ -62,6 +61,9 @@ PairGranHookeHistory::PairGranHookeHistory(LAMMPS *lmp) : PairGran(lmp)
     history = 1;
     dnum_pairgran = 3;
 
+    // the serial kernels fill the contact buffer
+    contactbuffer_enable = true;
+
     Yeff = NULL;
     Geff = NULL;
     betaeff = NULL;
@@ -74,6 +76,13 @@ PairGranHookeHistory::PairGranHookeHistory(LAMMPS *lmp) : PairGran(lmp)
     coeffRestMax = NULL;
     coeffStc = NULL;
 
+    knPrefactor = NULL;
+    ktPrefactor = NULL;
+    gammanPrefactor = NULL;
+    gammatPrefactor = NULL;
+    reffPowExp = reffPowMant = NULL;
+    meffPowExp = meffPowMant = NULL;
+
     charVelflag = 1;
 
     force_off = false;
@@ -95,6 +104,15 @@ PairGranHookeHistory::~PairGranHookeHistory()
     memory->destroy(coeffMu);
     memory->destroy(coeffRestMax);
     memory->destroy(coeffStc);
+
+    memory->destroy(knPrefactor);
+    memory->destroy(ktPrefactor);
+    memory->destroy(gammanPrefactor);
+    memory->destroy(gammatPrefactor);
+    memory->destroy(reffPowExp);
+    memory->destroy(reffPowMant);
+    memory->destroy(meffPowExp);
+    memory->destroy(meffPowMant);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -128,6 +146,17 @@ inline void PairGranHookeHistory::addCohesionForce(int &ip, int &jp,double &r, d
 
 /* ---------------------------------------------------------------------- */
 
+inline double PairGranHookeHistory::classPow(double x,double *powExp,double *powMant)
+{
+    // size class of x > 0 are the exponent and the leading mantissa bits
+    // of its bit pattern, i.e. log-spaced bins with relative width 2^-N_CLASS_BITS
+    uint64_t bits;
+    memcpy(&bits,&x,sizeof(double));
+    return powExp[bits >> 52] * powMant[(bits >> (52-N_CLASS_BITS)) & ((1 << N_CLASS_BITS)-1)];
+}
+
+/* ---------------------------------------------------------------------- */
+
 inline void PairGranHookeHistory::deriveContactModelParams(int &ip, int &jp,double &meff,double &deltan, double &kn, double &kt, double &gamman, double &gammat, double &xmu, double &rmu, double &vnnr) 
 {
     int itype = atom->type[ip];
@@ -137,6 +166,28 @@ inline void PairGranHookeHistory::deriveContactModelParams(int &ip, int &jp,doub
     double reff=ri*rj/(ri+rj);
     double stokes, coeffRestLogChosen;
 
+    if(coeffcacheflag)
+    {
+        // kn = prefactor * reff^(2/5) * meff^(1/5), both powers are taken
+        // from the tables of the size class of reff and meff
+        double knRaw = knPrefactor[itype][jtype]*classPow(reff,reffPowExp,reffPowMant)*classPow(meff,meffPowExp,meffPowMant);
+        double sqrtMeffKn = sqrt(meff*knRaw);
+
+        kn = kt = knRaw/force->nktv2p;
+
+        if (viscousflag)  {
+           stokes=meff*vnnr/(6.0*3.1416*coeffMu[itype][jtype]*reff*reff);
+           coeffRestLogChosen=log(coeffRestMax[itype][jtype])+coeffStc[itype][jtype]/stokes;
+           gamman=2.*sqrtMeffKn/sqrt(1.+(M_PI/coeffRestLogChosen)*(M_PI/coeffRestLogChosen));
+        } else {
+           gamman=gammanPrefactor[itype][jtype]*sqrtMeffKn;
+        }
+        gammat = dampflag ? gamman : 0.;
+        xmu=coeffFrict[itype][jtype];
+        if(rollingflag)rmu=coeffRollFrict[itype][jtype];
+        return;
+    }
+
     if (viscousflag)  {
        // Stokes Number from MW Schmeeckle (2001)
        stokes=meff*vnnr/(6.0*3.1416*coeffMu[itype][jtype]*reff*reff);
@@ -164,6 +215,52 @@ inline void PairGranHookeHistory::deriveContactModelParams(int &ip, int &jp,doub
 /* ---------------------------------------------------------------------- */
 
 void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
+{
+  if (eflag || vflag) ev_setup(eflag,vflag);
+  else evflag = vflag_fdotr = 0;
+
+  // pick one fully specialized kernel per call
+  // mode 0 = evaluation for compute pair/gran/local only
+  // mode 1 = force evaluation without shear update (setup)
+  // mode 2 = force evaluation with shear update
+
+  int mode = computeflag ? (shearupdate ? 2 : 1) : 0;
+
+  if(cohesionflag) compute_force_dispatch<1>(mode,addflag);
+  else             compute_force_dispatch<0>(mode,addflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int COHESIONFLAG>
+void PairGranHookeHistory::compute_force_dispatch(int mode,int addflag)
+{
+  if(rollingflag)
+  {
+    if(fix_rigid) compute_force_dispatch_mode<COHESIONFLAG,1,1>(mode,addflag);
+    else          compute_force_dispatch_mode<COHESIONFLAG,1,0>(mode,addflag);
+  }
+  else
+  {
+    if(fix_rigid) compute_force_dispatch_mode<COHESIONFLAG,0,1>(mode,addflag);
+    else          compute_force_dispatch_mode<COHESIONFLAG,0,0>(mode,addflag);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int COHESIONFLAG,int ROLLINGFLAG,int RIGIDFLAG>
+void PairGranHookeHistory::compute_force_dispatch_mode(int mode,int addflag)
+{
+  if(mode == 2)      compute_force_eval<COHESIONFLAG,ROLLINGFLAG,RIGIDFLAG,2>(addflag);
+  else if(mode == 1) compute_force_eval<COHESIONFLAG,ROLLINGFLAG,RIGIDFLAG,1>(addflag);
+  else               compute_force_eval<COHESIONFLAG,ROLLINGFLAG,RIGIDFLAG,0>(addflag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int COHESIONFLAG,int ROLLINGFLAG,int RIGIDFLAG,int MODE>
+void PairGranHookeHistory::compute_force_eval(int addflag)
 {
   //calculated from the material properties 
   double kn,kt,gamman,gammat,xmu,rmu; 
@@ -182,9 +279,6 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
   int *touch,**firsttouch;
   double *shear,*allshear,**firstshear;
 
-  if (eflag || vflag) ev_setup(eflag,vflag);
-  else evflag = vflag_fdotr = 0;
-
   double **x = atom->x;
   double **v = atom->v;
   double **f = atom->f;
@@ -243,6 +337,8 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
         rinv = 1.0/r;
         rsqinv = 1.0/rsq;
 
+        if (MODE && fillcontactbuffer) add_contact_buffer(i,j,r);
+
         // relative translational velocity
 
         vr1 = v[i][0] - v[j][0];
@@ -286,7 +382,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
           mi = mass[itype];
           mj = mass[jtype];
         }
-        if (fix_rigid)
+        if (RIGIDFLAG)
         {
            if(body[i] >= 0) mi = masstotal[body[i]];
            if(body[j] >= 0) mj = masstotal[body[j]];
@@ -303,7 +399,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
         damp = gamman*vnnr*rsqinv;  
         ccel = kn*(radsum-r)*rinv - damp;
         
-        if (cohesionflag) { 
+        if (COHESIONFLAG) {
             addCohesionForce(i,j,r,Fn_coh);
             ccel-=Fn_coh*rinv;
         }
@@ -322,7 +418,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
 
         shear = &allshear[dnum_pairgran*jj];
 
-        if (shearupdate && computeflag)
+        if (MODE == 2)
         {
             shear[0] += vtr1*dt;
             shear[1] += vtr2*dt;
@@ -381,7 +477,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
 
         // add rolling friction torque
         vectorZeroize3D(r_torque);
-        if(rollingflag)
+        if(ROLLINGFLAG)
         {
             vectorSubtract3D(omega[i],omega[j],wr_roll);
             wr_rollmag = vectorMag3D(wr_roll);
@@ -401,7 +497,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
             }
         }
 
-        if(computeflag)
+        if(MODE)
         {
             f[i][0] += fx;
             f[i][1] += fy;
@@ -411,7 +507,7 @@ void PairGranHookeHistory::compute_force(int eflag, int vflag,int addflag)
             torque[i][2] -= cri*tor3 + r_torque[2];
         }
 
-        if (j < nlocal && computeflag) {
+        if (MODE && j < nlocal) {
           f[j][0] -= fx;
           f[j][1] -= fy;
           f[j][2] -= fz;
@@ -443,6 +539,7 @@ void PairGranHookeHistory::settings(int narg, char **arg)
     cohesionflag = 0;
     viscousflag = 0;
     force_off = false;
+    coeffcacheflag = 0;
 
     // parse args
 
@@ -507,6 +604,17 @@ void PairGranHookeHistory::settings(int narg, char **arg)
                 error->all(FLERR,"Illegal pair_style gran command, expecting 'stokes' or 'off' after keyword 'viscous'");
             iarg_++;
             hasargs = true;
+        } else if (strcmp(arg[iarg_],"coefficient_cache") == 0) {
+            if (narg < iarg_+2) error->all(FLERR,"Pair gran: not enough arguments for 'coefficient_cache'");
+            iarg_++;
+            if(strcmp(arg[iarg_],"on") == 0)
+                coeffcacheflag = 1;
+            else if(strcmp(arg[iarg_],"off") == 0)
+                coeffcacheflag = 0;
+            else
+                error->all(FLERR,"Illegal pair_style gran command, expecting 'on' or 'off' after keyword 'coefficient_cache'");
+            iarg_++;
+            hasargs = true;
         } else if (force->pair_match("gran/hooke/history",1) || force->pair_match("gran/hertz/history",1))
             error->all(FLERR,"Illegal pair_style gran command, illegal keyword");
     }
@@ -583,6 +691,62 @@ void PairGranHookeHistory::init_granular()
   if(charVelflag) charVel = charVel1->compute_scalar();
 }
 
+/* ----------------------------------------------------------------------
+   build per-type pair tables for cached coefficient mode
+   kn = 16/15 Yeff^(4/5) (15/16 charVel^2)^(1/5) (reff^2 meff)^(1/5)
+------------------------------------------------------------------------- */
+
+void PairGranHookeHistory::init_coeff_cache()
+{
+  int max_type = mpg->max_type();
+
+  memory->destroy(knPrefactor);
+  memory->destroy(ktPrefactor);
+  memory->destroy(gammanPrefactor);
+  memory->destroy(gammatPrefactor);
+  memory->create(knPrefactor,max_type+1,max_type+1,"knPrefactor");
+  memory->create(ktPrefactor,max_type+1,max_type+1,"ktPrefactor");
+  memory->create(gammanPrefactor,max_type+1,max_type+1,"gammanPrefactor");
+  memory->create(gammatPrefactor,max_type+1,max_type+1,"gammatPrefactor");
+
+  for(int i=1;i< max_type+1; i++)
+  {
+      for(int j=1;j<max_type+1;j++)
+      {
+          double pilog = M_PI/coeffRestLog[i][j];
+
+          knPrefactor[i][j] = 16./15.*pow(Yeff[i][j],0.8)*pow(15./16.*charVel*charVel,0.2);
+          ktPrefactor[i][j] = knPrefactor[i][j];
+          gammanPrefactor[i][j] = sqrt(4./(1.+pilog*pilog));
+          gammatPrefactor[i][j] = dampflag ? gammanPrefactor[i][j] : 0.;
+      }
+  }
+
+  // reff^(2/5) and meff^(1/5) per size class, see classPow()
+  // x^a = 2^(a*exponent) * mantissa^a, the mantissa is taken at the class center
+  // tables do not depend on the material, so they are built only once
+
+  if(reffPowExp) return;
+
+  int nexp = 2048, nmant = 1 << N_CLASS_BITS;
+  memory->create(reffPowExp,nexp,"reffPowExp");
+  memory->create(meffPowExp,nexp,"meffPowExp");
+  memory->create(reffPowMant,nmant,"reffPowMant");
+  memory->create(meffPowMant,nmant,"meffPowMant");
+
+  for(int i = 0; i < nexp; i++)
+  {
+      reffPowExp[i] = pow(2.,0.4*(i-1023));
+      meffPowExp[i] = pow(2.,0.2*(i-1023));
+  }
+  for(int i = 0; i < nmant; i++)
+  {
+      double mant = 1.+(i+0.5)/nmant;
+      reffPowMant[i] = pow(mant,0.4);
+      meffPowMant[i] = pow(mant,0.2);
+  }
+}
+
 /* ----------------------------------------------------------------------
   allocate per-type and per-type pair properties
 ------------------------------------------------------------------------- */
@@ -48,6 +48,7 @@ class PairGranHookeHistory : public PairGran {
 
   virtual void settings(int, char **);
   virtual void init_granular(); 
+  virtual void init_coeff_cache();
 
   virtual void compute_force(int eflag, int vflag, int addflag);
 
@@ -59,6 +60,14 @@ class PairGranHookeHistory : public PairGran {
   virtual void history_args(char**);
   void allocate_properties(int);
 
+  // specialized force kernels, selected once per compute_force() call
+  template <int COHESIONFLAG>
+  void compute_force_dispatch(int mode,int addflag);
+  template <int COHESIONFLAG,int ROLLINGFLAG,int RIGIDFLAG>
+  void compute_force_dispatch_mode(int mode,int addflag);
+  template <int COHESIONFLAG,int ROLLINGFLAG,int RIGIDFLAG,int MODE>
+  void compute_force_eval(int addflag);
+
   bool forceoff()
   { return force_off; }
 
@@ -80,6 +89,13 @@ class PairGranHookeHistory : public PairGran {
   double **Yeff,**Geff,**betaeff,**veff,**cohEnergyDens,**coeffRestLog,**coeffFrict;
   double charVel, **coeffRollFrict,**coeffMu,**coeffRestMax,**coeffStc;
 
+  // cached coefficient mode:
+  // per-type pair prefactors of the contact model parameters plus tables
+  // of reff^(2/5) and meff^(1/5) over log-spaced size classes
+  double **knPrefactor,**ktPrefactor,**gammanPrefactor,**gammatPrefactor;
+  double *reffPowExp,*reffPowMant,*meffPowExp,*meffPowMant;
+  inline double classPow(double x,double *powExp,double *powMant);
+
   virtual void deriveContactModelParams(int &ip, int &jp,double &meff,double &deltan, double &kn, double &kt, double &gamman, double &gammat, double &xmu, double &rmu,double &vnnr);
   virtual void addCohesionForce(int &, int &,double &,double &);
 
@@ -62,6 +62,9 @@ void PairGranHookeSimple::settings(int narg, char **arg)
 {
     PairGranHooke::settings(narg,arg);
 
+    if(coeffcacheflag)
+        error->all(FLERR,"Illegal pair_style gran command, 'coefficient_cache' is not supported by the stiffness based pair styles");
+
     // set defaults
     damp_massflag = 1;
 
@@ -59,6 +59,8 @@ PairSphArtviscTenscorr::PairSphArtviscTenscorr(LAMMPS *lmp) : PairSph(lmp)
 
   csmean = NULL;
   wDeltaPTypeinv = NULL;
+
+  compute_kernel = NULL;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -143,6 +145,28 @@ void PairSphArtviscTenscorr::settings(int narg, char **arg)
       iarg += 3;
     } else error->all(FLERR, "Illegal pair_style sph command");
   }
+
+  select_compute_kernel();
+}
+
+/* ----------------------------------------------------------------------
+   pick the compute_eval() instantiation for mass_type and kernel
+------------------------------------------------------------------------- */
+
+void PairSphArtviscTenscorr::select_compute_kernel()
+{
+  compute_kernel = NULL;
+
+  if (0) return;
+  #define SPH_KERNEL_CLASS
+  #define SPHKernel(id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+  else if (kernel_id == id) \
+    compute_kernel = mass_type ? &PairSphArtviscTenscorr::compute_eval<1,id> : &PairSphArtviscTenscorr::compute_eval<0,id>;
+  #include "style_sph_kernel.h"
+  #undef SPH_KERNEL_CLASS
+  #undef SPHKernel
+
+  if (!compute_kernel) error->all(FLERR, "Illegal pair_style sph command, unknown sph kernel");
 }
 
 /* ----------------------------------------------------------------------
@@ -236,8 +260,7 @@ void PairSphArtviscTenscorr::allocate_properties(int size)
 
 void PairSphArtviscTenscorr::compute(int eflag, int vflag)
 {
-  if (mass_type) compute_eval<1>(eflag,vflag);
-  else compute_eval<0>(eflag,vflag);
+  (this->*compute_kernel)(eflag,vflag);
 }
 
 /* ----------------------------------------------------------------------
@@ -361,7 +384,7 @@ void PairSphArtviscTenscorr::tensileCorrection(int itype, int jtype, double rhoi
    template compute
 ------------------------------------------------------------------------- */
 
-template <int MASSFLAG>
+template <int MASSFLAG,int KERNEL>
 void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
 {
   int i,j,ii,jj,inum,jnum,itype,jtype;
@@ -474,7 +497,7 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
         s = r * slComInv;
 
         // calculate value for magnitude of grad W
-        gradWmag = SPH_KERNEL_NS::sph_kernel_der(kernel_id,s,slCom,slComInv);
+        gradWmag = SPH_KERNEL_NS::sph_kernel_der<KERNEL>(s,slCom,slComInv);
 
         // artificial viscosity
         artVisc = 0.0;
@@ -513,11 +536,11 @@ void PairSphArtviscTenscorr::compute_eval(int eflag, int vflag)
           if (MASSFLAG) {
             wDeltaPinv = wDeltaPTypeinv[itype][jtype];
           } else {
-            wDeltaPinv = 1./SPH_KERNEL_NS::sph_kernel(kernel_id,deltaP * slComInv,slCom,slComInv);
+            wDeltaPinv = 1./SPH_KERNEL_NS::sph_kernel<KERNEL>(deltaP * slComInv,slCom,slComInv);
           }
 
           //TODO: Is fAB4 in this form ok?!
-          fAB =  SPH_KERNEL_NS::sph_kernel(kernel_id,s,slCom,slComInv) * wDeltaPinv;
+          fAB =  SPH_KERNEL_NS::sph_kernel<KERNEL>(s,slCom,slComInv) * wDeltaPinv;
           fAB2 = fAB * fAB;
           fAB4 = fAB2 * fAB2;
 
@@ -60,7 +60,12 @@ class PairSphArtviscTenscorr : public PairSph {
 //  void allocate_properties(int);
 //  double artificialViscosity(int, int, int, int, double, double, double, double, double, double, double, double **);
 //  template <int> void tensileCorrection(int, int, double, double, double, double, double, double, double, double &, double &);
-  template <int> void compute_eval(int, int);
+  template <int,int> void compute_eval(int, int);
+
+  // compute_eval() instantiation for mass_type and kernel, set in settings()
+  typedef void (PairSphArtviscTenscorr::*FnPtrCompute)(int, int);
+  FnPtrCompute compute_kernel;
+  void select_compute_kernel();
 
   class   FixPropertyGlobal* cs;
   double  **csmean;
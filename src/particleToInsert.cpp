@@ -28,6 +28,7 @@
 #include "atom_vec.h"
 #include "fix.h"
 #include "vector_liggghts.h"
+#include "hash_grid.h"
 #include "modify.h"
 
 using namespace LAMMPS_NS;
@@ -87,36 +88,39 @@ int ParticleToInsert::insert()
 
 /* ---------------------------------------------------------------------- */
 
-int ParticleToInsert::check_near_set_x_v_omega(double *x,double *v, double *omega, double *quat, double **xnear, int &nnear)
+int ParticleToInsert::check_near_set_x_v_omega(double *x,double *v, double *omega, double *quat,
+                                               double **xnear, int &nnear, HashGrid *grid)
 {
-    // check sphere against all others in xnear
-    // if no overlap add to xnear
-    double del[3], rsq, radsum;
+    // check each sphere against all others in xnear via grid
+    // if no overlap add to xnear and grid
+    double pos[3];
 
-    vectorCopy3D(x,x_ins[0]);
-
-    for(int i = 0; i < nnear; i++)
+    for(int j = 0; j < nspheres; j++)
     {
-        vectorSubtract3D(x_ins[0],xnear[i],del);
-        rsq = vectorMag3DSquared(del);
-        
-        radsum = radius_ins[0] + xnear[i][3];
+        vectorAdd3D(x_ins[j],x,pos);
 
         // no success in overlap
-        if (rsq <= radsum*radsum) return 0;
+        if(grid->overlap(pos,radius_ins[j],xnear)) return 0;
     }
 
     // no overlap with any other - success
 
+    for(int j = 0; j < nspheres; j++)
+        vectorAdd3D(x_ins[j],x,x_ins[j]);
+
     vectorCopy3D(v,v_ins);
     vectorCopy3D(omega,omega_ins);
 
     // add to xnear
-    vectorCopy3D(x_ins[0],xnear[nnear]);
-    xnear[nnear][3] = radius_ins[0];
-    nnear++;
+    for(int j = 0; j < nspheres; j++)
+    {
+        vectorCopy3D(x_ins[j],xnear[nnear]);
+        xnear[nnear][3] = radius_ins[j];
+        grid->add(xnear,nnear);
+        nnear++;
+    }
 
-    return 1;
+    return nspheres;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -55,7 +55,8 @@ namespace LAMMPS_NS {
         double omega_ins[3];
 
         virtual int insert();
-        virtual int check_near_set_x_v_omega(double *x,double *v, double *omega, double *quat, double **xnear, int &nnear);
+        virtual int check_near_set_x_v_omega(double *x,double *v, double *omega, double *quat,
+                                             double **xnear, int &nnear, class HashGrid *grid);
         virtual int set_x_v_omega(double *,double *,double *,double *);
 
         virtual void scale_pti(double r_scale);
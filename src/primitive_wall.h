@@ -29,6 +29,10 @@
 #define LMP_PRIMITIVE_WALL
 
 #include "container.h"
+#include "vector_liggghts.h"
+#include "neighbor.h"
+#include "domain.h"
+#include "atom.h"
 #include "primitive_wall_definitions.h"
 
 namespace LAMMPS_NS
@@ -54,11 +58,15 @@ namespace LAMMPS_NS
 
         double resolveContact(double *x, double r, double *delta);
         bool resolveNeighlist(double *x, double r, double treshold);
+        bool resolveBoxNeighlist(double *lo, double *hi, double treshold);
 
         int axis();
         double calcRadialDistance(double *pos, double *distvec);
 
       private:
+        void buildNeighListBinned(double treshold, double **x, double *r, int nPart);
+        void cleanContactHistory();
+
         ScalarContainer<int> neighlist;
         ScalarContainer<int> contactHashmap;
         VectorContainer<double,3> history;
@@ -106,6 +114,11 @@ namespace LAMMPS_NS
     return PRIMITIVE_WALL_DEFINITIONS::chooseNeighlistTemplate(x,r,treshold,param,wType);
   }
 
+  bool PrimitiveWall::resolveBoxNeighlist(double *lo, double *hi, double treshold)
+  {
+    return PRIMITIVE_WALL_DEFINITIONS::chooseBoxNeighlistTemplate(lo,hi,treshold,param,wType);
+  }
+
   int PrimitiveWall::getNeighbors(int *&contactPtr)
   {
     contactPtr = neighlist.begin();
@@ -152,12 +165,126 @@ namespace LAMMPS_NS
   void PrimitiveWall::buildNeighList(double treshold, double **x, double *r, int nPart)
   {
     neighlist.empty();
-    for(int iPart=0;iPart<nPart;iPart++)
+
+    // use the neighbor bins if all local particles have been binned
+
+    if(neighbor->style == 1 && !domain->triclinic && !neighbor->includegroup && nPart == atom->nlocal)
+      buildNeighListBinned(treshold,x,r,nPart);
+    else
+    {
+      for(int iPart=0;iPart<nPart;iPart++)
+      {
+        
+        if(resolveNeighlist(x[iPart],r?r[iPart]:0.,treshold))
+          neighlist.add(iPart);
+      }
+    }
+
+    if(contactHashmap.size() > 0) cleanContactHistory();
+  }
+
+  /*
+   * particles that are not in the neighbor list can not touch the wall
+   * before the next build, so drop their contact history
+   * history of the remaining particles is stored contiguously again
+   */
+
+  void PrimitiveWall::cleanContactHistory()
+  {
+    int nHash = contactHashmap.size();
+    int nNeigh = neighlist.size();
+    VectorContainer<double,3> historyKept;
+
+    for(int iNeigh = 0; iNeigh < nNeigh; iNeigh++)
     {
-      
-      if(resolveNeighlist(x[iPart],r?r[iPart]:0.,treshold))
-        neighlist.add(iPart);
+      int iPart = neighlist(iNeigh);
+      if(iPart >= nHash) continue;
+      int index = contactHashmap(iPart);
+      if(index == -1) continue;
+      historyKept.add(history(index));
+      // temporarily mark the new index
+      contactHashmap(iPart) = -2-(historyKept.size()-1);
     }
+
+    for(int iPart = 0; iPart < nHash; iPart++)
+    {
+      int index = contactHashmap(iPart);
+      contactHashmap(iPart) = index < -1 ? -2-index : -1;
+    }
+
+    history.empty();
+    for(int i = 0; i < historyKept.size(); i++)
+      history.add(historyKept(i));
+  }
+
+  /*
+   * neighbor list build using the bins of the last neighbor list build
+   * skip the wall if it does not reach the subdomain, and skip all bins
+   * that are farther away from the wall than the largest particle radius
+   * plus treshold
+   */
+
+  void PrimitiveWall::buildNeighListBinned(double treshold, double **x, double *r, int nPart)
+  {
+    // radii may change during a run, so do not rely on the pair cutoff
+
+    double rmax = 0.;
+    if(r)
+      for(int iPart = 0; iPart < nPart; iPart++)
+        if(r[iPart] > rmax) rmax = r[iPart];
+
+    double cut = treshold + rmax;
+    double lo[3],hi[3];
+
+    // whole subdomain
+
+    vectorCopy3D(domain->sublo,lo);
+    vectorCopy3D(domain->subhi,hi);
+    for(int dim = 0; dim < 3; dim++)
+    {
+      lo[dim] -= neighbor->skin;
+      hi[dim] += neighbor->skin;
+    }
+    if(!resolveBoxNeighlist(lo,hi,cut)) return;
+
+    int mbinx = neighbor->mbinx, mbiny = neighbor->mbiny, mbinz = neighbor->mbinz;
+    int *binhead = neighbor->binhead;
+    int *bins = neighbor->bins;
+    double binsize[3] = {neighbor->binsizex,neighbor->binsizey,neighbor->binsizez};
+    int mbinlo[3] = {neighbor->mbinxlo,neighbor->mbinylo,neighbor->mbinzlo};
+    double *bboxlo = neighbor->bboxlo;
+
+    // bins are extended a bit to be safe against round-off in coord2bin()
+
+    double eps[3];
+    for(int dim = 0; dim < 3; dim++)
+      eps[dim] = 1e-6*binsize[dim];
+
+    int ibin[3];
+    for(ibin[2] = 0; ibin[2] < mbinz; ibin[2]++)
+      for(ibin[1] = 0; ibin[1] < mbiny; ibin[1]++)
+        for(ibin[0] = 0; ibin[0] < mbinx; ibin[0]++)
+        {
+          int iBin = (ibin[2]*mbiny + ibin[1])*mbinx + ibin[0];
+
+          // bins in forward order, so owned particles come first
+          int iPart = binhead[iBin];
+          if(iPart == -1 || iPart >= nPart) continue;
+
+          for(int dim = 0; dim < 3; dim++)
+          {
+            lo[dim] = bboxlo[dim] + (ibin[dim]+mbinlo[dim])*binsize[dim] - eps[dim];
+            hi[dim] = lo[dim] + binsize[dim] + 2.*eps[dim];
+          }
+          if(!resolveBoxNeighlist(lo,hi,cut)) continue;
+
+          while(iPart != -1 && iPart < nPart)
+          {
+            if(resolveNeighlist(x[iPart],r?r[iPart]:0.,treshold))
+              neighlist.add(iPart);
+            iPart = bins[iPart];
+          }
+        }
   }
 } /* namespace LAMMPS_NS */
 #endif /* PRIMITIVEWALL_H_ */
@@ -33,8 +33,9 @@
  * (2) add a string that you want to use in your input script to wallString and
  *     the number of arguments the wall requires to numArgs
  * (3) implement distance and neighbor list build functions
- * (4) add them to the switch statements in chooseContactTemplate() and
- *     chooseNeighlistTemplate() located at the bottom of this file
+ * (4) add them to the switch statements in chooseContactTemplate(),
+ *     chooseNeighlistTemplate() and chooseBoxNeighlistTemplate() located at
+ *     the bottom of this file
  */
 
 namespace LAMMPS_NS
@@ -94,6 +95,7 @@ namespace LAMMPS_NS
      */
     double chooseContactTemplate(double *x, double r, double *delta, double *param, WallType wType);
     bool chooseNeighlistTemplate(double *x, double r, double treshold, double *param, WallType wType);
+    bool chooseBoxNeighlistTemplate(double *lo, double *hi, double treshold, double *param, WallType wType);
 
 /* ---------------------------------------------------------------------- */
 
@@ -125,7 +127,12 @@ namespace LAMMPS_NS
       {
         double dMax = r + treshold;
         double dist = pos[d::x] - *param;
-        return (dMax < dist || -dMax < dist);
+        return (dist < dMax && -dMax < dist);
+      }
+      // true if a box [lo,hi] may contain points closer than treshold to the wall
+      static bool resolveBoxNeighlist(double *lo, double *hi, double treshold, double *param)
+      {
+        return (lo[d::x] - treshold < *param && *param < hi[d::x] + treshold);
       }
     };
 
@@ -170,7 +177,27 @@ namespace LAMMPS_NS
         double dy,dz;
         double dMax = r + treshold;
         double dist = calcRadialDistance(pos,param,dy,dz) - *param;
-        return (dMax < dist || -dMax < dist);
+        return (dist < dMax && -dMax < dist);
+      }
+      // true if a box [lo,hi] may contain points closer than treshold to the wall
+      // i.e. the shell between radius-treshold and radius+treshold
+      // intersects the cross section of the box
+      static bool resolveBoxNeighlist(double *lo, double *hi, double treshold, double *param)
+      {
+        double dyLo = lo[d::y]-param[1], dyHi = hi[d::y]-param[1];
+        double dzLo = lo[d::z]-param[2], dzHi = hi[d::z]-param[2];
+
+        // nearest and farthest point of the cross section
+        double dyMin = dyLo > 0. ? dyLo : (dyHi < 0. ? -dyHi : 0.);
+        double dzMin = dzLo > 0. ? dzLo : (dzHi < 0. ? -dzHi : 0.);
+        double dyMax = fabs(dyLo) > fabs(dyHi) ? fabs(dyLo) : fabs(dyHi);
+        double dzMax = fabs(dzLo) > fabs(dzHi) ? fabs(dzLo) : fabs(dzHi);
+
+        double rOut = *param + treshold;
+        double rIn = *param - treshold;
+        if(dyMin*dyMin + dzMin*dzMin > rOut*rOut) return false;
+        if(rIn > 0. && dyMax*dyMax + dzMax*dzMax < rIn*rIn) return false;
+        return true;
       }
 
     };
@@ -227,6 +254,28 @@ namespace LAMMPS_NS
       }
     }
 
+    bool chooseBoxNeighlistTemplate(double *lo, double *hi, double treshold, double *param, WallType wType)
+    {
+      //TODO: create switch statement automatically
+      switch(wType){
+      case XPLANE:
+        return Plane<0>::resolveBoxNeighlist(lo,hi,treshold,param);
+      case YPLANE:
+        return Plane<1>::resolveBoxNeighlist(lo,hi,treshold,param);
+      case ZPLANE:
+        return Plane<2>::resolveBoxNeighlist(lo,hi,treshold,param);
+      case XCYLINDER:
+        return Cylinder<0>::resolveBoxNeighlist(lo,hi,treshold,param);
+      case YCYLINDER:
+        return Cylinder<1>::resolveBoxNeighlist(lo,hi,treshold,param);
+      case ZCYLINDER:
+        return Cylinder<2>::resolveBoxNeighlist(lo,hi,treshold,param);
+
+      default: // default value: every box may contain neighbors
+        return true;
+      }
+    }
+
     int chooseAxis(WallType wType)
     {
       //TODO: create switch statement automatically
@@ -55,7 +55,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
        BOXLO_0,BOXHI_0,BOXLO_1,BOXHI_1,BOXLO_2,BOXHI_2,
        SPECIAL_LJ_1,SPECIAL_LJ_2,SPECIAL_LJ_3,
        SPECIAL_COUL_1,SPECIAL_COUL_2,SPECIAL_COUL_3,
-       XY,XZ,YZ};
+       XY,XZ,YZ,MULTIPROC};
 enum{MASS};
 enum{PAIR,BOND,ANGLE,DIHEDRAL,IMPROPER};
 
@@ -210,43 +210,117 @@ void ReadRestart::command(int narg, char **arg)
 
     if (me == 0) fclose(fp);
 
-  // one file per proc:
-  // nprocs_file = # of files
-  // each proc reads 1/P fraction of files, keeping all atoms in the files
+  // one file per proc or per cluster of procs:
+  // files from older versions hold one chunk each, nprocs_file = # of files
+  // else multiproc_file = # of files, each file starts with its # of chunks
+  // if P <= # of files, each proc reads 1/P fraction of files
+  // else procs form one cluster per file, first proc of a cluster reads
+  //   the file and hands its chunks round-robin to the cluster's procs
+  // each proc keeps all atoms it received, there is no global bcast
   // perform irregular comm to migrate atoms to correct procs
   // close restart file when done
 
   } else {
     if (me == 0) fclose(fp);
-    char *perproc = new char[strlen(file) + 16];
-    char *ptr = strchr(file,'%');
 
-    for (int iproc = me; iproc < nprocs_file; iproc += nprocs) {
-      *ptr = '\0';
-      sprintf(perproc,"%s%d%s",file,iproc,ptr+1);
-      *ptr = '%';
-      fp = fopen(perproc,"rb");
-      if (fp == NULL) {
-        char str[128];
-        sprintf(str,"Cannot open restart file %s",perproc);
-        error->one(FLERR,str);
+    if (multiproc_file == 0) {
+      for (int ifile = me; ifile < nprocs_file; ifile += nprocs) {
+        open_perproc(file,ifile);
+
+        nread_int(&n,1,fp);
+        if (n > maxbuf) {
+          maxbuf = n;
+          memory->destroy(buf);
+          memory->create(buf,maxbuf,"read_restart:buf");
+        }
+        if (n > 0) nread_double(buf,n,fp);
+
+        m = 0;
+        while (m < n) m += avec->unpack_restart(&buf[m]);
+        fclose(fp);
       }
 
-      nread_int(&n,1,fp);
-      if (n > maxbuf) {
-        maxbuf = n;
-        memory->destroy(buf);
-        memory->create(buf,maxbuf,"read_restart:buf");
+    } else if (nprocs <= multiproc_file) {
+      int nchunk;
+      for (int ifile = me; ifile < multiproc_file; ifile += nprocs) {
+        open_perproc(file,ifile);
+
+        nread_int(&nchunk,1,fp);
+        for (int ichunk = 0; ichunk < nchunk; ichunk++) {
+          nread_int(&n,1,fp);
+          if (n > maxbuf) {
+            maxbuf = n;
+            memory->destroy(buf);
+            memory->create(buf,maxbuf,"read_restart:buf");
+          }
+          if (n > 0) nread_double(buf,n,fp);
+
+          m = 0;
+          while (m < n) m += avec->unpack_restart(&buf[m]);
+        }
+        fclose(fp);
       }
-      if (n > 0) nread_double(buf,n,fp);
 
-      m = 0;
-      while (m < n) m += avec->unpack_restart(&buf[m]);
-      fclose(fp);
+    } else {
+      int nfile = multiproc_file;
+      int icluster = static_cast<int> ((bigint) me * nfile/nprocs);
+      int fileproc = static_cast<int> ((bigint) icluster * nprocs/nfile);
+      while ((bigint) fileproc*nfile/nprocs < icluster) fileproc++;
+      int fileprocnext = static_cast<int> ((bigint) (icluster+1) * nprocs/nfile);
+      while ((bigint) fileprocnext*nfile/nprocs < icluster+1) fileprocnext++;
+      int nclusterprocs = fileprocnext - fileproc;
+
+      int nchunk,iproc;
+      MPI_Status status;
+
+      if (me == fileproc) {
+        open_perproc(file,icluster);
+
+        nread_int(&nchunk,1,fp);
+        for (iproc = 1; iproc < nclusterprocs; iproc++)
+          MPI_Send(&nchunk,1,MPI_INT,fileproc+iproc,0,world);
+
+        for (int ichunk = 0; ichunk < nchunk; ichunk++) {
+          nread_int(&n,1,fp);
+          if (n > maxbuf) {
+            maxbuf = n;
+            memory->destroy(buf);
+            memory->create(buf,maxbuf,"read_restart:buf");
+          }
+          if (n > 0) nread_double(buf,n,fp);
+
+          iproc = ichunk % nclusterprocs;
+          if (iproc) {
+            MPI_Send(&n,1,MPI_INT,fileproc+iproc,0,world);
+            if (n > 0) MPI_Send(buf,n,MPI_DOUBLE,fileproc+iproc,0,world);
+          } else {
+            m = 0;
+            while (m < n) m += avec->unpack_restart(&buf[m]);
+          }
+        }
+        fclose(fp);
+
+      } else {
+        MPI_Recv(&nchunk,1,MPI_INT,fileproc,0,world,&status);
+        iproc = me - fileproc;
+        int nmine = nchunk/nclusterprocs;
+        if (iproc < nchunk % nclusterprocs) nmine++;
+
+        for (int ichunk = 0; ichunk < nmine; ichunk++) {
+          MPI_Recv(&n,1,MPI_INT,fileproc,0,world,&status);
+          if (n > maxbuf) {
+            maxbuf = n;
+            memory->destroy(buf);
+            memory->create(buf,maxbuf,"read_restart:buf");
+          }
+          if (n > 0) MPI_Recv(buf,n,MPI_DOUBLE,fileproc,0,world,&status);
+
+          m = 0;
+          while (m < n) m += avec->unpack_restart(&buf[m]);
+        }
+      }
     }
 
-    delete [] perproc;
-
     // create a temporary fix to hold and migrate extra atom info
     // necessary b/c irregular will migrate atoms
 
@@ -358,6 +432,27 @@ void ReadRestart::command(int narg, char **arg)
   }
 }
 
+/* ----------------------------------------------------------------------
+   open per-proc file ifile of a multiproc restart as fp
+   file = file name containing a "%"
+------------------------------------------------------------------------- */
+
+void ReadRestart::open_perproc(char *file, int ifile)
+{
+  char *perproc = new char[strlen(file) + 16];
+  char *ptr = strchr(file,'%');
+  *ptr = '\0';
+  sprintf(perproc,"%s%d%s",file,ifile,ptr+1);
+  *ptr = '%';
+  fp = fopen(perproc,"rb");
+  if (fp == NULL) {
+    char str[128];
+    sprintf(str,"Cannot open restart file %s",perproc);
+    error->one(FLERR,str);
+  }
+  delete [] perproc;
+}
+
 /* ----------------------------------------------------------------------
    infile contains a "*"
    search for all files which match the infile pattern
@@ -457,6 +552,8 @@ void ReadRestart::header()
   int xperiodic,yperiodic,zperiodic;
   int boundary[3][2];
 
+  multiproc_file = 0;
+
   // read flags and values until flag = -1
 
   int flag = read_int();
@@ -516,6 +613,11 @@ void ReadRestart::header()
       if (nprocs_file != comm->nprocs && me == 0)
         error->warning(FLERR,"Restart file used different # of processors");
 
+      // # of per-proc files, unset for files of older versions
+
+    } else if (flag == MULTIPROC) {
+      multiproc_file = read_int();
+
       // don't set procgrid, warn if different
 
     } else if (flag == PROCGRID_0) {
@@ -32,11 +32,13 @@ class ReadRestart : protected Pointers {
 
  private:
   int me,nprocs,nprocs_file;
+  int multiproc_file;        // # of per-proc files, 0 for older versions
   FILE *fp;
   int nfix_restart_global,nfix_restart_peratom;
   int swapflag;
 
   void file_search(char *, char *);
+  void open_perproc(char *, int);
   void header();
   void type_arrays();
   void force_fields();
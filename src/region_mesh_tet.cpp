@@ -35,6 +35,7 @@
 
 #define DELTA_TET 1000
 #define BIG 1.e20
+#define MAXBIN_DIM 1000
 
 using namespace LAMMPS_NS;
 
@@ -73,6 +74,10 @@ RegTetMesh::RegTetMesh(LAMMPS *lmp, int narg, char **arg) :
   nTetMax = 0;
   total_volume = 0.;
 
+  binsBuilt = false;
+  nBinX = nBinY = nBinZ = 0;
+  tetBinStart = tetBinList = NULL;
+
   // manage input
   InputMeshTet *my_input = new InputMeshTet(lmp, 0, NULL);
   my_input->meshtetfile(filename,this,true);
@@ -85,6 +90,8 @@ RegTetMesh::RegTetMesh(LAMMPS *lmp, int narg, char **arg) :
     set_extent();
   } else bboxflag = 0;
 
+  build_bins();
+
   cmax = 1;
   contact = new Contact[cmax];
 }
@@ -98,6 +105,8 @@ RegTetMesh::~RegTetMesh()
   memory->destroy(node);
   memory->sfree(volume);
   memory->sfree(acc_volume);
+  memory->destroy(tetBinStart);
+  memory->destroy(tetBinList);
 }
 
 /* ----------------------------------------------------------------------
@@ -121,17 +130,155 @@ int RegTetMesh::inside(double x, double y, double z)
        if(pos[2] < extent_zlo || pos[2] > extent_zhi) return 0;
    }
 
-   // brute force naive search
-   int inside_mesh = 0;
-   for(int i = 0; i < nTet; i++)
+   if(!binsBuilt) build_bins();
+
+   // only test tets overlapping the bin of pos
+   int iBin = coord2bin(pos);
+   if(iBin < 0) return 0;
+
+   for(int i = tetBinStart[iBin]; i < tetBinStart[iBin+1]; i++)
    {
-        inside_mesh = inside_mesh + is_inside_tet(i,pos);
-        if(inside_mesh) break;
+        if(is_inside_tet(tetBinList[i],pos))
+            return 1;
    }
 
-   //fprintf(screen,"checking pos %f %f %f, result %d; ntet %d\n",x,y,z,inside_mesh,nTet);
+   return 0;
+}
+
+/* ----------------------------------------------------------------------
+   sort tets into a uniform bin grid over their bounding box
+   a tet is added to every bin its bounding box overlaps
+   bin size is chosen so that there is about one bin per tet
+------------------------------------------------------------------------- */
+
+void RegTetMesh::build_bins()
+{
+    double lo[3],hi[3];
+
+    memory->destroy(tetBinStart);
+    memory->destroy(tetBinList);
+    binsBuilt = true;
+
+    if(nTet == 0)
+    {
+        nBinX = nBinY = nBinZ = 0;
+        return;
+    }
+
+    vectorCopy3D(node[0][0],lo);
+    vectorCopy3D(node[0][0],hi);
+    for(int i = 0; i < nTet; i++)
+        for(int j = 0; j < 4; j++)
+            for(int k = 0; k < 3; k++)
+            {
+                if(node[i][j][k] < lo[k]) lo[k] = node[i][j][k];
+                if(node[i][j][k] > hi[k]) hi[k] = node[i][j][k];
+            }
+
+    double len[3],lenmax = 0.;
+    for(int k = 0; k < 3; k++)
+    {
+        len[k] = hi[k] - lo[k];
+        if(len[k] > lenmax) lenmax = len[k];
+    }
+
+    // bin size from bbox volume, do not let flat dimensions collapse the bins
+
+    double lenmin = 1e-3*lenmax;
+    double binvol = 1.;
+    for(int k = 0; k < 3; k++)
+        binvol *= (len[k] > lenmin ? len[k] : lenmin);
+    double binsize = pow(binvol/static_cast<double>(nTet),1./3.);
+
+    int nbin[3];
+    for(int k = 0; k < 3; k++)
+    {
+        nbin[k] = static_cast<int>(len[k]/binsize) + 1;
+        if(nbin[k] > MAXBIN_DIM) nbin[k] = MAXBIN_DIM;
+        binLo[k] = lo[k];
+        binHi[k] = hi[k];
+        binInv[k] = static_cast<double>(nbin[k]) / (len[k] > 0. ? len[k] : 1.);
+    }
+    nBinX = nbin[0];
+    nBinY = nbin[1];
+    nBinZ = nbin[2];
+    int nBins = nBinX*nBinY*nBinZ;
+
+    // count, then fill
+
+    memory->create(tetBinStart,nBins+1,"region/mesh/tet:tetBinStart");
+    for(int i = 0; i <= nBins; i++)
+        tetBinStart[i] = 0;
 
-   return inside_mesh;
+    for(int pass = 0; pass < 2; pass++)
+    {
+        for(int iTet = 0; iTet < nTet; iTet++)
+        {
+            double tlo[3],thi[3];
+            vectorCopy3D(node[iTet][0],tlo);
+            vectorCopy3D(node[iTet][0],thi);
+            for(int j = 1; j < 4; j++)
+                for(int k = 0; k < 3; k++)
+                {
+                    if(node[iTet][j][k] < tlo[k]) tlo[k] = node[iTet][j][k];
+                    if(node[iTet][j][k] > thi[k]) thi[k] = node[iTet][j][k];
+                }
+
+            int ilo[3],ihi[3];
+            for(int k = 0; k < 3; k++)
+            {
+                ilo[k] = static_cast<int>((tlo[k]-binLo[k])*binInv[k]);
+                ihi[k] = static_cast<int>((thi[k]-binLo[k])*binInv[k]);
+                if(ilo[k] < 0) ilo[k] = 0;
+                if(ihi[k] > nbin[k]-1) ihi[k] = nbin[k]-1;
+            }
+
+            for(int iz = ilo[2]; iz <= ihi[2]; iz++)
+                for(int iy = ilo[1]; iy <= ihi[1]; iy++)
+                    for(int ix = ilo[0]; ix <= ihi[0]; ix++)
+                    {
+                        int iBin = (iz*nBinY + iy)*nBinX + ix;
+                        if(pass == 0) tetBinStart[iBin+1]++;
+                        else tetBinList[tetBinStart[iBin]++] = iTet;
+                    }
+        }
+
+        // after counting: prefix sum
+        // after filling: tetBinStart[i] points to the end of bin i, shift back
+
+        if(pass == 0)
+        {
+            for(int i = 0; i < nBins; i++)
+                tetBinStart[i+1] += tetBinStart[i];
+            memory->create(tetBinList,tetBinStart[nBins] > 0 ? tetBinStart[nBins] : 1,"region/mesh/tet:tetBinList");
+        }
+        else
+        {
+            for(int i = nBins; i > 0; i--)
+                tetBinStart[i] = tetBinStart[i-1];
+            tetBinStart[0] = 0;
+        }
+    }
+}
+
+/* ----------------------------------------------------------------------
+   bin of pos, -1 if outside the bin grid
+------------------------------------------------------------------------- */
+
+inline int RegTetMesh::coord2bin(double *pos)
+{
+    if(nTet == 0) return -1;
+
+    int ibin[3];
+    int nbin[3] = {nBinX,nBinY,nBinZ};
+    for(int k = 0; k < 3; k++)
+    {
+        if(pos[k] < binLo[k] || pos[k] > binHi[k]) return -1;
+        ibin[k] = static_cast<int>((pos[k]-binLo[k])*binInv[k]);
+        if(ibin[k] > nbin[k]-1) ibin[k] = nbin[k]-1;
+    }
+
+    return (ibin[2]*nBinY + ibin[1])*nBinX + ibin[0];
 }
 
 /* ---------------------------------------------------------------------- */
@@ -189,6 +336,8 @@ void RegTetMesh::add_tet(double **n)
     vol = volume_of_tet(nTet);
     if(vol < 0.) error->all(FLERR,"Fatal error: RegTetMesh::add_tet: vol < 0");
 
+    binsBuilt = false;
+
     volume[nTet] = vol;
     total_volume += volume[nTet];
     acc_volume[nTet] = volume[nTet];
@@ -369,9 +518,16 @@ inline int RegTetMesh::tet_rand_tri()
 {
 
     double rd = total_volume * random->uniform();
-    int chosen = 0;
-    while (rd > acc_volume[chosen] && chosen < nTet-1) chosen++;
-    return chosen;
+
+    // binary search for first tet with acc_volume >= rd
+    int lo = 0, hi = nTet-1;
+    while(lo < hi)
+    {
+        int mid = (lo+hi)/2;
+        if(rd > acc_volume[mid]) lo = mid+1;
+        else hi = mid;
+    }
+    return lo;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -70,6 +70,9 @@ class RegTetMesh : public Region {
    void tet_randpos(int iTet,double *pos);
    void bary_to_cart(int iTet,double *bary_coo,double *pos);
 
+   void build_bins();
+   int coord2bin(double *pos);
+
    char *filename;
    double scale_fact;
    double off_fact[3], rot_angle[3];
@@ -79,6 +82,13 @@ class RegTetMesh : public Region {
    double total_volume;
    double *volume;
    double *acc_volume;
+
+   // uniform bin grid over the tets for inside()
+   // tets of bin i are tetBinList[tetBinStart[i]] ... tetBinList[tetBinStart[i+1]-1]
+   bool binsBuilt;
+   int nBinX,nBinY,nBinZ;
+   double binLo[3],binHi[3],binInv[3];
+   int *tetBinStart,*tetBinList;
 };
 
 }
@@ -36,6 +36,11 @@ namespace SPH_KERNEL_NS {
   inline double sph_kernel(int id,double s,double h,double hinv);
   inline double sph_kernel_der(int id,double s,double h,double hinv);
   inline double sph_kernel_cut(int id);
+
+  // compile-time selection of the kernel, used by the pair and fix loops
+  template <int KERNEL> inline double sph_kernel(double s,double h,double hinv);
+  template <int KERNEL> inline double sph_kernel_der(double s,double h,double hinv);
+  template <int KERNEL> inline double sph_kernel_cut();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -117,4 +122,21 @@ inline double SPH_KERNEL_NS::sph_kernel_cut(int id)
   return 0.;
 }
 
+/* ----------------------------------------------------------------------
+   one specialization per kernel id, so the kernel can be inlined
+   into loops instantiated for a given kernel
+------------------------------------------------------------------------- */
+
+#define SPH_KERNEL_CLASS
+#define SPHKernel(kernel_id,kernelstyle,SPHKernelCalculation,SPHKernelCalculationDer,SPHKernelCalculationCut) \
+template <> inline double SPH_KERNEL_NS::sph_kernel<kernel_id>(double s,double h,double hinv) \
+{ return SPH_KERNEL_NS::SPHKernelCalculation(s,h,hinv); } \
+template <> inline double SPH_KERNEL_NS::sph_kernel_der<kernel_id>(double s,double h,double hinv) \
+{ return SPH_KERNEL_NS::SPHKernelCalculationDer(s,h,hinv); } \
+template <> inline double SPH_KERNEL_NS::sph_kernel_cut<kernel_id>() \
+{ return SPH_KERNEL_NS::SPHKernelCalculationCut(); }
+#include "style_sph_kernel.h"
+#undef SPH_KERNEL_CLASS
+#undef SPHKernel
+
 #endif
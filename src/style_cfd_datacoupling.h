@@ -1,2 +1,3 @@
 #include "cfd_datacoupling_file.h"
 #include "cfd_datacoupling_mpi.h"
+#include "cfd_datacoupling_mpi_sparse.h"
@@ -1,3 +1,4 @@
+#include "balance.h"
 #include "change_box.h"
 #include "create_atoms.h"
 #include "create_box.h"
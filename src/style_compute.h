@@ -11,6 +11,7 @@
 #include "compute_dihedral_local.h"
 #include "compute_displace_atom.h"
 #include "compute_erotate_sphere.h"
+#include "compute_fix_timing.h"
 #include "compute_group_group.h"
 #include "compute_gyration.h"
 #include "compute_gyration_molecule.h"
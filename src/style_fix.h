@@ -7,6 +7,7 @@
 #include "fix_ave_spatial.h"
 #include "fix_ave_time.h"
 #include "fix_aveforce.h"
+#include "fix_balance.h"
 #include "fix_box_relax.h"
 #include "fix_cfd_coupling.h"
 #include "fix_cfd_coupling_convection.h"
@@ -14,6 +15,7 @@
 #include "fix_check_timestep_gran.h"
 #include "fix_check_timestep_sph.h"
 #include "fix_contact_history.h"
+#include "fix_contact_history_mesh.h"
 #include "fix_deform.h"
 #include "fix_deposit.h"
 #include "fix_drag.h"
@@ -47,6 +47,38 @@ using namespace LAMMPS_MEMORY_NS;
 
 namespace LAMMPS_NS{
 
+// geometry of one element, packed so that a contact test
+// does not need to touch several containers
+
+template<int NUM_NODES>
+struct SurfaceElemGeomData
+{
+    double node[NUM_NODES][3];
+    double edgeVec[NUM_NODES][3];
+    double edgeNorm[NUM_NODES][3];
+    double edgeLen[NUM_NODES];
+    double surfaceNorm[3];
+    double center[3];
+    int obtuseAngleIndex;
+    bool edgeActive[NUM_NODES];
+    bool cornerActive[NUM_NODES];
+};
+
+// padded to a multiple of the cache line size (64 bytes), records are
+// cache line aligned if compiled with -DLAMMPS_MEMALIGN=64
+// no padding if the size is a multiple of 64 already
+
+template<int NUM_NODES, bool PAD = (sizeof(SurfaceElemGeomData<NUM_NODES>)%64 != 0)>
+struct SurfaceElemGeom : public SurfaceElemGeomData<NUM_NODES>
+{
+    char pad[64 - sizeof(SurfaceElemGeomData<NUM_NODES>)%64];
+};
+
+template<int NUM_NODES>
+struct SurfaceElemGeom<NUM_NODES,false> : public SurfaceElemGeomData<NUM_NODES>
+{
+};
+
 template<int NUM_NODES, int NUM_NEIGH_MAX>
 class SurfaceMesh : public TrackingMesh<NUM_NODES>
 {
@@ -68,6 +100,25 @@ class SurfaceMesh : public TrackingMesh<NUM_NODES>
         void move(double *vecIncremental);
         void scale(double factor);
 
+        void updateRigidFrame();
+
+        // packed per-element geometry, used by contact and neighbor list build
+        // the containers remain the reference for communication and restart,
+        // records are refreshed whenever the geometry of the elements changes
+        void setPackedGeometry(bool flag);
+
+        inline bool isPackedGeometry()
+        { return packedGeom_; }
+
+        // returns packed record of element i, or gathers it into tmp
+        // if packed geometry is not used
+        inline SurfaceElemGeom<NUM_NODES>& elemGeom(int i,SurfaceElemGeom<NUM_NODES> &tmp)
+        {
+            if(packedGeom_) return elemGeom_[i];
+            packElemGeom(i,tmp);
+            return tmp;
+        }
+
         virtual int generateRandomOwnedGhost(double *pos) = 0;
         virtual int generateRandomOwnedGhostWithin(double *pos,double delta) = 0;
         virtual int generateRandomSubbox(double *pos) = 0;
@@ -101,7 +152,7 @@ class SurfaceMesh : public TrackingMesh<NUM_NODES>
         { vectorCopy3D(edgeVec_(i)[j],ev); }
 
         inline void surfaceNorm(int i,double *sn)
-        { vectorCopy3D(surfaceNorm(i),sn); }
+        { vectorCopy3D(packedGeom_ ? elemGeom_[i].surfaceNorm : surfaceNorm(i),sn); }
 
         inline double areaElem(int i)
         { return (area_)(i); }
@@ -127,6 +178,7 @@ class SurfaceMesh : public TrackingMesh<NUM_NODES>
 
         void buildNeighbours();
         void parallelCorrection();
+        void postInitialSetup();
 
         // returns true if surfaces share an edge
         // called with local index
@@ -166,6 +218,10 @@ class SurfaceMesh : public TrackingMesh<NUM_NODES>
         void rotate(double *totalQ, double *dQ,double *origin);
         void rotate(double *dQ,double *origin);
 
+        // (re) pack geometry of elements ilo <= i < ihi
+        void packElemGeom(int i, SurfaceElemGeom<NUM_NODES> &g);
+        void refreshPackedGeometry(int ilo, int ihi);
+
         // inline access
         inline double&  area(int i)         {return (area_)(i);}
         inline double&  areaAcc(int i)      {return (areaAcc_)(i);}
@@ -218,6 +274,12 @@ class SurfaceMesh : public TrackingMesh<NUM_NODES>
         VectorContainer<bool,NUM_NODES>& hasNonCoplanarSharedNode_;
         VectorContainer<bool,NUM_NODES>& edgeActive_;
         VectorContainer<bool,NUM_NODES>& cornerActive_;
+
+        // packed geometry of owned and ghost elements
+        // allocated via smalloc so that LAMMPS_MEMALIGN applies
+        bool packedGeom_;
+        int nElemGeom_;
+        SurfaceElemGeom<NUM_NODES> *elemGeom_;
 };
 
 // *************************************
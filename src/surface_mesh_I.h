@@ -60,7 +60,11 @@ SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::SurfaceMesh(LAMMPS *lmp)
     hasNonCoplanarSharedNode_(*this->prop().template addElementProperty< VectorContainer<bool,NUM_NODES> >("hasNonCoplanarSharedNode","comm_exchange_borders","frame_invariant", "restart_no")),
     nNeighs_      (*this->prop().template addElementProperty< ScalarContainer<int> >                      ("nNeighs",      "comm_exchange_borders","frame_invariant","restart_no")),
     neighFaces_   (*this->prop().template addElementProperty< VectorContainer<int,NUM_NEIGH_MAX> >        ("neighFaces",   "comm_exchange_borders","frame_invariant","restart_no")),
-    obtuseAngleIndex_   (*this->prop().template addElementProperty< ScalarContainer<int> >                ("obtuseAngleIndex","comm_exchange_borders","frame_invariant","restart_no"))
+    obtuseAngleIndex_   (*this->prop().template addElementProperty< ScalarContainer<int> >                ("obtuseAngleIndex","comm_exchange_borders","frame_invariant","restart_no")),
+
+    packedGeom_(true),
+    nElemGeom_(0),
+    elemGeom_(0)
 {
     
     areaMesh_.add(0.);
@@ -71,7 +75,9 @@ SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::SurfaceMesh(LAMMPS *lmp)
 
 template<int NUM_NODES, int NUM_NEIGH_MAX>
 SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::~SurfaceMesh()
-{}
+{
+    this->memory->sfree(elemGeom_);
+}
 
 /* ----------------------------------------------------------------------
    set mesh curvature, used for mesh topology
@@ -167,6 +173,7 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::recalcLocalSurfProperties()
     // mesh area must be summed up
     MPI_Sum_Scalar(areaMesh_(1),areaMesh_(0),this->world);
 
+    refreshPackedGeometry(0,nlocal);
 }
 
 /* ----------------------------------------------------------------------
@@ -205,6 +212,80 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::recalcGhostSurfProperties()
       areaMesh_(2) += area(i);
     }
 
+    refreshPackedGeometry(nlocal,nall);
+}
+
+/* ----------------------------------------------------------------------
+   pack geometry of an element into one record
+------------------------------------------------------------------------- */
+
+template<int NUM_NODES, int NUM_NEIGH_MAX>
+void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::packElemGeom(int i, SurfaceElemGeom<NUM_NODES> &g)
+{
+    for(int j = 0; j < NUM_NODES; j++)
+    {
+        vectorCopy3D(this->node_(i)[j],g.node[j]);
+        vectorCopy3D(edgeVec(i)[j],g.edgeVec[j]);
+        vectorCopy3D(edgeNorm(i)[j],g.edgeNorm[j]);
+        g.edgeLen[j] = edgeLen(i)[j];
+        g.edgeActive[j] = edgeActive(i)[j];
+        g.cornerActive[j] = cornerActive(i)[j];
+    }
+    vectorCopy3D(surfaceNorm(i),g.surfaceNorm);
+    vectorCopy3D(this->center_(i),g.center);
+    g.obtuseAngleIndex = obtuseAngleIndex(i);
+}
+
+/* ----------------------------------------------------------------------
+   (re) pack geometry of elements ilo <= i < ihi if packed geometry is used
+   called after properties of owned/ghost elements have been re-calculated,
+   after the mesh has been set up and after it has moved
+------------------------------------------------------------------------- */
+
+template<int NUM_NODES, int NUM_NEIGH_MAX>
+void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::refreshPackedGeometry(int ilo, int ihi)
+{
+    if(!packedGeom_) return;
+
+    // grow with slack, keep records below ilo
+    // memory->grow() uses realloc which ignores LAMMPS_MEMALIGN
+
+    if(ihi > nElemGeom_)
+    {
+        int nnew = ihi + GROW;
+        SurfaceElemGeom<NUM_NODES> *g = static_cast<SurfaceElemGeom<NUM_NODES>*>
+            (this->memory->smalloc(nnew*sizeof(SurfaceElemGeom<NUM_NODES>),"SurfaceMesh:elemGeom_"));
+
+        int ncopy = ilo < nElemGeom_ ? ilo : nElemGeom_;
+        for(int i = 0; i < ncopy; i++)
+            g[i] = elemGeom_[i];
+
+        this->memory->sfree(elemGeom_);
+        elemGeom_ = g;
+        nElemGeom_ = nnew;
+    }
+
+    for(int i = ilo; i < ihi; i++)
+        packElemGeom(i,elemGeom_[i]);
+}
+
+/* ----------------------------------------------------------------------
+   switch packed geometry on / off
+------------------------------------------------------------------------- */
+
+template<int NUM_NODES, int NUM_NEIGH_MAX>
+void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::setPackedGeometry(bool flag)
+{
+    packedGeom_ = flag;
+
+    if(packedGeom_)
+        refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
+    else
+    {
+        this->memory->sfree(elemGeom_);
+        elemGeom_ = 0;
+        nElemGeom_ = 0;
+    }
 }
 
 /* ----------------------------------------------------------------------
@@ -429,6 +510,18 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::buildNeighbours()
     parallelCorrection();
 }
 
+/* ----------------------------------------------------------------------
+   packed geometry includes topology, so re-pack after mesh set-up
+------------------------------------------------------------------------- */
+
+template<int NUM_NODES, int NUM_NEIGH_MAX>
+void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::postInitialSetup()
+{
+    TrackingMesh<NUM_NODES>::postInitialSetup();
+
+    refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
+}
+
 /* ----------------------------------------------------------------------
    quality check for surface mesh
 ------------------------------------------------------------------------- */
@@ -893,12 +986,33 @@ template<int NUM_NODES, int NUM_NEIGH_MAX>
 void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::move(double *vecTotal, double *vecIncremental)
 {
     TrackingMesh<NUM_NODES>::move(vecTotal,vecIncremental);
+
+    // mesh in rigid frame is not moved here, see updateRigidFrame()
+    if(!this->isRigidFrame())
+        refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
 }
 
 template<int NUM_NODES, int NUM_NEIGH_MAX>
 void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::move(double *vecIncremental)
 {
     TrackingMesh<NUM_NODES>::move(vecIncremental);
+
+    refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
+}
+
+/* ----------------------------------------------------------------------
+   bring moving mesh in rigid frame to current pos
+------------------------------------------------------------------------- */
+
+template<int NUM_NODES, int NUM_NEIGH_MAX>
+void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::updateRigidFrame()
+{
+    bool moved = this->isRigidFrame() && !this->rigidFrameCurrent();
+
+    TrackingMesh<NUM_NODES>::updateRigidFrame();
+
+    if(moved)
+        refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
 }
 
 /* ----------------------------------------------------------------------
@@ -910,6 +1024,7 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::scale(double factor)
 {
     TrackingMesh<NUM_NODES>::scale(factor);
 
+    refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
 }
 
 /* ----------------------------------------------------------------------
@@ -923,7 +1038,10 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::rotate(double *totalQ, double *dQ,dou
 
     // find out if rotating every property is cheaper than
     // re-calculating them from the new nodes
-    
+
+    // mesh in rigid frame is not rotated here, see updateRigidFrame()
+    if(!this->isRigidFrame())
+        refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
 }
 
 template<int NUM_NODES, int NUM_NEIGH_MAX>
@@ -933,7 +1051,8 @@ void SurfaceMesh<NUM_NODES,NUM_NEIGH_MAX>::rotate(double *dQ,double *origin)
 
     // find out if rotating every property is cheaper than
     // re-calculating them from the new nodes
-    
+
+    refreshPackedGeometry(0,this->sizeLocal()+this->sizeGhost());
 }
 
 /* ----------------------------------------------------------------------
@@ -330,7 +330,12 @@
   {
     
     MultiNodeMesh<NUM_NODES>::move(vecTotal, vecIncremental);
-    customValues_.move(vecTotal,vecIncremental);
+
+    // element properties follow in updateRigidFrame()
+    if(this->isRigidFrame())
+        customValues_.moveGlobal(vecTotal);
+    else
+        customValues_.move(vecTotal,vecIncremental);
   }
 
   template<int NUM_NODES>
@@ -357,6 +362,15 @@
 
     MultiNodeMesh<NUM_NODES>::rotate(totalQ,dQ,origin);
 
+    // element properties follow in updateRigidFrame()
+    if(this->isRigidFrame())
+    {
+        if(trans) customValues_.moveGlobal(negorigin);
+        customValues_.rotateGlobal(totalQ);
+        if(trans) customValues_.moveGlobal(origin);
+        return;
+    }
+
     if(trans) customValues_.move(negorigin);
     customValues_.rotate(totalQ,dQ);
     if(trans) customValues_.move(origin);
@@ -376,6 +390,38 @@
     if(trans) customValues_.move(origin);
   }
 
+  /* ----------------------------------------------------------------------
+   bring moving mesh in rigid frame to current pos
+   element properties are transformed like the nodes,
+   mesh velocity is evaluated at the nodes
+  ------------------------------------------------------------------------- */
+
+  template<int NUM_NODES>
+  void TrackingMesh<NUM_NODES>::updateRigidFrame()
+  {
+    if(!this->isRigidFrame()) return;
+
+    if(!this->rigidFrameCurrent())
+    {
+        double qRel[4],dRel[3];
+        this->rigidRelative(qRel,dRel);
+
+        MultiNodeMesh<NUM_NODES>::updateRigidFrame();
+
+        customValues_.rotateElements(qRel);
+        customValues_.moveElements(dRel);
+    }
+
+    MultiVectorContainer<double,NUM_NODES,3> *v =
+        customValues_.template getElementProperty<MultiVectorContainer<double,NUM_NODES,3> >("v");
+    if(!v) return;
+
+    int n = this->sizeLocal() + this->sizeGhost();
+    for(int i = 0; i < n; i++)
+        for(int j = 0; j < NUM_NODES; j++)
+            this->rigidVelocity(this->node_(i)[j],(*v)(i)[j]);
+  }
+
   template<int NUM_NODES>
   void TrackingMesh<NUM_NODES>::scale(double factor)
   {
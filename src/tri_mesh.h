@@ -36,6 +36,7 @@ namespace LAMMPS_NS
 {
   
   typedef SurfaceMesh<3,5> SurfaceMeshBase;
+  typedef SurfaceElemGeom<3> TriElemGeom;
 
   class TriMesh : public SurfaceMeshBase
   {
@@ -50,6 +51,16 @@ namespace LAMMPS_NS
 
         bool resolveTriSphereNeighbuild(int nTri, double rSphere, double *cSphere, double treshold);
 
+        // batched tests of one triangle against a block of n spheres,
+        // packed as coordinate arrays px, py, pz and radius array pr
+        // neighbuild: inRange[j] = resolveTriSphereNeighbuild() for sphere j
+        // contact: candidate[j] = 0 if sphere j can not touch the triangle,
+        //   candidates have to be resolved via resolveTriSphereContact()
+        void resolveTriSphereNeighbuildBatch(int nTri, int n, const double *px, const double *py,
+                                             const double *pz, const double *pr, double treshold, int *inRange);
+        void resolveTriSphereContactBatch(int nTri, int n, const double *px, const double *py,
+                                          const double *pz, const double *pr, int *candidate);
+
         int generateRandomOwnedGhost(double *pos);
         int generateRandomSubbox(double *pos);
 
@@ -65,10 +76,10 @@ namespace LAMMPS_NS
         double calcDist(double *cs, double *closestPoint, double *en0);
         double calcDistToPlane(double *p, double *pPlane, double *nPlane);
 
-        double resolveCornerContactBary(int iTri, int iNode, bool obtuse,
+        double resolveCornerContactBary(TriElemGeom &g, int iNode, bool obtuse,
                                     double *p, double *delta, double *bary);
-        double resolveEdgeContactBary(int iTri, int iEdge, double *p, double *delta, double *bary);
-        double resolveFaceContactBary(int iTri, double *p, double *node0ToSphereCenter, double *delta);
+        double resolveEdgeContactBary(TriElemGeom &g, int iEdge, double *p, double *delta, double *bary);
+        double resolveFaceContactBary(TriElemGeom &g, double *p, double *node0ToSphereCenter, double *delta);
 
   };
 
@@ -47,16 +47,16 @@
   inline double TriMesh::resolveTriSphereContactBary(int nTri, double rSphere,
                                    double *cSphere, double *delta, double *bary)
   {
-    double **n = node_(nTri);
-    int obtuseAngleIndex = SurfaceMeshBase::obtuseAngleIndex(nTri);
+    TriElemGeom tmp;
+    TriElemGeom &g = elemGeom(nTri,tmp);
+    int obtuseAngleIndex = g.obtuseAngleIndex;
 
     bary[0] = bary[1] = bary[2] = 0.;
 
     double node0ToSphereCenter[3];
-    double *surfNorm = SurfaceMeshBase::surfaceNorm(nTri);
-    vectorSubtract3D(cSphere,n[0],node0ToSphereCenter);
+    vectorSubtract3D(cSphere,g.node[0],node0ToSphereCenter);
 
-    MathExtraLiggghts::calcBaryTriCoords(node0ToSphereCenter,edgeVec(nTri),edgeLen(nTri),bary);
+    MathExtraLiggghts::calcBaryTriCoords(node0ToSphereCenter,g.edgeVec[0],g.edgeVec[1],g.edgeVec[2],g.edgeLen,bary);
 
     int barySign = (bary[0] > -SMALL_TRIMESH) + 2*(bary[1] > -SMALL_TRIMESH) + 4*(bary[2] > -SMALL_TRIMESH);
 
@@ -65,25 +65,25 @@
     switch(barySign)
     {
     case 1: 
-      d = resolveCornerContactBary(nTri,0,obtuseAngleIndex == 0,cSphere,delta,bary);
+      d = resolveCornerContactBary(g,0,obtuseAngleIndex == 0,cSphere,delta,bary);
       break;
     case 2: 
-      d = resolveCornerContactBary(nTri,1,obtuseAngleIndex == 1,cSphere,delta,bary);
+      d = resolveCornerContactBary(g,1,obtuseAngleIndex == 1,cSphere,delta,bary);
       break;
     case 3: 
-      d = resolveEdgeContactBary(nTri,0,cSphere,delta,bary);
+      d = resolveEdgeContactBary(g,0,cSphere,delta,bary);
       break;
     case 4: 
-      d = resolveCornerContactBary(nTri,2,obtuseAngleIndex == 2,cSphere,delta,bary);
+      d = resolveCornerContactBary(g,2,obtuseAngleIndex == 2,cSphere,delta,bary);
       break;
     case 5: 
-      d = resolveEdgeContactBary(nTri,2,cSphere,delta,bary);
+      d = resolveEdgeContactBary(g,2,cSphere,delta,bary);
       break;
     case 6: 
-      d = resolveEdgeContactBary(nTri,1,cSphere,delta,bary);
+      d = resolveEdgeContactBary(g,1,cSphere,delta,bary);
       break;
     case 7: // face contact - all three barycentric coordinates are > 0
-      d = resolveFaceContactBary(nTri,cSphere,node0ToSphereCenter,delta);
+      d = resolveFaceContactBary(g,cSphere,node0ToSphereCenter,delta);
       break;
     default:
       this->error->one(FLERR,"Internal error");
@@ -96,43 +96,42 @@
 
   /* ---------------------------------------------------------------------- */
 
-  inline double TriMesh::resolveEdgeContactBary(int iTri, int iEdge, double *p, double *delta, double *bary)
+  inline double TriMesh::resolveEdgeContactBary(TriElemGeom &g, int iEdge, double *p, double *delta, double *bary)
   {
       int ip = (iEdge+1)%3, ipp = (iEdge+2)%3;
       double nodeToP[3], d(1.);
-      double **n = node_(iTri);
 
-      vectorSubtract3D(p,n[iEdge],nodeToP);
+      vectorSubtract3D(p,g.node[iEdge],nodeToP);
 
-      double distFromNode =  vectorDot3D(nodeToP,edgeVec(iTri)[iEdge]);
+      double distFromNode =  vectorDot3D(nodeToP,g.edgeVec[iEdge]);
 
       if(distFromNode < -SMALL_TRIMESH){
         
-        if(!cornerActive(iTri)[iEdge])
+        if(!g.cornerActive[iEdge])
             return LARGE_TRIMESH;
-        d = calcDist(p,n[iEdge],delta);
+        d = calcDist(p,g.node[iEdge],delta);
         bary[iEdge] = 1.; bary[ip] = 0.; bary[ipp] = 0.;
       }
-      else if(distFromNode > edgeLen(iTri)[iEdge] + SMALL_TRIMESH){
+      else if(distFromNode > g.edgeLen[iEdge] + SMALL_TRIMESH){
         
-        if(!cornerActive(iTri)[ip])
+        if(!g.cornerActive[ip])
             return LARGE_TRIMESH;
-        d = calcDist(p,n[ip],delta);
+        d = calcDist(p,g.node[ip],delta);
         bary[iEdge] = 0.; bary[ip] = 1.; bary[ipp] = 0.;
       }
       else{
         
         double closestPoint[3];
 
-        if(!edgeActive(iTri)[iEdge])
+        if(!g.edgeActive[iEdge])
             return LARGE_TRIMESH;
 
-        vectorAddMultiple3D(n[iEdge],distFromNode,edgeVec(iTri)[iEdge],closestPoint);
+        vectorAddMultiple3D(g.node[iEdge],distFromNode,g.edgeVec[iEdge],closestPoint);
 
         d = calcDist(p,closestPoint,delta);
 
         bary[ipp] = 0.;
-        bary[iEdge] = 1. - distFromNode/edgeLen(iTri)[iEdge];
+        bary[iEdge] = 1. - distFromNode/g.edgeLen[iEdge];
         bary[ip] = 1. - bary[iEdge];
       }
 
@@ -141,16 +140,15 @@
 
   /* ---------------------------------------------------------------------- */
 
-  inline double TriMesh::resolveCornerContactBary(int iTri, int iNode, bool obtuse,
+  inline double TriMesh::resolveCornerContactBary(TriElemGeom &g, int iNode, bool obtuse,
                                                     double *p, double *delta, double *bary)
   {
       int ip = (iNode+1)%3, ipp = (iNode+2)%3;
-      double d(1.);
-      double *n = node_(iTri)[iNode];
+      double *n = g.node[iNode];
 
       if(obtuse){
         
-        double **edge = edgeVec(iTri);
+        double (*edge)[3] = g.edgeVec;
         double nodeToP[3], closestPoint[3];
 
         vectorSubtract3D(p,n,nodeToP);
@@ -158,67 +156,67 @@
         double distFromNode = vectorDot3D(nodeToP,edge[ipp]);
         if(distFromNode < SMALL_TRIMESH)
           {
-            if(distFromNode > -edgeLen(iTri)[ipp]){
+            if(distFromNode > -g.edgeLen[ipp]){
               
-              if(!edgeActive(iTri)[ipp])
+              if(!g.edgeActive[ipp])
                 return LARGE_TRIMESH;
               
               vectorAddMultiple3D(n,distFromNode,edge[ipp],closestPoint);
               
               bary[ip] = 0.;
-              bary[iNode] = 1. + distFromNode/edgeLen(iTri)[ipp];
+              bary[iNode] = 1. + distFromNode/g.edgeLen[ipp];
               bary[ipp] = 1. - bary[iNode];
         
               return calcDist(p,closestPoint,delta);
             } else{
               
-              if(!cornerActive(iTri)[ipp])
+              if(!g.cornerActive[ipp])
                 return LARGE_TRIMESH;
 
               bary[ipp] = 1.; bary[iNode] = bary[ip] = 0.;
-              return calcDist(p,node_(iTri)[ipp],delta);
+              return calcDist(p,g.node[ipp],delta);
             }
           }
 
         distFromNode = vectorDot3D(nodeToP,edge[iNode]);
         if(distFromNode > -SMALL_TRIMESH)
           {
-            if(distFromNode < edgeLen(iTri)[iNode]){
+            if(distFromNode < g.edgeLen[iNode]){
               
-              if(!edgeActive(iTri)[iNode])
+              if(!g.edgeActive[iNode])
                 return LARGE_TRIMESH;
               
               vectorAddMultiple3D(n,distFromNode,edge[ipp],closestPoint);
               
               bary[ipp] = 0.;
-              bary[iNode] = 1. - distFromNode/edgeLen(iTri)[iNode];
+              bary[iNode] = 1. - distFromNode/g.edgeLen[iNode];
               bary[ip] = 1. - bary[iNode];
               
               return calcDist(p,closestPoint,delta);
             } else{
               
-              if(!cornerActive(iTri)[ip])
+              if(!g.cornerActive[ip])
                 return LARGE_TRIMESH;
               
               bary[ip] = 1.; bary[iNode] = bary[ipp] = 0.;
-              return calcDist(p,node_(iTri)[ip],delta);
+              return calcDist(p,g.node[ip],delta);
               
             }
           }
       }
 
-      if(!cornerActive(iTri)[iNode])
+      if(!g.cornerActive[iNode])
           return LARGE_TRIMESH;
 
       bary[iNode] = 1.; bary[ip] = bary[ipp] = 0.;
-      return calcDist(p,node_(iTri)[iNode],delta);
+      return calcDist(p,n,delta);
   }
 
   /* ---------------------------------------------------------------------- */
 
-  inline double TriMesh::resolveFaceContactBary(int iTri, double *p, double *node0ToSphereCenter, double *delta)
+  inline double TriMesh::resolveFaceContactBary(TriElemGeom &g, double *p, double *node0ToSphereCenter, double *delta)
   {
-      double *surfNorm = SurfaceMeshBase::surfaceNorm(iTri);
+      double *surfNorm = g.surfaceNorm;
 
       double dNorm = vectorDot3D(surfNorm,node0ToSphereCenter);
 
@@ -234,21 +232,19 @@
   inline bool TriMesh::resolveTriSphereNeighbuild(int nTri, double rSphere,
       double *cSphere, double treshold)
   {
-    
+    TriElemGeom tmp;
+    TriElemGeom &g = elemGeom(nTri,tmp);
+
     double maxDist = rSphere + treshold;
 
-    double dNorm = fabs( calcDistToPlane(cSphere,
-        SurfaceMeshBase::center_(nTri),SurfaceMeshBase::surfaceNorm(nTri)) );
+    double dNorm = fabs( calcDistToPlane(cSphere,g.center,g.surfaceNorm) );
     if(dNorm > maxDist) return false;
 
-    double **node = MultiNodeMesh<3>::node_(nTri),
-        **edgeNorm = SurfaceMeshBase::edgeNorm(nTri);
-
     // d_para^2 + d_norm^2 > maxDist^2 --> return false
     double dParaMax = maxDist*maxDist;// - dNorm*dNorm;
 
     for(int i=0;i<3;i++){
-      double d = calcDistToPlane(cSphere,node[i],edgeNorm[i]);
+      double d = calcDistToPlane(cSphere,g.node[i],g.edgeNorm[i]);
       if(d>0 && d*d > dParaMax)
         return false;
     }
@@ -261,6 +257,77 @@
     return true;
   }
 
+  /* ----------------------------------------------------------------------
+   batched version of resolveTriSphereNeighbuild()
+   geometry of the triangle is read once, loop over the spheres
+   is branch-free so that it can be vectorized
+  ------------------------------------------------------------------------- */
+
+  inline void TriMesh::resolveTriSphereNeighbuildBatch(int nTri, int n, const double *px,
+      const double *py, const double *pz, const double *pr, double treshold, int *inRange)
+  {
+    TriElemGeom tmp;
+    const TriElemGeom &g = elemGeom(nTri,tmp);
+    const double *c = g.center, *sn = g.surfaceNorm;
+
+#if defined(_OPENMP) && _OPENMP >= 201307
+    #pragma omp simd
+#endif
+    for(int j = 0; j < n; j++)
+    {
+      double maxDist = pr[j] + treshold;
+      double dParaMax = maxDist*maxDist;
+
+      double dNorm = fabs(sn[0]*(px[j]-c[0]) + sn[1]*(py[j]-c[1]) + sn[2]*(pz[j]-c[2]));
+      int in = (dNorm <= maxDist);
+
+      for(int i = 0; i < 3; i++)
+      {
+        const double *nd = g.node[i], *en = g.edgeNorm[i];
+        double d = en[0]*(px[j]-nd[0]) + en[1]*(py[j]-nd[1]) + en[2]*(pz[j]-nd[2]);
+        in &= !(d > 0. && d*d > dParaMax);
+      }
+      inRange[j] = in;
+    }
+  }
+
+  /* ----------------------------------------------------------------------
+   batched pre-test for resolveTriSphereContact()
+   the distance to the triangle is bounded from below by the distance
+   to its plane and the max outward distance to its edge planes
+   (i.e. the signs of the barycentric coordinates), so spheres further
+   away than their radius can not be in contact
+   margin covers the tolerance of the exact contact algorithm
+  ------------------------------------------------------------------------- */
+
+  inline void TriMesh::resolveTriSphereContactBatch(int nTri, int n, const double *px,
+      const double *py, const double *pz, const double *pr, int *candidate)
+  {
+    TriElemGeom tmp;
+    const TriElemGeom &g = elemGeom(nTri,tmp);
+    const double *sn = g.surfaceNorm, *nd0 = g.node[0];
+    const double margin = 10.*SMALL_TRIMESH;
+
+#if defined(_OPENMP) && _OPENMP >= 201307
+    #pragma omp simd
+#endif
+    for(int j = 0; j < n; j++)
+    {
+      double dNorm = sn[0]*(px[j]-nd0[0]) + sn[1]*(py[j]-nd0[1]) + sn[2]*(pz[j]-nd0[2]);
+
+      double dOut = 0.;
+      for(int i = 0; i < 3; i++)
+      {
+        const double *nd = g.node[i], *en = g.edgeNorm[i];
+        double d = en[0]*(px[j]-nd[0]) + en[1]*(py[j]-nd[1]) + en[2]*(pz[j]-nd[2]);
+        dOut = d > dOut ? d : dOut;
+      }
+
+      double rMax = pr[j] + margin;
+      candidate[j] = (dNorm*dNorm + dOut*dOut <= rMax*rMax);
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
 
   inline double TriMesh::calcDist(double *cs, double *closestPoint, double *delta)
@@ -23,6 +23,7 @@
 
 #include "lmptype.h"
 #include "mpi.h"
+#include "stdlib.h"
 #include "string.h"
 #include "write_restart.h"
 #include "atom.h"
@@ -63,7 +64,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
        BOXLO_0,BOXHI_0,BOXLO_1,BOXHI_1,BOXLO_2,BOXHI_2,
        SPECIAL_LJ_1,SPECIAL_LJ_2,SPECIAL_LJ_3,
        SPECIAL_COUL_1,SPECIAL_COUL_2,SPECIAL_COUL_3,
-       XY,XZ,YZ};
+       XY,XZ,YZ,MULTIPROC};
 enum{MASS};
 enum{PAIR,BOND,ANGLE,DIHEDRAL,IMPROPER};
 
@@ -77,6 +78,9 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Pointers(lmp)
   MPI_Comm_size(world,&nprocs);
 
   region = NULL; 
+
+  fileper = nfile_user = 0;
+  nfile = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -87,7 +91,7 @@ void WriteRestart::command(int narg, char **arg)
 {
   if (domain->box_exist == 0)
     error->all(FLERR,"Write_restart command before simulation box is defined");
-  if (narg != 1 && narg != 3) error->all(FLERR,"Illegal write_restart command");  
+  if (narg < 1) error->all(FLERR,"Illegal write_restart command");
 
   // if filename contains a "*", replace with current timestep
 
@@ -100,16 +104,23 @@ void WriteRestart::command(int narg, char **arg)
     sprintf(file,"%s" BIGINT_FORMAT "%s",arg[0],update->ntimestep,ptr+1);
   } else strcpy(file,arg[0]);
 
-  int iregion;
-  if(narg == 4 && strcmp(arg[2],"region"))
-    error->all(FLERR,"Write_restart expects keyword 'region'");
-  if(narg == 4)
-  {
-      iregion = domain->find_region(arg[3]);
+  // optional args
+
+  region = NULL;
+  int iarg = 1;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"region") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      int iregion = domain->find_region(arg[iarg+1]);
       if (iregion == -1) error->all(FLERR,"Write_restart region ID does not exist");
-      else region = domain->regions[iregion];
+      region = domain->regions[iregion];
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"fileper") == 0 || strcmp(arg[iarg],"nfile") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      multiproc_options(2,&arg[iarg]);
+      iarg += 2;
+    } else error->all(FLERR,"Illegal write_restart command");
   }
-  else region = NULL;
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -141,6 +152,62 @@ void WriteRestart::command(int narg, char **arg)
   delete [] file;
 }
 
+/* ----------------------------------------------------------------------
+   parse fileper/nfile keywords which set how many procs share one file
+   called from command() and from output for the restart command
+------------------------------------------------------------------------- */
+
+void WriteRestart::multiproc_options(int narg, char **arg)
+{
+  fileper = nfile_user = 0;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg],"fileper") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      fileper = atoi(arg[iarg+1]);
+      nfile_user = 0;
+      if (fileper <= 0) error->all(FLERR,"Illegal write_restart command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"nfile") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal write_restart command");
+      nfile_user = atoi(arg[iarg+1]);
+      fileper = 0;
+      if (nfile_user <= 0) error->all(FLERR,"Illegal write_restart command");
+      iarg += 2;
+    } else error->all(FLERR,"Illegal write_restart command");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   assign procs to clusters, one file per cluster
+   clusters are contiguous ranges of proc IDs, the first proc of a
+     cluster writes the file
+   default is one file per proc
+------------------------------------------------------------------------- */
+
+void WriteRestart::setup_clusters()
+{
+  if (fileper) {
+    nfile = nprocs/fileper;
+    if (nprocs % fileper) nfile++;
+    icluster = me/fileper;
+    fileproc = icluster*fileper;
+    nclusterprocs = MIN(fileper,nprocs-fileproc);
+  } else {
+    if (nfile_user) nfile = MIN(nfile_user,nprocs);
+    else nfile = nprocs;
+    icluster = static_cast<int> ((bigint) me * nfile/nprocs);
+    fileproc = static_cast<int> ((bigint) icluster * nprocs/nfile);
+    while ((bigint) fileproc*nfile/nprocs < icluster) fileproc++;
+    int fileprocnext = static_cast<int> ((bigint) (icluster+1) * nprocs/nfile);
+    while ((bigint) fileprocnext*nfile/nprocs < icluster+1) fileprocnext++;
+    nclusterprocs = fileprocnext - fileproc;
+  }
+
+  filewriter = (me == fileproc) ? 1 : 0;
+}
+
 /* ----------------------------------------------------------------------
    called from command() and directly from output within run/minimize loop
    file = final file name to write, except may contain a "%"
@@ -180,6 +247,11 @@ void WriteRestart::write(char *file)
   if (strchr(file,'%')) multiproc = 1;
   else multiproc = 0;
 
+  nfile = 0;
+  if (multiproc) setup_clusters();
+  else if (fileper || nfile_user)
+    error->all(FLERR,"Restart file name must contain % to use fileper or nfile");
+
   // open single restart file or base file for multiproc case
 
   if (me == 0) {
@@ -220,7 +292,8 @@ void WriteRestart::write(char *file)
   MPI_Allreduce(&send_size,&max_size,1,MPI_INT,MPI_MAX,world);
 
   double *buf;
-  if (me == 0) memory->create(buf,max_size,"write_restart:buf");
+  if (me == 0 || (multiproc && filewriter))
+    memory->create(buf,max_size,"write_restart:buf");
   else memory->create(buf,send_size,"write_restart:buf");
 
   // pack my atom data into buf
@@ -295,14 +368,17 @@ void WriteRestart::write(char *file)
   //   write one chunk of atoms per proc to file
   //   proc 0 pings each proc, receives its chunk, writes to file
   //   all other procs wait for ping, send their chunk to proc 0
-  // else if one file per proc:
-  //   each proc opens its own file and writes its chunk directly
+  // else if one file per cluster of procs:
+  //   file starts with the # of chunks it holds
+  //   the file writer of each cluster pings each proc of the cluster,
+  //   receives its chunk and writes it to its own file
+  //   no atom data is sent to proc 0
 
-  if (multiproc == 0) {
-    int tmp,recv_size;
-    MPI_Status status;
-    MPI_Request request;
+  int tmp,recv_size;
+  MPI_Status status;
+  MPI_Request request;
 
+  if (multiproc == 0) {
     if (me == 0) {
       for (int iproc = 0; iproc < nprocs; iproc++) {
         if (iproc) {
@@ -325,21 +401,38 @@ void WriteRestart::write(char *file)
   } else {
     if (me == 0) fclose(fp);
 
-    char *perproc = new char[strlen(file) + 16];
-    char *ptr = strchr(file,'%');
-    *ptr = '\0';
-    sprintf(perproc,"%s%d%s",file,me,ptr+1);
-    *ptr = '%';
-    fp = fopen(perproc,"wb");
-    if (fp == NULL) {
-      char str[128];
-      sprintf(str,"Cannot open restart file %s",perproc);
-      error->one(FLERR,str);
+    if (filewriter) {
+      char *perproc = new char[strlen(file) + 16];
+      char *ptr = strchr(file,'%');
+      *ptr = '\0';
+      sprintf(perproc,"%s%d%s",file,icluster,ptr+1);
+      *ptr = '%';
+      fp = fopen(perproc,"wb");
+      if (fp == NULL) {
+        char str[128];
+        sprintf(str,"Cannot open restart file %s",perproc);
+        error->one(FLERR,str);
+      }
+      delete [] perproc;
+
+      fwrite(&nclusterprocs,sizeof(int),1,fp);
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        if (iproc) {
+          MPI_Irecv(buf,max_size,MPI_DOUBLE,fileproc+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,fileproc+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_DOUBLE,&recv_size);
+        } else recv_size = send_size;
+
+        fwrite(&recv_size,sizeof(int),1,fp);
+        fwrite(buf,sizeof(double),recv_size,fp);
+      }
+      fclose(fp);
+
+    } else {
+      MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,&status);
+      MPI_Rsend(buf,send_size,MPI_DOUBLE,fileproc,0,world);
     }
-    delete [] perproc;
-    fwrite(&send_size,sizeof(int),1,fp);
-    fwrite(buf,sizeof(double),send_size,fp);
-    fclose(fp);
   }
 
   memory->destroy(buf);
@@ -427,6 +520,10 @@ void WriteRestart::header()
     write_double(YZ,domain->yz);
   }
 
+  // # of per-proc files, each file holds the chunks of a cluster of procs
+
+  if (nfile) write_int(MULTIPROC,nfile);
+
   // -1 flag signals end of header
 
   int flag = -1;
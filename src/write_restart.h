@@ -40,14 +40,24 @@ class WriteRestart : protected Pointers {
   WriteRestart(class LAMMPS *);
   void command(int, char **);
   void write(char *);
+  void multiproc_options(int, char **);
 
  private:
   int me,nprocs;
   FILE *fp;
   bigint natoms;         // natoms (sum of nlocal) to write into file
 
+  int fileper;           // # of procs per file if set via fileper keyword
+  int nfile_user;        // # of files if set via nfile keyword
+  int nfile;             // # of per-proc files written in multiproc mode
+  int icluster;          // which file (cluster of procs) I write into
+  int fileproc;          // ID of proc in my cluster who writes the file
+  int nclusterprocs;     // # of procs in my cluster
+  int filewriter;        // 1 if I write a file, else 0
+
   class Region *region;
 
+  void setup_clusters();
   void header();
   void type_arrays();
   void force_fields();
@@ -85,4 +95,13 @@ E: Cannot open restart file %s
 
 Self-explanatory.
 
+E: Write_restart region ID does not exist
+
+Self-explanatory.
+
+E: Restart file name must contain % to use fileper or nfile
+
+The fileper and nfile keywords set how many per-processor files are
+written, which is only possible for a multi-file restart.
+
 */
@@ -60,7 +60,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      BOXLO_0,BOXHI_0,BOXLO_1,BOXHI_1,BOXLO_2,BOXHI_2,
      SPECIAL_LJ_1,SPECIAL_LJ_2,SPECIAL_LJ_3,
      SPECIAL_COUL_1,SPECIAL_COUL_2,SPECIAL_COUL_3,
-     XY,XZ,YZ};
+     XY,XZ,YZ,MULTIPROC};
 enum{MASS};
 enum{PAIR,BOND,ANGLE,DIHEDRAL,IMPROPER};
 
@@ -82,6 +82,7 @@ class Data {
   int size_smallint,size_tagint,size_bigint;
   bigint ntimestep;
   int nprocs;
+  int nfiles;
   char *unit_style;
   int dimension;
   int px,py,pz;
@@ -459,29 +460,40 @@ int main (int narg, char **arg)
   data.iatoms = data.ibonds = data.iangles =
     data.idihedrals = data.iimpropers = 0;
 
-  for (int iproc = 0; iproc < data.nprocs; iproc++) {
+  // files written per cluster of procs start with their # of chunks
+
+  int nfiles = data.nprocs;
+  if (data.nfiles) nfiles = data.nfiles;
+
+  for (int ifile = 0; ifile < nfiles; ifile++) {
+    int nchunk = 1;
     if (multiproc) {
       fclose(fp);
-      char *procfile;
-      sprintf(procfile,"%s%d%s",restartfile,iproc,ptr+1);
+      char *procfile = new char[strlen(restartfile) + strlen(ptr+1) + 16];
+      sprintf(procfile,"%s%d%s",restartfile,ifile,ptr+1);
       fp = fopen(procfile,"rb");
       if (fp == NULL) {
         printf("ERROR: Cannot open restart file %s\n",procfile);
         return 1;
       }
+      delete [] procfile;
+      if (data.nfiles) nchunk = read_int(fp);
     }
-    n = read_int(fp);
 
-    if (n > maxbuf) {
-      maxbuf = n;
-      delete [] buf;
-      buf = new double[maxbuf];
-    }
+    for (int ichunk = 0; ichunk < nchunk; ichunk++) {
+      n = read_int(fp);
 
-    nread_double(buf,n,fp);
+      if (n > maxbuf) {
+        maxbuf = n;
+        delete [] buf;
+        buf = new double[maxbuf];
+      }
 
-    m = 0;
-    while (m < n) m += atom(&buf[m],data);
+      nread_double(buf,n,fp);
+
+      m = 0;
+      while (m < n) m += atom(&buf[m],data);
+    }
   }
 
   fclose(fp);
@@ -535,6 +547,7 @@ void header(FILE *fp, Data &data)
   const char *version = "17 May 2012";
 
   data.triclinic = 0;
+  data.nfiles = 0;
 
   int flag;
   flag = read_int(fp);
@@ -557,6 +570,7 @@ void header(FILE *fp, Data &data)
     else if (flag == NTIMESTEP) data.ntimestep = read_bigint(fp);
     else if (flag == DIMENSION) data.dimension = read_int(fp);
     else if (flag == NPROCS) data.nprocs = read_int(fp);
+    else if (flag == MULTIPROC) data.nfiles = read_int(fp);
     else if (flag == PROCGRID_0) data.px = read_int(fp);
     else if (flag == PROCGRID_1) data.py = read_int(fp);
     else if (flag == PROCGRID_2) data.pz = read_int(fp);